@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ECS/Actor.h"
+#include "GhostLap.h"
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <optional>
+
+/**
+ * @class A_Ghost
+ * @brief Fantasma de una vuelta grabada: sólo reproduce posición y rumbo de un GhostLap.
+ *
+ * No está en la parrilla de RaceSimulation, así que no choca, no cuenta vueltas ni
+ * entra en la clasificación. Cada frame cuesta una interpolación entre dos muestras.
+ */
+class A_Ghost : public Actor {
+public:
+  /**
+   * @brief Construye un fantasma sin vuelta asignada (oculto).
+   */
+  explicit A_Ghost(const std::string& name = "Ghost");
+
+  /**
+   * @brief Vuelta a reproducir (nula = oculto).
+   */
+  void setLap(const EngineUtilities::TSharedPointer<GhostLap>& lap) { m_lap = lap; m_visible = false; }
+
+  /** @brief Vuelta asignada. */
+  const EngineUtilities::TSharedPointer<GhostLap>& getLap() const { return m_lap; }
+
+  /**
+   * @brief Textura del personaje grabado; se dibuja translúcida con su propio sprite.
+   */
+  void setGhostTexture(const EngineUtilities::TSharedPointer<Texture>& texture);
+
+  /**
+   * @brief Coloca el fantasma en el instante @p time de su vuelta (fuera de la vuelta se oculta).
+   */
+  void setLapTime(float time);
+
+  /** @brief Oculta el fantasma hasta el siguiente setLapTime(). */
+  void hide() { m_visible = false; }
+
+  /** @brief true si se dibuja este frame. */
+  bool isVisible() const { return m_visible; }
+
+  /**
+   * @brief Dibuja el sprite translúcido (o la shape si no hay textura).
+   */
+  void render(const EngineUtilities::TSharedPointer<Window>& window) override;
+
+  /**
+   * @brief Encola el sprite translúcido (oculto = nada que dibujar; sin textura, la shape).
+   */
+  bool submit(SpriteBatch& batch, int layer) override;
+
+private:
+  /** @brief Lleva el sprite al Transform; false si no hay sprite. */
+  bool placeSprite();
+
+  EngineUtilities::TSharedPointer<GhostLap> m_lap;
+  EngineUtilities::TSharedPointer<Texture>  m_texture;   ///< Mantiene viva la textura del sprite.
+  std::optional<sf::Sprite>                 m_sprite;
+  sf::Color                                 m_tint{ 255, 255, 255, 110 };
+  bool                                      m_visible = false;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "ECS/Actor.h"
+#include "ECS/KartPhysics.h"
+#include "RacingLine.h"
+#include "RacingSpline.h"
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <vector>
@@ -27,7 +30,7 @@ public:
 
   /**
    * @brief Actualiza el corredor: steering hacia el siguiente waypoint,
-   *        avance de vueltas y orientacin del sprite.
+   *        progreso sobre la pista y orientacin del sprite.
    * @param deltaTime Tiempo transcurrido desde el frame anterior.
    */
   void update(float deltaTime) override;
@@ -38,16 +41,142 @@ public:
    */
   void setPath(const std::vector<sf::Vector2f>& pathPoints);
 
+  /**
+   * @brief Asigna una lnea de carrera precomputada (compartida entre corredores).
+   *        Si est definida, tiene prioridad sobre los waypoints de setPath().
+   * @param spline LUT de la lnea de carrera (nulo para volver a los waypoints).
+   * @param laneOffset Desplazamiento lateral en pxeles (carril) respecto a la lnea.
+   * @param startDistance Distancia de arco de salida (negativa = detrs de la meta).
+   */
+  void setSpline(const EngineUtilities::TSharedPointer<RacingSpline>& spline, float laneOffset = 0.f,
+                 float startDistance = 0.f);
+
+  /**
+   * @brief Trazada y perfil de velocidad precalculados (compartidos; nulo = ir por el carril).
+   *        Con trazada, el carril de salida se funde con ella en los primeros metros.
+   */
+  void setRacingLine(const EngineUtilities::TSharedPointer<RacingLine>& line) { m_racingLine = line; }
+
+  /**
+   * @brief Distancia de arco actual sobre la lnea de carrera (px).
+   */
+  float getTrackDistance() const { return m_splineDistance; }
+
+  /**
+   * @brief Carril asignado (offset lateral fijo respecto a la lnea, px).
+   */
+  float getLaneOffset() const { return m_laneOffset; }
+
+  /**
+   * @brief rdenes de evitacin calculadas por la simulacin para este tick.
+   * @param lateralOffset Desplazamiento lateral deseado sobre el carril (px); se alcanza gradualmente.
+   * @param speedScale Factor de velocidad (0..1) para no empotrarse contra el de delante.
+   */
+  void  setAvoidance(float lateralOffset, float speedScale) { m_avoidTarget = lateralOffset; m_speedScale = speedScale; }
+
+  /**
+   * @brief Offset de evitacin aplicado ahora mismo (px).
+   */
+  float getAvoidanceOffset() const { return m_avoidOffset; }
+
+  /**
+   * @brief Efecto de la superficie bajo el kart para este tick.
+   * @param speedScale Factor de velocidad (1 = asfalto).
+   * @param recovering true si est fuera de pista: vuelve a su carril con mirada corta.
+   */
+  void  setTerrain(float speedScale, bool recovering) { m_terrainScale = speedScale; m_recovering = recovering; }
+
+  /**
+   * @brief Suma un cambio de velocidad instantneo (choque); decae con el tiempo.
+   * @param deltaVelocity Impulso / masa en px/s.
+   */
+  void  addImpulse(const sf::Vector2f& deltaVelocity) { m_bumpVelocity += deltaVelocity; }
+
+  /**
+   * @brief Velocidad residual de los choques (px/s).
+   */
+  const sf::Vector2f& getBumpVelocity() const { return m_bumpVelocity; }
+
+  /**
+   * @brief Impacto de un objeto: pierde casi toda la velocidad y no acelera durante @p seconds.
+   */
+  void  spinOut(float seconds);
+
+  /**
+   * @brief Turbo de un objeto durante @p seconds (con fsica, el turbo de KartPhysics).
+   */
+  void  startBoost(float seconds);
+
+  /** @brief Tiempo que le queda girando tras un impacto (s). */
+  float getSpinTime() const { return m_spinTime; }
+
+  /** @brief Turbo de objeto restante (s). */
+  float getItemBoostTime() const { return m_boostTime; }
+
   /**
    * @brief Reinicia el estado del corredor al inicio del path (sin vueltas ni podio).
    */
   void reset();
 
   /**
-   * @brief Define el rectngulo de meta utilizado para contar vueltas.
-   * @param rect Rectngulo en coordenadas de mundo.
+   * @brief Lo que cambia durante la carrera (transform, progreso, vueltas, evitacin y
+   *        fsica). La ruta, la lnea y los parmetros de steering no se copian.
+   */
+  struct State {
+    sf::Vector2f position{ 0.f, 0.f };
+    sf::Vector2f previousPosition{ 0.f, 0.f };
+    float        rotation = 0.f;
+    float        previousRotation = 0.f;
+    int          waypoint = 0;
+    float        splineDistance = 0.f;
+    float        avoidTarget = 0.f;
+    float        avoidOffset = 0.f;
+    float        speedScale = 1.f;
+    sf::Vector2f bumpVelocity{ 0.f, 0.f };
+    float        terrainScale = 1.f;
+    int          lap = 0;
+    int          sector = 0;
+    int          sectorCount = 1;
+    int          place = 0;
+    int          standing = 0;
+    bool         raceStarted = true;
+    bool         recovering = false;
+    bool         manualControl = false;
+    float        spinTime = 0.f;
+    float        boostTime = 0.f;
+    KartPhysics::State physics;
+  };
+
+  /**
+   * @brief Copia del estado dinmico (rollback).
+   */
+  State getState() const;
+
+  /**
+   * @brief Restaura un estado de getState() sin tocar ruta ni parmetros.
+   */
+  void setState(const State& state);
+
+  /**
+   * @brief Estado de vuelta calculado por LapTimer (puertas de sector).
+   * @param lap Vueltas completadas.
+   * @param sector Sector en curso (0..sectorCount-1).
+   * @param sectorCount Sectores por vuelta.
+   * @param started false mientras no se haya cruzado la salida desde detrs de la meta.
+   */
+  void setLapState(int lap, int sector, int sectorCount, bool started) {
+    m_currentLap = lap; m_sector = sector; m_sectorCount = sectorCount; m_raceStarted = started;
+  }
+
+  /**
+   * @brief Sector en curso (0 = el que empieza en la meta).
    */
-  void setFinishLine(const sf::FloatRect& rect) { m_finishLine = rect; }
+  int  getSector() const { return m_sector; }
+
+  /**
+   * @brief Distancia de arco de salida asignada en setSpline() (negativa = detrs de la meta).
+   */
+  float getStartDistance() const { return m_startDistance; }
 
   /**
    * @brief Fija el nmero total de vueltas.
@@ -81,6 +210,28 @@ public:
    */
   float getMaxSpeed() const { return m_maxSpeed; }
 
+  /**
+   * @brief Ajusta la distancia de mirada hacia delante del steering (px).
+   * @param d Distancia; valores mayores suavizan las curvas pero recortan ms.
+   */
+  void  setLookaheadDistance(float d) { lookaheadDistance = d; }
+
+  /**
+   * @brief Devuelve la distancia de mirada hacia delante (px).
+   */
+  float getLookaheadDistance() const { return lookaheadDistance; }
+
+  /**
+   * @brief Ajusta el radio de llegada a waypoint / frenado del seek (px).
+   * @param r Radio.
+   */
+  void  setArriveRadius(float r) { arriveRadius = r; }
+
+  /**
+   * @brief Devuelve el radio de llegada (px).
+   */
+  float getArriveRadius() const { return arriveRadius; }
+
   /**
    * @brief Posicin de podio alcanzada (0 = an corriendo, 1..N = finalizado).
    */
@@ -97,6 +248,22 @@ public:
    */
   float getProgress() const;
 
+  /**
+   * @brief Progreso total en vueltas (vuelta + fraccin), continuo al cruzar la meta;
+   *        negativo mientras se sale desde detrs de la lnea. Clave de la clasificacin.
+   */
+  float getRaceProgress() const;
+
+  /**
+   * @brief Posicin en carrera en este momento (la fija RaceRanking cada tick).
+   */
+  void  setStanding(int s) { m_standing = s; }
+
+  /**
+   * @brief Posicin en carrera en este momento (1..N; 0 = sin clasificar).
+   */
+  int   getStanding() const { return m_standing; }
+
   /**
    * @brief Define un offset angular (en grados) que se suma a la orientacin
    *        calculada por el steering para alinear el sprite.
@@ -110,7 +277,41 @@ public:
    */
   float getSpriteAngleOffset() const { return m_spriteAngleOffset; }
 
+  /**
+   * @brief Activa el control manual: el Transform lo mueve el jugador y update()
+   *        slo sigue el progreso sobre la pista.
+   * @param manual true para desactivar el steering automtico.
+   */
+  void  setManualControl(bool manual) { m_manualControl = manual; }
+
+  /**
+   * @brief Indica si el corredor est bajo control manual.
+   */
+  bool  isManualControl() const { return m_manualControl; }
+
+  /**
+   * @brief IA con fsica de kart: en vez de desplazarse con seek() pide gas y volante
+   *        a su KartPhysics (inercia, agarre, lmites del terreno).
+   */
+  void  setPhysicsDriven(bool driven) { m_physicsDriven = driven; }
+
+  /**
+   * @brief true si la posicin la integra KartPhysics (jugador o IA con fsica).
+   */
+  bool  isPhysicsDriven() const { return m_physicsDriven || m_manualControl; }
+
+  /**
+   * @brief Fsica del kart (componente propio; tambin lo usa el jugador).
+   */
+  const EngineUtilities::TSharedPointer<KartPhysics>& getPhysics() const { return m_physics; }
+
 private:
+  /**
+   * @brief Actualiza la distancia recorrida sobre la lnea/waypoints sin mover el corredor.
+   * @param deltaTime Tiempo del tick (acota la ventana de bsqueda).
+   */
+  void trackProgress(float deltaTime);
+
   /**
    * @brief Lgica de seguimiento del path (Pure Pursuit + arrive).
    * @param deltaTime Tiempo transcurrido desde el frame anterior.
@@ -121,20 +322,50 @@ private:
   std::vector<sf::Vector2f> path;   ///< Waypoints del recorrido, en orden.
   int   currentWaypointIndex = 0;   ///< ndice del waypoint objetivo actual.
 
+  // --- Lnea de carrera (spline + LUT) ---
+  EngineUtilities::TSharedPointer<RacingSpline> m_spline; ///< Compartida; nula = usar waypoints.
+  float m_splineDistance = 0.f;     ///< Distancia de arco actual sobre la spline.
+  float m_laneOffset = 0.f;         ///< Offset lateral (px) respecto a la lnea.
+  float m_startDistance = 0.f;      ///< Distancia de arco de la posicin de salida.
+  EngineUtilities::TSharedPointer<RacingLine> m_racingLine; ///< Trazada optimizada; nula = carril.
+  float m_laneBlend = 400.f;        ///< Con trazada: recorrido en el que el carril pasa a 0 (px).
+
+  // --- Evitacin / choques ---
+  float m_avoidTarget = 0.f;        ///< Offset de evitacin pedido por la simulacin (px).
+  float m_avoidOffset = 0.f;        ///< Offset de evitacin actual (tiende a m_avoidTarget).
+  float m_avoidRate = 120.f;        ///< Velocidad lateral mxima del cambio de trazada (px/s).
+  float m_speedScale = 1.f;         ///< Factor de velocidad impuesto por el trfico.
+  sf::Vector2f m_bumpVelocity{ 0.f, 0.f }; ///< Velocidad de rebote de los choques (px/s).
+  float m_bumpDamping = 6.f;        ///< Amortiguacin exponencial del rebote (1/s).
+  float m_terrainScale = 1.f;       ///< Factor de velocidad por la superficie.
+  bool  m_recovering = false;       ///< Fuera de pista: prioriza volver al asfalto.
+
+  // --- Objetos ---
+  float m_spinTime = 0.f;           ///< Impacto: segundos sin poder acelerar.
+  float m_boostTime = 0.f;          ///< Turbo de objeto restante (s).
+  float m_boostSpeedScale = 1.3f;   ///< Velocidad con turbo (sin fsica).
+
   // --- Parmetros de steering ---
   float lookaheadDistance = 60.f;   ///< Distancia de mirada hacia delante (suaviza curvas).
   float arriveRadius = 30.f;   ///< Umbral para cambiar al siguiente waypoint.
   float m_maxSpeed = 160.f;  ///< Velocidad mxima (px/s).
 
-  // --- Meta / vueltas ---
-  sf::FloatRect m_finishLine{};     ///< Rectngulo usado para detectar paso por meta.
+  // --- Vueltas (las actualiza LapTimer) ---
   int  m_currentLap = 0;            ///< Vuelta actual.
   int  m_totalLaps = 3;            ///< Vueltas a completar.
-  bool m_crossedLastFrame = false;  ///< Evita contar varias veces la misma pasada por meta.
+  int  m_sector = 0;                ///< Sector en curso.
+  int  m_sectorCount = 1;           ///< Sectores por vuelta.
+  bool m_raceStarted = true;        ///< false = sale detrs de la meta y an no la ha cruzado.
 
   // --- Estado de carrera ---
   int  m_place = 0;                 ///< 0 = corriendo; 1..N = posicin final.
+  int  m_standing = 0;              ///< Posicin en vivo (RaceRanking).
   int  m_playerIndex = 0;           ///< Identificador opcional para GUI/depuracin.
+  bool m_manualControl = false;     ///< true = lo conduce el jugador (sin steering).
+
+  // --- Fsica ---
+  EngineUtilities::TSharedPointer<KartPhysics> m_physics; ///< Tambin registrado como componente.
+  bool m_physicsDriven = false;     ///< IA con KartPhysics en vez de seek().
 
   // --- Orientacin del sprite ---
   float m_spriteAngleOffset = -90.f; ///< Offset en grados sumado a la rotacin calculada.
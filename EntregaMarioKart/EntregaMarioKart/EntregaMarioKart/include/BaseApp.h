@@ -12,8 +12,21 @@
 #include "ResourceManager.h"
 #include "ECS/Texture.h"
 #include "A_Racer.h"
+#include "A_Ghost.h"
+#include "RaceSimulation.h"
+#include "FixedTimestep.h"
+#include "RaceReplay.h"
+#include "ParticleSystem.h"
+#include "ECS/ParticleEmitter.h"
+#include "ECS/DirectionalSprite.h"
+#include "SpriteBatch.h"
+#include "Camera.h"
+#include "Mode7Renderer.h"
+#include "TrackStreamer.h"
+#include "Minimap.h"
 
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <vector>
 
  /**
@@ -36,21 +49,97 @@ public:
   bool init();
 
   /**
-   * @brief Libera recursos.
+   * @brief Libera recursos (guarda la grabacin de la carrera en curso).
    */
   void destroy();
 
-private:
   /**
-   * @brief Aplica un path a los corredores (densifica + carriles + posiciona).
+   * @brief En lugar de jugar, reproduce una grabacin (llamar antes de run()).
+   * @param path Fichero grabado con RaceReplay.
+   * @return false si no se pudo leer.
    */
-  void applyCurrentPathToRacers(const std::vector<sf::Vector2f>& pts);
+  bool watchReplay(const std::string& path);
 
+private:
   /**
-   * @brief Control del jugador (arcade) cuando hay corredor seleccionado.
+   * @brief Muestrea el teclado y lo pasa como entrada del jugador a la simulacin.
    */
   void updatePlayerControl(float dt);
 
+  /**
+   * @brief Vuelve a la parrilla y empieza a grabar una carrera nueva.
+   */
+  void startRecording();
+
+  /**
+   * @brief Graba la vuelta en curso del jugador y, si al cerrarla es su mejor vuelta,
+   *        la convierte en el fantasma y la guarda en disco. Se llama tras cada tick.
+   */
+  void updateGhost();
+
+  /**
+   * @brief Sita el fantasma en el mismo instante de vuelta que el jugador.
+   * @param alpha Fraccin del tick en curso (igual que la interpolacin de los karts).
+   */
+  void placeGhost(float alpha);
+
+  /**
+   * @brief Un tick de simulacin de duracin fija (jugador, IA, vueltas, podio).
+   * @param dt Duracin del tick (FixedTimestep::getStep()).
+   */
+  void fixedUpdate(float dt);
+
+  /**
+   * @brief Dibuja la escena interpolando entre el tick anterior y el actual.
+   * @param alpha Fraccin del tick en curso [0,1].
+   */
+  void render(float alpha);
+
+  /**
+   * @brief Acerca la cmara al kart seguido y pone su vista en la ventana.
+   * @param dt Tiempo real del frame (s).
+   * @param alpha Fraccin del tick en curso, para seguir la posicin interpolada.
+   */
+  void updateCamera(float dt, float alpha);
+
+  /** @brief Kart que sigue la cmara: el jugador o, sin jugador, el lder. */
+  EngineUtilities::TSharedPointer<A_Racer> followedRacer() const;
+
+  /** @brief Transform de followedRacer() (vaco si no hay). */
+  EngineUtilities::TSharedPointer<Transform> cameraTarget() const;
+
+  /**
+   * @brief Vista Mode 7: suelo en perspectiva detrs del kart seguido y karts como
+   *        billboards ordenados de lejos a cerca (tecla M).
+   */
+  void renderMode7(float alpha);
+
+  /**
+   * @brief Encola en m_spriteBatch las cajas y proyectiles: con su imagen del atlas o, sin
+   *        ella, con dos formas reutilizadas (sin crear objetos por frame).
+   */
+  void renderItems();
+
+  /** @brief Coloca un punto por corredor en el minimapa y lo dibuja (vista de pantalla). */
+  void renderMinimap(float alpha);
+
+  /**
+   * @brief Encola el sprite (o la forma) de @p actor en m_spriteBatch; si no puede, vaca
+   *        el lote y lo dibuja con render() para respetar el orden.
+   */
+  void submitActor(Actor& actor, int layer);
+
+  /**
+   * @brief Crea los lotes de partculas y aade a cada kart sus emisores (chispas, polvo, escape).
+   */
+  void setupEffects();
+
+  /**
+   * @brief Ajusta la emisin de cada kart a su estado (derrape, fuera de pista, velocidad).
+   *        Se llama antes de cada tick; las partculas se emiten durante el tick.
+   */
+  void updateEffects(float dt);
+
 private:
   // --- Infraestructura ---
   EngineUtilities::TSharedPointer<Window> m_windowPtr;
@@ -59,19 +148,48 @@ private:
 
   // --- Escena ---
   EngineUtilities::TSharedPointer<Actor>   m_trackActor;
-  std::vector<EngineUtilities::TSharedPointer<A_Racer>> m_racers;
-  std::vector<EngineUtilities::TSharedPointer<A_Racer>> m_finishedOrder;
-
-  // --- Carrera ---
-  std::vector<sf::Vector2f> m_path;
-  sf::FloatRect             m_finishLine;
-
-  // --- Jugador ---
-  int           m_playerIdx = -1;     // -1 = nadie
-  sf::Vector2f  m_playerVel = { 0.f,0.f };
-  float         m_playerAng = 0.f;     // radianes
-  float         m_playerAccel = 480.f; // px/s^2
-  float         m_playerTurn = 2.6f;  // rad/s (a velocidad alta gira ms)
-  float         m_playerMaxSp = 380.f; // px/s
-  float         m_playerDrag = 0.90f; // friccin por frame
+  TrackStreamer m_trackStreamer;       ///< Pista por chunks alrededor de la cmara (si existe el ndice).
+  SpriteBatch m_spriteBatch;           ///< Pista, fantasma y karts: una llamada de dibujo por textura.
+  Camera      m_camera;                ///< Vista que sigue al jugador; su rectngulo decide qu se dibuja.
+  Mode7Renderer m_mode7;               ///< Suelo en perspectiva (CPU) de la vista Mode 7.
+  sf::Texture m_mode7Texture;          ///< Framebuffer de m_mode7 subido una vez por frame.
+  bool        m_mode7Enabled = false;  ///< Tecla M: vista Mode 7 en lugar de la cenital.
+  Minimap     m_minimap;               ///< Esquina superior derecha: pista cacheada y un punto por corredor.
+
+  // --- Partculas (antes que m_sim: los emisores de los karts apuntan aqu) ---
+  sf::Texture    m_particleTexture;      ///< Punto difuminado generado en setupEffects().
+  ParticleSystem m_particles;
+
+  /** @brief Emisores de un kart (ndice de parrilla). */
+  struct KartEffects {
+    EngineUtilities::TSharedPointer<ParticleEmitter> sparks;
+    EngineUtilities::TSharedPointer<ParticleEmitter> dust;
+    EngineUtilities::TSharedPointer<ParticleEmitter> exhaust;
+  };
+  std::vector<KartEffects> m_kartEffects;
+
+  // --- Carrera (corredores, pista, vueltas, podio y kart del jugador) ---
+  RaceSimulation m_sim;
+
+  // --- Bucle de paso fijo ---
+  FixedTimestep m_timestep{ 60.f, 5 }; ///< 60 Hz, hasta 5 ticks de recuperacin por frame.
+  bool        m_itemKeyWasDown = false; ///< Tecla de objeto pulsada el tick anterior (se usa al pulsar, no al mantener).
+
+  // --- Grabacin / reproduccin ---
+  RaceReplay  m_replay;
+  bool        m_watching = false;      ///< true = los ticks salen de m_replay, no del teclado.
+  bool        m_imageSurface = false;  ///< La superficie viene de la imagen de la pista.
+
+  // --- Fantasma (mejor vuelta del jugador) ---
+  EngineUtilities::TSharedPointer<A_Ghost> m_ghost;
+  GhostLap    m_ghostRecording;        ///< Vuelta en curso del jugador.
+  int         m_ghostRacer = -1;       ///< Corredor que se est grabando (-1 = ninguno).
+  int         m_ghostLap = -1;         ///< Vueltas completadas al empezar la grabacin.
+  bool        m_ghostValid = false;    ///< La grabacin empez en la meta (vuelta completa).
+
+  // --- Objetos ---
+  CShape      m_boxShape;              ///< Caja de objetos sin imagen (se recoloca y se encola para cada una).
+  CShape      m_projectileShape;       ///< Pltano / caparazn sin imagen (se recolorea segn el tipo).
+  TextureAtlas::Region m_boxRegion;    ///< Imagen de la caja en el atlas (sin textura = forma).
+  std::array<TextureAtlas::Region, 5> m_projectileRegions; ///< Imagen por ItemSystem::Item (sin textura = forma).
 };
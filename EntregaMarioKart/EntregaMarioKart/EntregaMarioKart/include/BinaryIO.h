@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file BinaryIO.h
+ * @brief Utilidades comunes de los ficheros binarios (grabaciones, fantasmas, cachés).
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/**
+ * @brief Lectura/escritura de valores crudos y enteros compactos (varint + zigzag).
+ *
+ * Los valores se escriben tal cual están en memoria: los ficheros sólo se leen en la misma
+ * plataforma que los escribió (igual que StateWriter).
+ */
+namespace BinaryIO {
+  /** @brief Añade @p v en varint (7 bits por byte, el bit alto indica que sigue otro). */
+  inline void putVarint(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    while (v >= 0x80) {
+      out.push_back(static_cast<std::uint8_t>(v | 0x80));
+      v >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(v));
+  }
+
+  /**
+   * @brief Lee un varint de @p in desde @p pos y avanza @p pos.
+   * @return false si el buffer se acaba a mitad del número.
+   */
+  inline bool getVarint(const std::vector<std::uint8_t>& in, std::size_t& pos, std::uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35 && pos < in.size(); shift += 7) {
+      const std::uint8_t byte = in[pos++];
+      v |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** @brief Entero con signo a sin signo con los valores pequeños cerca de 0 (0, -1, 1, -2...). */
+  inline std::uint32_t zigzag(int v) {
+    return (static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31);
+  }
+
+  inline int unzigzag(std::uint32_t v) {
+    return static_cast<int>(v >> 1) ^ -static_cast<int>(v & 1);
+  }
+
+  template<typename T>
+  void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template<typename T>
+  void readValue(std::ifstream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  }
+
+  /**
+   * @brief Bytes que quedan desde la posición actual hasta el final del fichero.
+   *
+   * Los cargadores comparan con esto los tamaños de la cabecera antes de reservar: un
+   * fichero truncado o corrupto no debe poder pedir gigas de memoria.
+   */
+  inline std::uint64_t remainingBytes(std::ifstream& in) {
+    const std::streampos here = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::streampos end = in.tellg();
+    in.seekg(here);
+    return (here < 0 || end < here) ? 0 : static_cast<std::uint64_t>(end - here);
+  }
+}
@@ -10,12 +10,18 @@
 #include <Memory/TSharedPointer.h>
 #include <ECS/Component.h>
 #include <ECS/Texture.h>
+#include "ShapeGeometry.h"
 
 class Window;
 
 /**
  * @class CShape
- * @brief A component that represents a 2D SFML shape and can hold a texture.
+ * @brief A component that represents a 2D shape and can hold a texture.
+ *
+ * The geometry is a shared, immutable ShapeGeometry (one per type and parameters);
+ * each instance only stores its transform, colors and texture. appendTo() writes the
+ * transformed triangles into a caller's vertex array, which is how SpriteBatch draws many
+ * shapes with one draw call per texture. render() draws a single shape on its own.
  */
 class CShape : public Component {
 public:
@@ -30,6 +36,13 @@ public:
    */
   explicit CShape(ShapeType shapeType);
 
+  /**
+   * @brief Constructs a shape with explicit geometry parameters.
+   * @param key Type and parameters of the shared geometry.
+   * @param color Fill color.
+   */
+  CShape(const ShapeGeometry::Key& key, const sf::Color& color);
+
   /**
    * @brief Virtual destructor.
    */
@@ -58,11 +71,16 @@ public:
   void destroy() override;
 
   /**
-   * @brief Creates or replaces the underlying SFML shape with a new type.
-   * @param shapeType Primitive to build (RECTANGLE, CIRCLE, etc.).
+   * @brief Switches to the default geometry and color of a primitive type.
+   * @param shapeType Primitive to use (RECTANGLE, CIRCLE, etc.).
    */
   void createShape(ShapeType shapeType);
 
+  /**
+   * @brief Switches to the shared geometry identified by @p key (color is kept).
+   */
+  void setGeometry(const ShapeGeometry::Key& key);
+
   /**
    * @brief Sets the world position of the shape.
    * @param x X coordinate.
@@ -82,6 +100,18 @@ public:
    */
   void setFillColor(const sf::Color& color);
 
+  /**
+   * @brief Changes the outline color (visible when the outline thickness is > 0).
+   * @param color New color to apply.
+   */
+  void setOutlineColor(const sf::Color& color);
+
+  /**
+   * @brief Sets the outline thickness, drawn outside the shape like sf::Shape.
+   * @param thickness Thickness in pixels (0 = no outline).
+   */
+  void setOutlineThickness(float thickness);
+
   /**
    * @brief Sets the rotation of the shape in degrees.
    * @param angleDegrees Angle in degrees (clockwise).
@@ -95,10 +125,36 @@ public:
   void setScale(const sf::Vector2f& scl);
 
   /**
-   * @brief Returns the raw SFML shape pointer (may be nullptr if not created).
-   * @return Pointer to the underlying sf::Shape.
+   * @brief Sets the local origin (rotation and scale pivot).
+   * @param origin Origin in local coordinates.
+   */
+  void setOrigin(const sf::Vector2f& origin);
+
+  /**
+   * @brief Per-instance transform (position, rotation, scale, origin).
    */
-  sf::Shape* getShape();
+  sf::Transformable& getTransformable() { return m_transform; }
+  const sf::Transformable& getTransformable() const { return m_transform; }
+
+  /**
+   * @brief Shared geometry (null for ShapeType::EMPTY).
+   */
+  const EngineUtilities::TSharedPointer<ShapeGeometry>& getGeometry() const { return m_geometry; }
+
+  const sf::Color& getFillColor() const { return m_fillColor; }
+
+  ShapeType getShapeType() const { return m_shapeType; }
+
+  /**
+   * @brief Appends the shape's triangles in world coordinates to @p triangles.
+   * @param triangles Vertex array with sf::PrimitiveType::Triangles, shared by many shapes.
+   */
+  void appendTo(sf::VertexArray& triangles) const;
+
+  /**
+   * @brief SFML texture the coordinates written by appendTo() refer to (nullptr = plain color).
+   */
+  const sf::Texture* getDrawTexture() const;
 
   /**
    * @brief Assigns a texture component to be used as fill for the shape.
@@ -108,9 +164,41 @@ public:
 
 private:
   /**
-   * @brief Owned pointer to the underlying SFML shape instance.
+   * @brief Shared geometry; identical shapes point to the same object.
+   */
+  EngineUtilities::TSharedPointer<ShapeGeometry> m_geometry;
+
+  /**
+   * @brief Per-instance transform.
+   */
+  sf::Transformable m_transform;
+
+  /**
+   * @brief Per-instance fill color.
+   */
+  sf::Color m_fillColor = sf::Color::White;
+
+  /**
+   * @brief Per-instance outline color.
+   */
+  sf::Color m_outlineColor = sf::Color::White;
+
+  /**
+   * @brief Optional texture mapped over the geometry bounds.
+   */
+  EngineUtilities::TSharedPointer<Texture> m_texture;
+
+  /**
+   * @brief Local vertices with this instance's colors and texture coordinates, used by
+   *        render(). Built on the first render() and only rebuilt after a geometry, color
+   *        or texture change; batched shapes never allocate it.
+   */
+  sf::VertexArray m_vertices{ sf::PrimitiveType::Triangles };
+
+  /**
+   * @brief m_vertices must be rebuilt before the next render().
    */
-  EngineUtilities::TSharedPointer<sf::Shape> m_shapePtr;
+  bool m_verticesDirty = true;
 
   /**
    * @brief Current primitive type represented by this component.
@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * @file Camera.h
+ * @brief Cámara que sigue a un kart y define el rectángulo de mundo visible (culling).
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Vector2.hpp>
+
+class Window;
+
+/**
+ * @class Camera
+ * @brief Centro y tamaño de la vista de Window, suavizados hacia un objetivo.
+ *
+ * El centro se acerca exponencialmente al objetivo adelantado en la dirección de su
+ * velocidad (se ve más pista por delante) y se limita a los bordes del mundo, así que
+ * nunca se enseña lo que hay fuera de la pista. getVisibleRect() es lo que usan los
+ * pases de visibilidad para descartar sprites, partículas y trozos de pista.
+ */
+class Camera {
+public:
+  /**
+   * @brief Ajustes de la cámara.
+   */
+  struct Params {
+    float zoom = 0.7f;          ///< Mundo visible = tamaño de la ventana * zoom.
+    float stiffness = 6.f;      ///< 1/s con que el centro alcanza al objetivo.
+    float lookAhead = 0.25f;    ///< s de velocidad que se adelanta el objetivo.
+  };
+
+  Params& getParams() { return m_params; }
+
+  /**
+   * @brief Tamaño de la ventana en píxeles (la vista mide esto por el zoom).
+   */
+  void setViewportSize(const sf::Vector2f& size) { m_viewportSize = size; }
+
+  /**
+   * @brief Mundo al que se limita la vista (tamaño nulo = sin límites).
+   */
+  void setBounds(const sf::FloatRect& bounds) { m_bounds = bounds; }
+
+  /**
+   * @brief Coloca la cámara en @p center sin suavizado.
+   */
+  void reset(const sf::Vector2f& center);
+
+  /**
+   * @brief Acerca el centro a @p target (adelantado según @p velocity) durante @p dt segundos.
+   */
+  void follow(const sf::Vector2f& target, const sf::Vector2f& velocity, float dt);
+
+  /** @brief Vista de SFML con el centro y el tamaño actuales. */
+  sf::View getView() const;
+
+  /** @brief Pone la vista en @p window. */
+  void apply(Window& window) const;
+
+  /**
+   * @brief Rectángulo de mundo visible, ampliado @p margin píxeles por cada lado.
+   */
+  sf::FloatRect getVisibleRect(float margin = 0.f) const;
+
+  const sf::Vector2f& getCenter() const { return m_center; }
+
+  /** @brief Tamaño de mundo que cubre la vista. */
+  sf::Vector2f getSize() const { return m_viewportSize * m_params.zoom; }
+
+private:
+  /** @brief Limita m_center para que la vista no salga de m_bounds. */
+  void clampToBounds();
+
+  Params        m_params;
+  sf::Vector2f  m_viewportSize{ 1024.f, 768.f };
+  sf::FloatRect m_bounds;
+  sf::Vector2f  m_center{ 0.f, 0.f };
+};
@@ -17,6 +17,7 @@
 #include "ECS/Texture.h"
 
 class Window;
+class SpriteBatch;
 
 /**
  * @class Actor
@@ -58,6 +59,20 @@ public:
    */
   virtual void render(const EngineUtilities::TSharedPointer<Window>& window);
 
+  /**
+   * @brief Encola el sprite del actor en @p batch en lugar de dibujarlo; sin textura,
+   *        encola su CShape.
+   * @param layer Capa de dibujo dentro del lote.
+   * @return false si no se pudo encolar nada: entonces hay que dibujarlo con render().
+   */
+  virtual bool submit(SpriteBatch& batch, int layer);
+
+  /**
+   * @brief Sincroniza shape/sprite con el Transform interpolado entre el tick anterior y el actual.
+   * @param alpha Fraccin del tick en curso [0,1] (ver FixedTimestep::getAlpha()).
+   */
+  void interpolate(float alpha);
+
   /**
    * @brief Libera recursos asociados al actor (si aplica).
    */
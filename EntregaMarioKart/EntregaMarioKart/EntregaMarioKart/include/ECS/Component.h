@@ -23,7 +23,9 @@ enum
   PHYSICS = 4,    ///< Physics simulation component
   AUDIOSOURCE = 5,///< Audio source component
   SHAPE = 6,      ///< Shape component (geometry-based)
-  TEXTURE = 7     ///< Texture component (for applying textures)
+  TEXTURE = 7,    ///< Texture component (for applying textures)
+  PARTICLES = 8,  ///< Particle emitter component
+  DIRECTIONS = 9  ///< Pre-rotated sprite sheet component
 };
 
 /**
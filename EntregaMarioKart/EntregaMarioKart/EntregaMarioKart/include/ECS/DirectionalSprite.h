@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file DirectionalSprite.h
+ * @brief Componente que elige el fotograma de una hoja de sprites pre-rotada según el ángulo de vista.
+ */
+
+#include "Prerequisites.h"
+#include "ECS/Component.h"
+#include "TextureAtlas.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <string>
+
+/**
+ * @class DirectionalSprite
+ * @brief Hoja de N fotogramas del mismo kart visto desde N ángulos (SpriteSheetBaker).
+ *
+ * El fotograma i muestra el kart con rumbo i * 360 / N grados respecto a la cámara
+ * (0 = de espaldas, creciendo en sentido horario), ya girado y aplastado: para dibujarlo
+ * basta un quad sin rotación, así que todos los karts de la misma página de atlas salen
+ * en una sola llamada de SpriteBatch.
+ *
+ * Los fotogramas van en filas de columnsFor(N) celdas iguales, de izquierda a derecha y
+ * de arriba abajo, dentro del recorte de la hoja.
+ */
+class DirectionalSprite : public Component {
+public:
+  static constexpr int kMaxColumns = 8;  ///< Columnas máximas de la hoja.
+
+  /** @brief Columnas de una hoja de @p directions fotogramas. */
+  static int columnsFor(int directions);
+
+  /** @brief Nombre de la hoja horneada de @p character (bin/<nombre>.png). */
+  static std::string sheetName(const std::string& character) { return character + " direcciones"; }
+
+  /**
+   * @param sheet Recorte de la hoja en el atlas (sin textura = componente vacío).
+   * @param directions Fotogramas de la hoja.
+   * @param worldWidth Ancho de una celda en px de pista (la diagonal del sprite cenital).
+   */
+  DirectionalSprite(const TextureAtlas::Region& sheet, int directions, float worldWidth);
+  ~DirectionalSprite() override = default;
+
+  void start() override {}
+  void update(float /*deltaTime*/) override {}
+  void render(const EngineUtilities::TSharedPointer<Window>& /*window*/) override {}
+  void destroy() override {}
+
+  /** @brief true si la hoja está cargada y su tamaño encaja con el número de fotogramas. */
+  bool isValid() const { return m_sheet.texture != nullptr && m_frameSize.x > 0 && m_frameSize.y > 0; }
+
+  /**
+   * @brief Fotograma para un kart con rumbo @p heading visto por una cámara que mira a @p cameraAngle.
+   * @param heading Rumbo del kart (rad, 0 = +x, como KartPhysics).
+   * @param cameraAngle Rumbo de la cámara (rad, el mismo criterio).
+   */
+  int frameFor(float heading, float cameraAngle) const;
+
+  /** @brief Recorte del fotograma @p frame en la página del atlas. */
+  sf::IntRect getFrameRect(int frame) const;
+
+  const sf::Texture* getTexture() const { return m_sheet.texture; }
+  sf::Vector2i getFrameSize() const { return m_frameSize; }
+  int   getDirections() const { return m_directions; }
+  float getWorldWidth() const { return m_worldWidth; }
+
+private:
+  TextureAtlas::Region m_sheet;
+  int          m_directions = 1;
+  int          m_columns = 1;
+  sf::Vector2i m_frameSize{ 0, 0 };
+  float        m_worldWidth = 0.f;
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file KartPhysics.h
+ * @brief Componente de física de kart: integración por dt independiente de la frecuencia.
+ */
+
+#include "Prerequisites.h"
+#include "ECS/Component.h"
+#include "ECS/Transform.h"
+#include "TrackSurface.h"
+#include <SFML/System/Vector2.hpp>
+
+/**
+ * @class KartPhysics
+ * @brief Modelo de conducción compartido por el jugador y la IA.
+ *
+ * El estado es la velocidad (px/s) y el rumbo (rad); la posición vive en el Transform.
+ * Cada paso es Euler semi-implícito: primero se actualiza la velocidad (motor, rozamientos
+ * exponenciales exp(-k*h), agarre lateral) y luego la posición con la velocidad nueva.
+ * Los rozamientos son tasas por segundo, así que 30, 60 o 240 ticks por segundo dan la
+ * misma conducción. Un dt grande se parte en sub-pasos de como mucho maxSubStep, y en
+ * cada sub-paso se mira la superficie: el kart no atraviesa un muro aunque el frame tarde.
+ *
+ * Derrape: con el botón de derrape, girando y por encima de driftMinSpeed, el kart pierde
+ * agarre lateral y gira más hacia el lado en que empezó. Al soltar tras miniTurboTime
+ * segundos gana un turbo de boostTime segundos.
+ *
+ * El componente no se integra solo (update() no hace nada): lo avanza quien lo posee con
+ * integrate(), igual que Transform::seek().
+ */
+class KartPhysics : public Component {
+public:
+  /**
+   * @brief Parámetros del kart. Las tasas (1/s) no dependen de la frecuencia de ticks.
+   */
+  struct Params {
+    float accel = 480.f;            ///< Aceleración del motor (px/s^2).
+    float brake = 900.f;            ///< Frenada al pedir el sentido contrario (px/s^2).
+    float maxSpeed = 380.f;         ///< Velocidad máxima hacia delante (px/s).
+    float reverseScale = 0.5f;      ///< Velocidad máxima marcha atrás / maxSpeed.
+    float turnRate = 2.6f;          ///< Giro con volante a fondo y velocidad máxima (rad/s).
+    float minTurnScale = 0.25f;     ///< Fracción de giro casi parado.
+    float drag = 6.32f;             ///< Rozamiento sin gas (1/s); 6.32 = 0.9 por tick de 60 Hz.
+    float offroadDrag = 6.32f;      ///< Pérdida del exceso sobre el límite del terreno (1/s).
+    float grip = 14.f;              ///< Amortiguación de la velocidad lateral (1/s).
+    float driftGrip = 2.5f;         ///< Agarre lateral derrapando (1/s).
+    float driftTurnScale = 1.35f;   ///< Giro extra derrapando.
+    float driftMinSpeed = 0.4f;     ///< Velocidad mínima para derrapar / maxSpeed.
+    float miniTurboTime = 0.8f;     ///< Derrape necesario para el turbo (s).
+    float boostTime = 0.6f;         ///< Duración del turbo (s).
+    float boostScale = 1.2f;        ///< Velocidad máxima con turbo / maxSpeed.
+    float maxSubStep = 1.f / 60.f;  ///< Sub-paso máximo (s).
+    int   maxSubSteps = 8;          ///< Tope de sub-pasos por llamada (un dt mayor se recorta).
+  };
+
+  /**
+   * @brief Mandos de un tick.
+   */
+  struct Input {
+    float throttle = 0.f;  ///< -1 (frenar / atrás) .. 1 (gas).
+    float steer = 0.f;     ///< -1 (izquierda) .. 1 (derecha).
+    bool  drift = false;   ///< Botón de derrape.
+  };
+
+  /**
+   * @brief Estado dinámico completo (mandos incluidos), para guardar y restaurar (rollback).
+   */
+  struct State {
+    Input        input;
+    sf::Vector2f velocity{ 0.f, 0.f };
+    float        heading = 0.f;
+    float        driftDir = 0.f;
+    float        driftTime = 0.f;
+    float        boostTime = 0.f;
+    float        terrainScale = 1.f;
+    bool         drifting = false;
+  };
+
+  KartPhysics() : Component(ComponentType::PHYSICS) {}
+  ~KartPhysics() override = default;
+
+  void start() override {}
+  void update(float /*deltaTime*/) override {}
+  void render(const EngineUtilities::TSharedPointer<Window>& /*window*/) override {}
+  void destroy() override {}
+
+  /**
+   * @brief Kart parado mirando hacia @p heading (rad), sin derrape ni turbo.
+   */
+  void reset(float heading);
+
+  /**
+   * @brief Avanza @p deltaTime segundos moviendo @p xf (posición y rotación).
+   * @param surface Superficie opcional: límite fuera de pista y muros por sub-paso.
+   * @param spriteAngleOffset Grados sumados al rumbo para orientar el sprite.
+   * @return Sub-pasos usados.
+   */
+  int integrate(Transform& xf, float deltaTime, const TrackSurface* surface = nullptr,
+                float spriteAngleOffset = 0.f);
+
+  /**
+   * @brief Mandos para ir hacia @p target a @p desiredSpeed (IA).
+   */
+  Input steerTowards(const sf::Vector2f& position, const sf::Vector2f& target, float desiredSpeed) const;
+
+  /**
+   * @brief Suma un cambio de velocidad instantáneo (choques, muros).
+   */
+  void addVelocity(const sf::Vector2f& deltaVelocity) { m_velocity += deltaVelocity; }
+
+  /**
+   * @brief Turbo de @p seconds como el del mini-turbo (objetos).
+   */
+  void startBoost(float seconds) { m_boostTime = (seconds > m_boostTime) ? seconds : m_boostTime; }
+
+  void setParams(const Params& params) { m_params = params; }
+  const Params& getParams() const { return m_params; }
+  Params& getParams() { return m_params; }
+
+  void setInput(const Input& input) { m_input = input; }
+  const Input& getInput() const { return m_input; }
+
+  /**
+   * @brief Límite de velocidad del terreno cuando no hay superficie (1 = asfalto).
+   */
+  void setTerrainScale(float scale) { m_terrainScale = scale; }
+
+  /** @brief Factor de velocidad máxima fuera de pista al consultar la superficie. */
+  void setOffroadSpeedScale(float scale) { m_offroadSpeedScale = scale; }
+
+  const sf::Vector2f& getVelocity() const { return m_velocity; }
+  float getHeading() const { return m_heading; }
+  sf::Vector2f getForward() const;
+
+  /** @brief Velocidad en la dirección del morro (px/s, negativa marcha atrás). */
+  float getForwardSpeed() const;
+
+  /** @brief Copia del estado dinámico. */
+  State getState() const;
+
+  /** @brief Restaura un estado de getState() (los parámetros no cambian). */
+  void setState(const State& state);
+
+  bool  isDrifting() const { return m_drifting; }
+  float getDriftTime() const { return m_driftTime; }
+  float getBoostTime() const { return m_boostTime; }
+
+private:
+  /** @brief Un sub-paso de @p h segundos. */
+  void subStep(Transform& xf, float h, const TrackSurface* surface);
+
+  /** @brief Entra, mantiene o suelta el derrape. */
+  void updateDrift(float speed, float h);
+
+  Params       m_params;
+  Input        m_input;
+
+  // --- Estado ---
+  sf::Vector2f m_velocity{ 0.f, 0.f }; ///< px/s en coordenadas de mundo.
+  float        m_heading = 0.f;        ///< Rumbo (rad).
+  bool         m_drifting = false;
+  float        m_driftDir = 0.f;       ///< -1 / 1: lado del derrape en curso.
+  float        m_driftTime = 0.f;      ///< Segundos derrapando.
+  float        m_boostTime = 0.f;      ///< Turbo restante (s).
+
+  // --- Terreno ---
+  float        m_terrainScale = 1.f;
+  float        m_offroadSpeedScale = 0.55f;
+};
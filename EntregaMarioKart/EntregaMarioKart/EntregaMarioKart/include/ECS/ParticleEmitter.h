@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * @file ParticleEmitter.h
+ * @brief Componente que emite partículas desde la posición de su actor.
+ */
+
+#include "Prerequisites.h"
+#include "ECS/Component.h"
+#include "ECS/Transform.h"
+#include "ParticleSystem.h"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+/**
+ * @class ParticleEmitter
+ * @brief Chorro de partículas pegado a un actor (chispas, polvo, escape).
+ *
+ * Lee el Transform del actor en update() y escribe las partículas en un lote de un
+ * ParticleSystem compartido: el componente no guarda partículas ni dibuja nada. Las
+ * partículas de un tick se reparten a lo largo del movimiento de ese tick, así que a
+ * cualquier velocidad forman una estela continua y no grumos.
+ */
+class ParticleEmitter : public Component {
+public:
+  /**
+   * @brief Forma del chorro. Posición y dirección van en ejes del actor (giran con su Transform).
+   */
+  struct Params {
+    std::size_t  batch = 0;                 ///< Lote de ParticleSystem::addBatch().
+    float        rate = 30.f;               ///< Partículas/s con escala 1.
+    sf::Vector2f offset{ 0.f, 0.f };        ///< Punto de emisión (px, ejes del actor).
+    float        direction = 0.f;           ///< Grados, ejes del actor.
+    float        spread = 20.f;             ///< +- grados alrededor de direction.
+    float        speedMin = 20.f;           ///< px/s.
+    float        speedMax = 60.f;
+    float        lifeMin = 0.3f;            ///< s.
+    float        lifeMax = 0.6f;
+    float        size = 2.f;                ///< Media anchura al nacer (px).
+    float        growth = 0.f;              ///< px/s.
+    sf::Color    color = sf::Color::White;
+    float        inherit = 0.f;             ///< Fracción de la velocidad del actor que heredan.
+  };
+
+  /**
+   * @param system Destino de las partículas; debe vivir más que el componente.
+   * @param transform Transform del actor al que se añade el componente.
+   */
+  ParticleEmitter(ParticleSystem& system, const EngineUtilities::TSharedPointer<Transform>& transform,
+                  const Params& params);
+
+  void start() override {}
+  void render(const EngineUtilities::TSharedPointer<Window>& /*window*/) override {}
+  void destroy() override {}
+
+  /**
+   * @brief Emite las partículas que tocan en @p deltaTime (rate * escala).
+   */
+  void update(float deltaTime) override;
+
+  /**
+   * @brief Multiplica la emisión (0 = apagado); p. ej. el polvo según la velocidad.
+   */
+  void setRateScale(float scale) { m_rateScale = scale; }
+
+  float getRateScale() const { return m_rateScale; }
+
+  Params& getParams() { return m_params; }
+
+private:
+  /** @brief Azar en [0, 1) (xorshift con semilla por emisor; sólo efectos visuales). */
+  float random01();
+
+  ParticleSystem*                           m_system = nullptr;
+  EngineUtilities::TSharedPointer<Transform> m_transform;
+  Params                                    m_params;
+  float                                     m_rateScale = 1.f;
+  float                                     m_pending = 0.f;   ///< Fracción de partícula acumulada.
+  std::uint32_t                             m_rng = 0x2545F491u;
+};
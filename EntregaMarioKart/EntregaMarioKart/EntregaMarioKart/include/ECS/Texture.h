@@ -20,10 +20,16 @@ class Window;
  *
  * Carga desde: bin/<textureName>.<extension>
  * Ej: ("Sprites/Mario","png") -> bin/Sprites/Mario.png
+ *
+ * O bien usa un recorte de una pgina de TextureAtlas sin cargar nada (ver ResourceManager).
+ * En los dos casos el origen del sprite es el centro de la imagen, como en A_Ghost.
  */
 class Texture : public Component {
 public:
   Texture(const std::string& textureName, const std::string& extension = "png");
+
+  // Sprite sobre el recorte rect de una pgina de atlas (la pgina debe vivir ms que el componente)
+  Texture(const std::string& textureName, const sf::Texture& atlasPage, const sf::IntRect& rect);
   ~Texture() override = default;
 
   void start() override {}
@@ -34,18 +40,26 @@ public:
 
   void destroy() override {}
 
-  // Acceso al recurso (por si lo necesitas)
+  // Acceso al recurso propio (vaco si el sprite sale de un atlas)
   sf::Texture& getTexture() { return m_texture; }
   const sf::Texture& getTexture() const { return m_texture; }
 
+  // true si el sprite dibuja un recorte de una pgina de atlas
+  bool isAtlas() const { return m_atlas; }
+
+  // Sprite ya colocado (nullptr si no carg); lo usa SpriteBatch en lugar de render()
+  const sf::Sprite* getSprite() const { return m_sprite ? &*m_sprite : nullptr; }
+
   // Los llama Actor para sincronizar con Transform
   void setPosition(const sf::Vector2f& p);
   void setRotation(float degrees);           // convierte a sf::Angle internamente
   void setScale(const sf::Vector2f& s);
+  void setOrigin(const sf::Vector2f& o);     // por defecto, el centro de la imagen
 
 private:
   sf::Texture               m_texture;   // recurso
   std::optional<sf::Sprite> m_sprite;    // instancia visible (si carg)
   std::string               m_name;      // ruta base (sin extensin)
   std::string               m_ext;       // "png", etc.
+  bool                      m_atlas = false;
 };
@@ -17,6 +17,8 @@ public:
     , m_position(0.f, 0.f)
     , m_rotationDegrees(0.f)
     , m_scale(1.f, 1.f)
+    , m_prevPosition(0.f, 0.f)
+    , m_prevRotationDegrees(0.f)
   {
   }
 
@@ -57,8 +59,42 @@ public:
     t.setScale(m_scale);
   }
 
+  // Interpolacion de render (paso fijo): guarda el estado al inicio de cada tick
+  void storePrevious() {
+    m_prevPosition = m_position;
+    m_prevRotationDegrees = m_rotationDegrees;
+  }
+
+  const sf::Vector2f& getPreviousPosition() const { return m_prevPosition; }
+  float getPreviousRotation() const { return m_prevRotationDegrees; }
+
+  // Restaura el estado al inicio del tick (rollback)
+  void setPrevious(const sf::Vector2f& pos, float degrees) {
+    m_prevPosition = pos;
+    m_prevRotationDegrees = degrees;
+  }
+
+  sf::Vector2f getInterpolatedPosition(float alpha) const {
+    return m_prevPosition + (m_position - m_prevPosition) * alpha;
+  }
+
+  // Interpola por el arco mas corto (evita el salto 359 -> 0 grados)
+  float getInterpolatedRotation(float alpha) const {
+    float delta = std::fmod(m_rotationDegrees - m_prevRotationDegrees + 540.f, 360.f) - 180.f;
+    return m_prevRotationDegrees + delta * alpha;
+  }
+
+  // alpha en [0,1]: 0 = estado del tick anterior, 1 = estado actual
+  void applyInterpolatedTo(sf::Transformable& t, float alpha) const {
+    t.setPosition(getInterpolatedPosition(alpha));
+    t.setRotation(sf::degrees(getInterpolatedRotation(alpha)));
+    t.setScale(m_scale);
+  }
+
 private:
   sf::Vector2f m_position;
   float        m_rotationDegrees; // en grados
   sf::Vector2f m_scale;
+  sf::Vector2f m_prevPosition;        // posicion al inicio del tick
+  float        m_prevRotationDegrees; // rotacion al inicio del tick
 };
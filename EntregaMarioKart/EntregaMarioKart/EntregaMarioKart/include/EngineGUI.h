@@ -13,6 +13,12 @@
 
 class Window;
 class A_Racer;
+class RaceRanking;
+class LapTimer;
+class ItemSystem;
+class ParticleSystem;
+class SpriteBatch;
+class TrackStreamer;
 
 /**
  * @class EngineGUI
@@ -103,6 +109,42 @@ public:
     m_racers = racers;
   }
 
+  /**
+   * @brief Clasificación de la simulación usada para ordenar la lista de corredores.
+   * @param ranking Sin propiedad; debe vivir mientras la GUI la use (nullptr = orden de parrilla).
+   */
+  void setRanking(const RaceRanking* ranking) { m_ranking = ranking; }
+
+  /**
+   * @brief Cronometraje de la simulación (última y mejor vuelta de cada corredor).
+   * @param timer Sin propiedad; nullptr = sin tiempos.
+   */
+  void setLapTimer(const LapTimer* timer) { m_lapTimer = timer; }
+
+  /**
+   * @brief Objetos de la carrera (objeto en mano de cada corredor).
+   * @param items Sin propiedad; nullptr = carrera sin objetos.
+   */
+  void setItems(const ItemSystem* items) { m_items = items; }
+
+  /**
+   * @brief Sistema de partículas cuyos contadores se muestran en Stats.
+   * @param particles Sin propiedad; nullptr = sin contadores.
+   */
+  void setParticles(const ParticleSystem* particles) { m_particles = particles; }
+
+  /**
+   * @brief Lote de sprites cuyos contadores (quads, draw calls) se muestran en Stats.
+   * @param batch Sin propiedad; nullptr = sin contadores.
+   */
+  void setSpriteBatch(const SpriteBatch* batch) { m_spriteBatch = batch; }
+
+  /**
+   * @brief Pista troceada cuyos chunks residentes y cargas se muestran en Stats.
+   * @param streamer Sin propiedad; nullptr = pista cargada entera.
+   */
+  void setTrackStreamer(const TrackStreamer* streamer) { m_trackStreamer = streamer; }
+
   /**
    * @brief Applies a different GUI theme (colors, rounding).
    * @param theme Theme enum value.
@@ -152,4 +194,22 @@ private:
 
   /** @brief Racers shown/operated in GUI panels. */
   std::vector<EngineUtilities::TSharedPointer<A_Racer>> m_racers;
+
+  /** @brief Clasificación compartida (no se ordena nada en la GUI). */
+  const RaceRanking* m_ranking = nullptr;
+
+  /** @brief Tiempos por vuelta y sector (registros por índice de parrilla). */
+  const LapTimer* m_lapTimer = nullptr;
+
+  /** @brief Objeto en mano de cada corredor (nulo sin objetos). */
+  const ItemSystem* m_items = nullptr;
+
+  /** @brief Partículas vivas, quads y llamadas de dibujo del último frame. */
+  const ParticleSystem* m_particles = nullptr;
+
+  /** @brief Sprites y llamadas de dibujo del último frame. */
+  const SpriteBatch* m_spriteBatch = nullptr;
+
+  /** @brief Chunks de pista en GPU, pendientes y descargados. */
+  const TrackStreamer* m_trackStreamer = nullptr;
 };
@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * @file FixedTimestep.h
+ * @brief Acumulador de paso fijo para la simulación (desacopla física y render).
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @class FixedTimestep
+ * @brief Convierte el tiempo real de cada frame en un número entero de ticks de simulación.
+ *
+ * Uso típico por frame:
+ * @code
+ *   int steps = timestep.advance(frameSeconds);
+ *   for (int i = 0; i < steps; ++i) simulate(timestep.getStep());
+ *   render(timestep.getAlpha());
+ * @endcode
+ * Si el frame tarda demasiado, como máximo se ejecutan @c maxSteps ticks y el
+ * tiempo sobrante se descarta (la simulación va "lenta" en vez de entrar en espiral).
+ */
+class FixedTimestep {
+public:
+  /**
+   * @brief Crea el acumulador.
+   * @param hz Frecuencia de simulación (ticks por segundo).
+   * @param maxSteps Máximo de ticks de recuperación por frame.
+   */
+  explicit FixedTimestep(float hz = 60.f, int maxSteps = 5) {
+    setHz(hz);
+    setMaxSteps(maxSteps);
+  }
+
+  /**
+   * @brief Cambia la frecuencia de simulación.
+   * @param hz Ticks por segundo (mínimo 1).
+   */
+  void setHz(float hz) {
+    m_hz = std::max(hz, 1.f);
+    m_step = 1.f / m_hz;
+  }
+
+  /** @brief Frecuencia de simulación actual. */
+  float getHz() const { return m_hz; }
+
+  /** @brief Duración de un tick en segundos (1 / Hz). */
+  float getStep() const { return m_step; }
+
+  /**
+   * @brief Límite de ticks ejecutados en un solo frame.
+   * @param maxSteps Mínimo 1.
+   */
+  void setMaxSteps(int maxSteps) { m_maxSteps = std::max(maxSteps, 1); }
+
+  /** @brief Límite actual de ticks por frame. */
+  int getMaxSteps() const { return m_maxSteps; }
+
+  /**
+   * @brief Acumula el tiempo del frame y devuelve cuántos ticks simular.
+   * @param frameSeconds Tiempo real transcurrido (ya escalado por la velocidad de juego).
+   * @return Ticks a ejecutar en este frame (0..maxSteps).
+   */
+  int advance(float frameSeconds) {
+    m_accumulator += std::max(frameSeconds, 0.f);
+    int steps = static_cast<int>(m_accumulator / m_step);
+    if (steps > m_maxSteps) {
+      m_droppedSteps += static_cast<std::uint64_t>(steps - m_maxSteps);
+      steps = m_maxSteps;
+      m_accumulator = 0.f;
+    }
+    else {
+      m_accumulator -= steps * m_step;
+    }
+    m_tick += static_cast<std::uint64_t>(steps);
+    return steps;
+  }
+
+  /**
+   * @brief Fracción del siguiente tick ya transcurrida, para interpolar el render [0,1).
+   */
+  float getAlpha() const { return std::clamp(m_accumulator / m_step, 0.f, 1.f); }
+
+  /** @brief Ticks simulados desde el último reset(). */
+  std::uint64_t getTick() const { return m_tick; }
+
+  /** @brief Ticks descartados por superar maxSteps (indicador de frames lentos). */
+  std::uint64_t getDroppedSteps() const { return m_droppedSteps; }
+
+  /**
+   * @brief Vacía el acumulador y los contadores.
+   */
+  void reset() {
+    m_accumulator = 0.f;
+    m_tick = 0;
+    m_droppedSteps = 0;
+  }
+
+private:
+  float m_hz = 60.f;                 ///< Ticks por segundo.
+  float m_step = 1.f / 60.f;         ///< Segundos por tick.
+  int   m_maxSteps = 5;              ///< Ticks máximos por frame.
+  float m_accumulator = 0.f;         ///< Tiempo real pendiente de simular.
+  std::uint64_t m_tick = 0;          ///< Ticks simulados.
+  std::uint64_t m_droppedSteps = 0;  ///< Ticks descartados.
+};
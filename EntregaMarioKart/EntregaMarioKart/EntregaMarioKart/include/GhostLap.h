@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * @file GhostLap.h
+ * @brief Trayectoria de una vuelta muestreada a intervalos fijos, cuantizada y comprimida para el fantasma.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class GhostLap
+ * @brief Posición y rumbo de un kart cada kSampleInterval segundos de una vuelta.
+ *
+ * En memoria cada muestra ocupa 6 bytes (x, y en cuartos de píxel y rumbo en 1/65536
+ * de vuelta); en disco se guarda la segunda diferencia de la posición y la diferencia
+ * del rumbo en varint zigzag, que para un kart a velocidad casi constante suelen caber en
+ * 1 byte por campo. Una vuelta de 15 s a 20 muestras/s son ~1.8 KB en memoria y ~1 KB en disco.
+ */
+class GhostLap {
+public:
+  /** @brief Segundos entre muestras. */
+  static constexpr float kSampleInterval = 0.05f;
+
+  /**
+   * @brief Empieza a grabar una vuelta nueva (t = 0 es el cruce de meta).
+   * @param racerName Personaje (se usa para la textura del fantasma).
+   */
+  void begin(const std::string& racerName);
+
+  /**
+   * @brief Añade la posición del kart en el instante @p time de la vuelta. Las muestras
+   *        se interpolan entre la llamada anterior y ésta, así que da igual la frecuencia de los ticks.
+   * @param time Segundos desde el inicio de la vuelta (puede ser negativo en la primera llamada).
+   * @param rotation Rotación del Transform en grados.
+   */
+  void record(float time, const sf::Vector2f& position, float rotation);
+
+  /**
+   * @brief Cierra la vuelta con su duración exacta (LapTimer).
+   */
+  void finish(float duration);
+
+  /**
+   * @brief Posición y rotación interpoladas en el instante @p time de la vuelta.
+   * @return false si @p time está fuera de la vuelta.
+   */
+  bool sample(float time, sf::Vector2f& position, float& rotation) const;
+
+  /** @brief Duración de la vuelta (0 si no se ha cerrado). */
+  float getDuration() const { return m_duration; }
+
+  /** @brief Personaje grabado. */
+  const std::string& getRacerName() const { return m_racerName; }
+
+  /** @brief Muestras guardadas. */
+  std::size_t getSampleCount() const { return m_samples.size(); }
+
+  /** @brief Bytes en memoria de las muestras. */
+  std::size_t getMemoryBytes() const { return m_samples.size() * sizeof(Sample); }
+
+  /** @brief Guarda la vuelta comprimida. */
+  bool save(const std::string& path) const;
+
+  /** @brief Carga una vuelta guardada con save(). */
+  bool load(const std::string& path);
+
+private:
+  /**
+   * @brief Muestra cuantizada.
+   */
+  struct Sample {
+    std::int16_t  x = 0;        ///< Cuartos de píxel.
+    std::int16_t  y = 0;
+    std::uint16_t heading = 0;  ///< 65536 = 360 grados.
+  };
+
+  /** @brief Cuantiza y añade una muestra. */
+  void push(const sf::Vector2f& position, float rotation);
+
+  std::string         m_racerName;
+  std::vector<Sample> m_samples;   ///< Muestra k = instante k * kSampleInterval.
+  float               m_duration = 0.f;
+
+  // --- Grabación ---
+  float               m_lastTime = 0.f;
+  sf::Vector2f        m_lastPosition{ 0.f, 0.f };
+  float               m_lastRotation = 0.f;
+  bool                m_hasLast = false;
+};
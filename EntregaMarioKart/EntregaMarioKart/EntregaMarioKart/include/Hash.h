@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * @file Hash.h
+ * @brief Hash FNV-1a para claves de caché y checksums de estado.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief FNV-1a de 32 y 64 bits.
+ *
+ * Se encadena pasando el resultado anterior como @p h; la primera llamada parte de la
+ * semilla del tamaño correspondiente.
+ */
+namespace Hash {
+  constexpr std::uint64_t kFnv64Seed = 14695981039346656037ull;
+  constexpr std::uint32_t kFnv32Seed = 2166136261u;
+
+  inline std::uint64_t fnv1a(std::uint64_t h, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      h = (h ^ bytes[i]) * 1099511628211ull;
+    }
+    return h;
+  }
+
+  inline std::uint32_t fnv1a(std::uint32_t h, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      h = (h ^ bytes[i]) * 16777619u;
+    }
+    return h;
+  }
+}
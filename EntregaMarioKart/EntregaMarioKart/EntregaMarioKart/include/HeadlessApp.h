@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file HeadlessApp.h
+ * @brief Modo sin ventana: ejecuta carreras completas a máxima velocidad y muestra resultados y tiempos.
+ */
+
+#include "Prerequisites.h"
+#include "RaceReplay.h"
+#include "RaceSimulation.h"
+
+#include <string>
+
+/**
+ * @class HeadlessApp
+ * @brief Alternativa a BaseApp para servidores de build y ajuste de parámetros.
+ *
+ * No crea sf::RenderWindow ni EngineGUI ni carga texturas: sólo RaceSimulation
+ * avanzada con ticks fijos sin esperar al reloj real.
+ *
+ * Uso: EntregaMarioKart --headless [--races N] [--laps L] [--hz H] [--max-time S] [--quiet]
+ *      [--karts K] [--no-collisions] [--racing-line] [--kart-physics] [--items] [--record fichero]
+ *      EntregaMarioKart --replay fichero   (re-simula una grabación y comprueba las huellas)
+ */
+class HeadlessApp {
+public:
+  /**
+   * @brief Opciones de línea de comandos del modo headless.
+   */
+  struct Options {
+    int   races = 1;              ///< Carreras a simular.
+    int   laps = 3;               ///< Vueltas por carrera.
+    float hz = 60.f;              ///< Frecuencia de simulación (igual que el juego).
+    float maxRaceSeconds = 600.f; ///< Límite de tiempo simulado por carrera (DNF al superarlo).
+    bool  quiet = false;          ///< Sólo imprime el resumen final.
+    int   karts = 4;              ///< Karts en pista (más de 4 = prueba de carga).
+    bool  collisions = true;      ///< Choques y evitación entre karts.
+    bool  racingLine = false;     ///< IA con la trazada optimizada (bin/pista de carreras.line).
+    bool  kartPhysics = false;    ///< IA conducida con KartPhysics (inercia y agarre).
+    bool  items = false;          ///< Cajas y objetos (la IA los usa).
+    std::string recordPath;       ///< Graba la última carrera en este fichero (vacío = no).
+    std::string replayPath;       ///< Reproduce esta grabación en lugar de simular carreras.
+  };
+
+  /**
+   * @brief Interpreta argv.
+   * @param argc Número de argumentos.
+   * @param argv Argumentos.
+   * @param out Opciones leídas.
+   * @return true si se pidió el modo headless (--headless o --replay).
+   */
+  static bool parseArgs(int argc, char* argv[], Options& out);
+
+  /**
+   * @brief Ejecuta las carreras e imprime resultados por stdout.
+   * @return 0 si todo va bien.
+   */
+  int run(const Options& options);
+
+private:
+  /**
+   * @brief Simula una carrera completa desde la parrilla.
+   * @return Ticks simulados.
+   */
+  std::uint64_t simulateRace(const Options& options);
+
+  /**
+   * @brief Re-simula options.replayPath e informa del primer tick que diverge.
+   * @return 0 si la reproducción coincide con la grabación, 1 si diverge o no se pudo cargar.
+   */
+  int runReplay(const Options& options);
+
+  /**
+   * @brief Imprime el orden de llegada y los tiempos de la última carrera.
+   */
+  void printResults(int raceIdx) const;
+
+  RaceSimulation m_sim;
+  RaceReplay     m_replay;
+};
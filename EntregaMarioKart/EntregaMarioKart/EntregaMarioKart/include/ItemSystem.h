@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * @file ItemSystem.h
+ * @brief Cajas de objetos, objeto en mano de cada corredor y proyectiles en un pool SoA de capacidad fija.
+ */
+
+#include "Prerequisites.h"
+#include "StateBuffer.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+class RaceSimulation;
+
+/**
+ * @class ItemSystem
+ * @brief Objetos de la carrera: plátanos, caparazones verdes (rebotan en los muros),
+ *        caparazones rojos (persiguen al de delante) y champiñones (turbo).
+ *
+ * Los proyectiles vivos ocupan las primeras getLiveCount() posiciones de arrays paralelos
+ * (posición, velocidad, edad, tipo, dueño, objetivo, rebotes) reservados en el constructor.
+ * Lanzar uno escribe en la primera posición libre y destruirlo mueve el último a su hueco:
+ * en carrera no se reserva memoria, y si el pool está lleno el lanzamiento se pierde
+ * (getDropped()). update() mueve todos los proyectiles en una pasada sobre los arrays y
+ * después resuelve muros, impactos (con la rejilla de la simulación) y cajas.
+ *
+ * Todo es determinista (azar con semilla propia, orden fijo), así que entra en las
+ * repeticiones y en saveState() para el rollback.
+ */
+class ItemSystem {
+public:
+  /**
+   * @brief Objeto en mano o tipo de proyectil.
+   */
+  enum class Item : std::uint8_t {
+    None = 0,
+    Banana,       ///< Se deja detrás; quien lo pisa gira.
+    GreenShell,   ///< Recto hacia delante; rebota en los muros.
+    RedShell,     ///< Persigue al corredor de delante.
+    Mushroom      ///< Turbo inmediato (no crea proyectil).
+  };
+
+  /** @brief Proyectiles vivos como máximo por defecto. */
+  static constexpr std::size_t kDefaultCapacity = 256;
+
+  /**
+   * @brief Ajustes de los objetos.
+   */
+  struct Params {
+    int   boxRows = 3;               ///< Filas de cajas por vuelta.
+    int   boxesPerRow = 4;
+    float boxSpacing = 26.f;         ///< Separación lateral de las cajas (px).
+    float boxRadius = 12.f;
+    float boxRespawn = 2.f;          ///< Segundos hasta que reaparece una caja recogida.
+    float shellSpeed = 520.f;        ///< px/s.
+    float shellLife = 8.f;           ///< s.
+    int   shellBounces = 5;          ///< Rebotes antes de romperse (verde).
+    float homingRate = 5.f;          ///< Giro máximo del rojo (rad/s).
+    float bananaLife = 45.f;         ///< s.
+    float projectileRadius = 9.f;
+    float armTime = 0.3f;            ///< s en que el proyectil no golpea a su dueño.
+    float spinTime = 1.2f;           ///< s sin acelerar tras un impacto.
+    float boostTime = 1.2f;          ///< s de turbo del champiñón.
+    float aiUseDelay = 1.5f;         ///< La IA guarda el objeto al menos este tiempo.
+  };
+
+  /**
+   * @param capacity Proyectiles vivos como máximo (memoria reservada aquí, una sola vez).
+   */
+  explicit ItemSystem(std::size_t capacity = kDefaultCapacity);
+
+  Params& getParams() { return m_params; }
+
+  /**
+   * @brief Coloca las cajas sobre la línea de carrera de @p sim y vacía manos y proyectiles.
+   *        Llamar después de que la simulación coloque la parrilla.
+   */
+  void reset(const RaceSimulation& sim);
+
+  /**
+   * @brief Un tick: IA de objetos, proyectiles, impactos y cajas.
+   */
+  void update(const RaceSimulation& sim, float dt);
+
+  /**
+   * @brief Usa el objeto en mano del corredor @p racer (si lo tiene desde hace un instante).
+   * @return true si se ha usado.
+   */
+  bool useItem(const RaceSimulation& sim, std::size_t racer);
+
+  /** @brief Objeto en mano del corredor @p racer. */
+  Item getHeld(std::size_t racer) const { return racer < m_held.size() ? static_cast<Item>(m_held[racer]) : Item::None; }
+
+  // --- Proyectiles (SoA, [0, getLiveCount())) ---
+  std::size_t  getLiveCount() const { return m_live; }
+  std::size_t  getCapacity() const { return m_capacity; }
+  sf::Vector2f getProjectilePosition(std::size_t i) const { return { m_x[i], m_y[i] }; }
+  Item         getProjectileType(std::size_t i) const { return static_cast<Item>(m_type[i]); }
+  float        getProjectileRadius() const { return m_params.projectileRadius; }
+
+  // --- Cajas ---
+  std::size_t  getBoxCount() const { return m_boxX.size(); }
+  sf::Vector2f getBoxPosition(std::size_t i) const { return { m_boxX[i], m_boxY[i] }; }
+  bool         isBoxActive(std::size_t i) const { return m_boxTimer[i] <= 0.f; }
+  float        getBoxRadius() const { return m_params.boxRadius; }
+
+  // --- Contadores ---
+  std::uint32_t getSpawned() const { return m_spawned; }
+  std::uint32_t getDropped() const { return m_dropped; }  ///< Lanzamientos con el pool lleno.
+  std::uint32_t getHits() const { return m_hits; }
+  std::size_t   getPeakLive() const { return m_peakLive; }
+
+  /** @brief Bytes que añade a saveState() cada proyectil vivo. */
+  static constexpr std::size_t kProjectileStateSize =
+    5 * sizeof(float) + 2 * sizeof(std::uint8_t) + sizeof(std::uint16_t) + sizeof(std::int16_t);
+
+  /** @brief Proyectiles vivos, cajas, manos, azar y contadores (rollback). */
+  void saveState(StateWriter& out) const;
+
+  /** @brief Restaura lo guardado con saveState() (misma capacidad y parrilla). */
+  void loadState(StateReader& in);
+
+private:
+  /** @brief Escribe un proyectil en el primer hueco libre. */
+  bool spawn(Item type, const sf::Vector2f& position, const sf::Vector2f& velocity,
+             std::uint16_t owner, std::int16_t target);
+
+  /** @brief Destruye el proyectil @p i moviendo el último a su lugar. */
+  void kill(std::size_t i);
+
+  /** @brief Objeto de una caja según la posición (los de detrás reciben mejores objetos). */
+  Item rollItem(int position, std::size_t racers);
+
+  /** @brief Decide si la IA usa su objeto este tick (consulta la rejilla con m_neighbors). */
+  bool wantsToUse(const RaceSimulation& sim, std::size_t racer);
+
+  std::uint32_t random();
+
+  Params m_params;
+
+  // --- Pool de proyectiles (SoA, capacidad fija) ---
+  std::size_t                m_capacity = 0;
+  std::size_t                m_live = 0;
+  std::vector<float>         m_x, m_y;
+  std::vector<float>         m_vx, m_vy;
+  std::vector<float>         m_age;
+  std::vector<std::uint8_t>  m_type;
+  std::vector<std::uint8_t>  m_bounces;
+  std::vector<std::uint16_t> m_owner;
+  std::vector<std::int16_t>  m_target;       ///< Rojo: corredor perseguido (-1 = ninguno).
+
+  // --- Cajas (SoA) ---
+  std::vector<float>         m_boxX, m_boxY;
+  std::vector<float>         m_boxTimer;     ///< >0 = recogida, reaparece al llegar a 0.
+
+  // --- Mano de cada corredor (índice de parrilla) ---
+  std::vector<std::uint8_t>  m_held;
+  std::vector<float>         m_holdTime;     ///< s con el objeto en mano.
+
+  std::vector<std::uint32_t> m_neighbors;    ///< Resultado reutilizado de las consultas.
+  std::uint32_t              m_rng = 0x9E3779B9u;
+  std::uint32_t              m_spawned = 0;
+  std::uint32_t              m_dropped = 0;
+  std::uint32_t              m_hits = 0;
+  std::size_t                m_peakLive = 0;
+};
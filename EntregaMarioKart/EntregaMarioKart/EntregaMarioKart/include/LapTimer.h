@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file LapTimer.h
+ * @brief Puertas de control por sectores con cruce por barrido y tiempos interpolados dentro del tick.
+ */
+
+#include "Prerequisites.h"
+#include "A_Racer.h"
+#include "RacingSpline.h"
+#include "StateBuffer.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class LapTimer
+ * @brief Divide la línea de carrera en sectores separados por puertas (segmentos
+ *        perpendiculares a la línea) y cronometra vueltas y parciales de cada corredor.
+ *
+ * Cada tick se corta el movimiento del kart (posición al inicio del tick -> posición
+ * final) con la siguiente puerta que le toca: aunque el kart avance más que el grosor
+ * de la meta en un tick no puede saltársela, y el parámetro del corte da el instante
+ * exacto dentro del tick. Las puertas deben pasarse en orden y hacia delante.
+ * La puerta 0 es la meta (inicio de la línea de carrera).
+ */
+class LapTimer {
+public:
+  /** @brief Máximo de sectores por vuelta (tamaño fijo del registro). */
+  static constexpr int kMaxSectors = 8;
+
+  /**
+   * @brief Puerta: segmento a-b que se cruza en la dirección @c forward.
+   */
+  struct Gate {
+    sf::Vector2f a{ 0.f, 0.f };
+    sf::Vector2f b{ 0.f, 0.f };
+    sf::Vector2f forward{ 1.f, 0.f };
+    float        distance = 0.f;  ///< Distancia de arco sobre la línea.
+  };
+
+  /**
+   * @brief Registro compacto por corredor (tiempos en segundos de carrera; <0 = sin dato).
+   */
+  struct LapRecord {
+    float lapStart = 0.f;                          ///< Inicio de la vuelta en curso.
+    float sectorStart = 0.f;                       ///< Inicio del sector en curso.
+    float lastLap = -1.f;
+    float bestLap = -1.f;
+    std::array<float, kMaxSectors> splits{};       ///< Parciales de la vuelta en curso.
+    std::array<float, kMaxSectors> bestSplits{};   ///< Mejor parcial de cada sector.
+    std::int16_t lap = 0;                          ///< Vueltas completadas.
+    std::uint8_t nextGate = 0;                     ///< Próxima puerta a cruzar.
+    std::uint8_t started = 0;                      ///< 1 tras cruzar la salida.
+  };
+
+  /**
+   * @brief Coloca las puertas a intervalos iguales de la línea de carrera.
+   * @param spline Línea ya construida.
+   * @param sectors Número de sectores (2..kMaxSectors).
+   * @param halfWidth Media longitud de cada puerta (debe cubrir todo lo transitable).
+   */
+  void build(const RacingSpline& spline, int sectors, float halfWidth);
+
+  /**
+   * @brief Reinicia los registros. Quien sale detrás de la meta (o sobre ella) debe
+   *        cruzarla primero; quien sale por delante empieza la vuelta ya lanzada.
+   */
+  void reset(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers);
+
+  /**
+   * @brief Detecta cruces del tick y actualiza vueltas y parciales en los corredores.
+   *        Usa la posición guardada al inicio del tick (Transform::storePrevious()).
+   * @param tickStart Tiempo de carrera al inicio del tick.
+   * @param dt Duración del tick.
+   * @return Número de vueltas completadas en este tick.
+   */
+  int update(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers, float tickStart, float dt);
+
+  /**
+   * @brief Registros y mejor vuelta (las puertas no cambian durante la carrera).
+   */
+  void saveState(StateWriter& out) const;
+
+  /** @brief Restaura lo guardado con saveState(). */
+  void loadState(StateReader& in);
+
+  /** @brief Registro del corredor @p id (índice de parrilla). */
+  const LapRecord& getRecord(std::size_t id) const { return m_records[id]; }
+
+  /** @brief Corredores con registro (los del último reset()). */
+  std::size_t size() const { return m_records.size(); }
+
+  /** @brief Puertas (la 0 es la meta). */
+  const std::vector<Gate>& getGates() const { return m_gates; }
+
+  /** @brief Sectores por vuelta. */
+  int getSectorCount() const { return static_cast<int>(m_gates.size()); }
+
+  /** @brief Mejor vuelta de todos los corredores (<0 si nadie ha completado una). */
+  float getBestLap() const { return m_bestLap; }
+
+private:
+  /**
+   * @brief Corte entre el movimiento p0->p1 y la puerta @p gate.
+   * @param t Fracción del movimiento en el punto de corte.
+   * @return true si se cruza hacia delante.
+   */
+  static bool crosses(const Gate& gate, const sf::Vector2f& p0, const sf::Vector2f& p1, float& t);
+
+  /** @brief Aplica el cruce de la puerta @p gate en el instante @p time. */
+  bool passGate(LapRecord& rec, int gate, float time);
+
+  std::vector<Gate>      m_gates;
+  std::vector<LapRecord> m_records;   ///< Por índice de parrilla.
+  float                  m_bestLap = -1.f;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file Minimap.h
+ * @brief Minimapa del HUD: pista cacheada en un sf::RenderTexture y un punto por corredor.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/Vector2.hpp>
+
+class RacingSpline;
+class Window;
+
+/**
+ * @class Minimap
+ * @brief Dibuja el minimapa en la esquina superior derecha con dos llamadas de dibujo.
+ *
+ * build() pinta una sola vez la pista reducida (o, sin imagen, la línea de carrera) en un
+ * sf::RenderTexture; cada frame sólo se dibuja ese fondo como un quad y los puntos de los
+ * corredores como un único sf::VertexArray. setDot() reescribe en su sitio los vértices de
+ * un punto, así que el array sólo cambia de tamaño cuando cambia el número de corredores.
+ *
+ * Va en coordenadas de pantalla: se dibuja después de Window::resetView().
+ */
+class Minimap {
+public:
+  /**
+   * @brief Tamaño y aspecto.
+   */
+  struct Params {
+    unsigned  maxSide = 192;                          ///< Lado mayor del minimapa (px de pantalla).
+    float     margin = 12.f;                          ///< Separación de los bordes de la ventana (px).
+    float     dotRadius = 4.f;                        ///< Radio de los puntos (px).
+    float     lineWidth = 60.f;                       ///< Ancho de la línea de carrera sin imagen (px de pista).
+    sf::Color background = sf::Color(0, 0, 0, 140);
+    sf::Color lineColor = sf::Color(110, 110, 110);
+  };
+
+  /**
+   * @brief Pinta el fondo del minimapa.
+   * @param worldSize Tamaño de la pista (px); decide la escala.
+   * @param track Imagen de la pista (nullptr = sólo la línea de carrera).
+   * @param line Línea de carrera dibujada cuando no hay imagen (puede ser nullptr).
+   * @return false si no se pudo crear la textura de destino.
+   */
+  bool build(const sf::Vector2f& worldSize, const sf::Texture* track, const RacingSpline* line,
+             const Params& params);
+  bool build(const sf::Vector2f& worldSize, const sf::Texture* track, const RacingSpline* line) {
+    return build(worldSize, track, line, Params());
+  }
+
+  bool isReady() const { return m_ready; }
+
+  /** @brief Número de puntos (reserva sus vértices; los nuevos quedan invisibles hasta setDot()). */
+  void setDotCount(std::size_t count);
+
+  /**
+   * @brief Coloca el punto @p index.
+   * @param world Posición en la pista (px).
+   * @param size Multiplica el radio (p. ej. mayor para el jugador).
+   */
+  void setDot(std::size_t index, const sf::Vector2f& world, const sf::Color& color, float size = 1.f);
+
+  /** @brief Dibuja fondo y puntos (dos llamadas). */
+  void render(const EngineUtilities::TSharedPointer<Window>& window);
+
+  /** @brief Posición dentro del minimapa (px) de un punto de la pista. */
+  sf::Vector2f worldToMap(const sf::Vector2f& world) const { return { world.x * m_scale, world.y * m_scale }; }
+
+  sf::Vector2f getSize() const { return m_size; }
+
+private:
+  static constexpr std::size_t kVerticesPerDot = 6;  ///< Rombo como dos triángulos.
+
+  Params            m_params;
+  sf::RenderTexture m_texture;
+  sf::VertexArray   m_background{ sf::PrimitiveType::Triangles, 6 };
+  sf::VertexArray   m_dots{ sf::PrimitiveType::Triangles };
+  sf::Vector2f      m_size{ 0.f, 0.f };
+  float             m_scale = 1.f;   ///< px de minimapa por px de pista.
+  bool              m_ready = false;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file Mode7Benchmark.h
+ * @brief Benchmark headless del relleno de Mode7Renderer (sin ventana ni GPU).
+ */
+
+#include "Prerequisites.h"
+
+#include <string>
+
+/**
+ * @class Mode7Benchmark
+ * @brief Recorre la línea de carrera por defecto con una cámara Mode 7 y mide el relleno.
+ *
+ * Usa la imagen de la pista si existe y, si no, un damero del mismo tamaño. Cada frame
+ * mueve la cámara (la peor situación: siempre hay que recalcular la tabla de filas) y,
+ * al final, repite un frame con la cámara quieta para medir el caso en caché.
+ *
+ * Uso: EntregaMarioKart --mode7-bench [--width px] [--height px] [--frames n] [--track ruta]
+ */
+class Mode7Benchmark {
+public:
+  /**
+   * @brief Configuración del benchmark.
+   */
+  struct Config {
+    unsigned    width = 1920;
+    unsigned    height = 1080;
+    int         frames = 600;
+    std::string trackPath = "bin/pista de carreras.png";
+  };
+
+  /**
+   * @brief Interpreta argv.
+   * @return true si se pidió el benchmark (--mode7-bench).
+   */
+  static bool parseArgs(int argc, char* argv[], Config& out);
+
+  /**
+   * @brief Ejecuta el benchmark e imprime media, p95, máximo y megapíxeles por segundo.
+   * @return 0 si todo va bien.
+   */
+  int run(const Config& config);
+};
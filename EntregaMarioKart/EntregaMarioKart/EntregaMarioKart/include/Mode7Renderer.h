@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * @file Mode7Renderer.h
+ * @brief Suelo en perspectiva estilo Mode 7: muestreo afín por scanline de la imagen de la pista en CPU.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Mode7Renderer
+ * @brief Rasteriza el suelo visto desde una cámara baja en un framebuffer RGBA propio.
+ *
+ * Como en el Mode 7 original, cada fila de pantalla por debajo del horizonte es una recta
+ * del suelo a una distancia fija: basta un punto de partida y un paso (u, v) por fila para
+ * recorrerla. Hay dos tablas por scanline:
+ *  - profundidad de cada fila: depende de altura, focal, horizonte y tamaño, y sólo se
+ *    recalcula cuando cambian;
+ *  - inicio y paso de cada fila: dependen además de la posición y el rumbo, y se recalculan
+ *    sólo cuando la cámara se mueve. Con la cámara quieta render() no hace nada.
+ *
+ * El bucle interior va en dos pasadas por fila: la primera calcula el índice del texel de
+ * cada píxel sin saltos (los de fuera de la imagen apuntan a un texel extra con el color
+ * de fuera), y el compilador la vectoriza; la segunda sólo copia texels. El resultado se
+ * sube a un sf::Texture con una llamada por frame (upload()).
+ */
+class Mode7Renderer {
+public:
+  /**
+   * @brief Cámara Mode 7 (coordenadas de pista, y hacia abajo).
+   */
+  struct View {
+    sf::Vector2f position{ 0.f, 0.f };  ///< Punto del suelo bajo la cámara (px de pista).
+    float angle = 0.f;                  ///< Rumbo (rad, 0 = +x, como KartPhysics).
+    float height = 40.f;                ///< Altura sobre el suelo (px de pista).
+    float focal = 320.f;                ///< Distancia focal (px de pantalla): más = menos campo de visión.
+    float horizon = 0.3f;               ///< Fila del horizonte como fracción del alto de pantalla.
+    float farDistance = 3000.f;         ///< Más lejos se pinta el color de fuera (px de pista).
+
+    bool operator==(const View& other) const {
+      return position == other.position && angle == other.angle && height == other.height
+          && focal == other.focal && horizon == other.horizon && farDistance == other.farDistance;
+    }
+    bool operator!=(const View& other) const { return !(*this == other); }
+  };
+
+  /**
+   * @brief Contadores del último render().
+   */
+  struct Stats {
+    double        fillSeconds = 0.0;   ///< Tiempo de tablas + relleno.
+    std::size_t   groundRows = 0;      ///< Filas de suelo rellenadas.
+    std::uint32_t depthRebuilds = 0;   ///< Veces que se ha recalculado la tabla de profundidad (acumulado).
+    std::uint32_t skipped = 0;         ///< render() sin cambios de cámara (acumulado).
+  };
+
+  /**
+   * @brief Copia los píxeles de la pista.
+   * @param outside Color fuera de la imagen y más allá de farDistance.
+   */
+  void setTrack(const sf::Image& image, const sf::Color& outside = sf::Color(40, 120, 40));
+
+  /** @brief Color por encima del horizonte. */
+  void setSkyColor(const sf::Color& color);
+
+  /** @brief Tamaño del framebuffer (px de pantalla). */
+  void setSize(unsigned width, unsigned height);
+
+  sf::Vector2u getSize() const { return { m_width, m_height }; }
+
+  /**
+   * @brief Rellena el framebuffer para @p view.
+   * @return false si ni la cámara, ni el tamaño, ni la pista han cambiado (el framebuffer sigue valiendo).
+   */
+  bool render(const View& view);
+
+  /**
+   * @brief Proyecta un punto del suelo con la cámara del último render().
+   * @param screen Posición en pantalla (px).
+   * @param scale Píxeles de pantalla por píxel de pista a esa distancia.
+   * @return false si queda detrás de la cámara o más allá de farDistance.
+   */
+  bool project(const sf::Vector2f& world, sf::Vector2f& screen, float& scale) const;
+
+  /** @brief Framebuffer RGBA (ancho * alto * 4 bytes). */
+  const std::uint8_t* getPixels() const { return reinterpret_cast<const std::uint8_t*>(m_pixels.data()); }
+
+  /**
+   * @brief Sube el framebuffer a @p texture (la redimensiona si hace falta).
+   * @return false si no se pudo redimensionar.
+   */
+  bool upload(sf::Texture& texture) const;
+
+  const Stats& getStats() const { return m_stats; }
+
+private:
+  /** @brief Profundidad de cada fila (0 = cielo). */
+  void rebuildDepthTable();
+
+  /** @brief Inicio y paso (u, v) de cada fila de suelo para m_view. */
+  void rebuildRowTable();
+
+  /** @brief Rellena la fila @p y de suelo (índices sin saltos y copia de texels). */
+  void fillRow(unsigned y);
+
+  // --- Pista (RGBA empaquetado; el último texel es el color de fuera) ---
+  std::vector<std::uint32_t> m_texels;
+  unsigned m_trackWidth = 0;
+  unsigned m_trackHeight = 0;
+
+  // --- Framebuffer ---
+  unsigned m_width = 0;
+  unsigned m_height = 0;
+  std::vector<std::uint32_t> m_pixels;
+  std::uint32_t m_sky = 0;
+  std::vector<std::int32_t> m_indices;   ///< Texel de cada píxel de la fila en curso.
+
+  // --- Tablas por scanline ---
+  std::vector<float> m_rowDepth;         ///< Distancia al suelo de cada fila (0 = cielo).
+  std::vector<float> m_rowU, m_rowV;     ///< Coordenada del primer píxel de cada fila.
+  std::vector<float> m_rowDu, m_rowDv;   ///< Paso por píxel de cada fila.
+
+  View  m_view;
+  bool  m_depthDirty = true;             ///< Tamaño, altura, focal, horizonte o lejanía cambiados.
+  bool  m_frameDirty = true;             ///< Cualquier cosa cambiada desde el último render().
+  Stats m_stats;
+};
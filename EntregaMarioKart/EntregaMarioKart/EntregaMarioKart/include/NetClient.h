@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file NetClient.h
+ * @brief Cliente de la carrera en red: envía los mandos de su kart y recibe snapshots del servidor.
+ */
+
+#include "Prerequisites.h"
+#include "NetProtocol.h"
+#include "NetTransport.h"
+#include "RaceSimulation.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class NetClient
+ * @brief No simula: muestra el último snapshot recibido del servidor.
+ *
+ * Envía un Input por tick con sus mandos y el tick del último snapshot que ha podido
+ * decodificar (la base de los siguientes deltas). Guarda los snapshots recibidos en un
+ * historial circular del mismo tamaño que el del servidor para decodificar contra la base
+ * que éste elija. Los snapshots que llegan tarde (más viejos que el último) se descartan.
+ */
+class NetClient {
+public:
+  /**
+   * @brief Tráfico y latencia vistos por el cliente.
+   */
+  struct Stats {
+    std::uint64_t bytesIn = 0;
+    std::uint64_t bytesOut = 0;
+    std::uint32_t snapshots = 0;     ///< Snapshots decodificados.
+    std::uint32_t stale = 0;         ///< Llegaron después de uno más nuevo.
+    std::uint32_t undecodable = 0;   ///< Base desconocida o datagrama corrupto.
+    std::uint32_t missing = 0;       ///< Huecos en la secuencia de snapshots (pérdidas).
+    float         rttSum = 0.f;      ///< Input enviado -> snapshot con su eco (s).
+    float         rttMax = 0.f;
+    std::uint32_t rttSamples = 0;
+
+    float getRttAverage() const { return rttSamples ? rttSum / static_cast<float>(rttSamples) : 0.f; }
+  };
+
+  /**
+   * @brief Empieza a saludar al servidor @p serverPeer de @p transport.
+   */
+  void connect(NetTransport& transport, int serverPeer);
+
+  /**
+   * @brief Un tick del cliente: procesa lo recibido y envía Hello o los mandos.
+   * @param now Reloj del cliente (s).
+   */
+  void update(float now, const RaceSimulation::PlayerInput& input);
+
+  /** @brief true tras recibir el Welcome. */
+  bool isConnected() const { return m_connected; }
+
+  /** @brief Kart asignado (-1 = espectador o sin conectar). */
+  int getRacer() const { return m_racer; }
+
+  int   getLaps() const { return m_laps; }
+  float getHz() const { return m_hz; }
+  int   getKartCount() const { return m_karts; }
+
+  /** @brief Último snapshot recibido (tick 0 = ninguno). */
+  const NetSnapshot& getLatest() const { return m_latest; }
+
+  /** @brief true si el último snapshot dice que la carrera terminó. */
+  bool isRaceOver() const { return (m_latest.flags & NetSnapshot::kRaceOver) != 0; }
+
+  const Stats& getStats() const { return m_stats; }
+
+private:
+  /** @brief Interpreta un datagrama del servidor. */
+  void handlePacket(const std::vector<std::uint8_t>& packet, float now);
+
+  void send();
+
+  NetTransport*             m_transport = nullptr;
+  int                       m_server = -1;
+  bool                      m_connected = false;
+  int                       m_racer = -1;
+  int                       m_karts = 0;
+  int                       m_laps = 0;
+  float                     m_hz = 60.f;
+  std::uint32_t             m_interval = 1;
+
+  std::uint32_t             m_inputTick = 0;
+  std::vector<float>        m_inputSentAt = std::vector<float>(256, 0.f); ///< Por m_inputTick % 256.
+  std::uint32_t             m_lastEcho = 0;
+
+  NetSnapshot               m_latest;
+  std::vector<NetSnapshot>  m_history;   ///< Snapshots decodificados, por (tick / intervalo) % tamaño.
+  Stats                     m_stats;
+  std::vector<std::uint8_t> m_packet;
+};
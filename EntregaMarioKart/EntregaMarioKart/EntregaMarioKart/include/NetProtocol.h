@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file NetProtocol.h
+ * @brief Mensajes de la carrera en red y snapshots de corredores cuantizados con compresión delta.
+ */
+
+#include "Prerequisites.h"
+#include "RaceSimulation.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Tipo de mensaje (primer byte de cada datagrama).
+ */
+enum class NetMessage : std::uint8_t {
+  Hello = 1,     ///< Cliente -> servidor: pide plaza.
+  Welcome = 2,   ///< Servidor -> cliente: corredor asignado y configuración.
+  Input = 3,     ///< Cliente -> servidor: mandos del tick y último snapshot recibido.
+  Snapshot = 4,  ///< Servidor -> cliente: estado de todos los corredores.
+  RollbackInput = 5 ///< Par -> par (rollback): mandos sin confirmar y siguiente tick esperado.
+};
+
+/**
+ * @class NetWriter
+ * @brief Añade bytes, varints y enteros con signo (zigzag) al final de un datagrama.
+ */
+class NetWriter {
+public:
+  explicit NetWriter(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+  void putByte(std::uint8_t v) { m_out.push_back(v); }
+  void putVarint(std::uint32_t v);
+  void putSigned(std::int32_t v);
+  void putFloat(float v);
+
+  /** @brief Mandos en 3 bytes: gas y volante en 1/127, derrape (bit 0) y objeto (bit 1). */
+  void putInput(const RaceSimulation::PlayerInput& input);
+
+private:
+  std::vector<std::uint8_t>& m_out;
+};
+
+/**
+ * @class NetReader
+ * @brief Lectura de un datagrama; cualquier lectura fuera de rango deja ok() en false.
+ */
+class NetReader {
+public:
+  explicit NetReader(const std::vector<std::uint8_t>& in) : m_in(in) {}
+
+  std::uint8_t  getByte();
+  std::uint32_t getVarint();
+  std::int32_t  getSigned();
+  float         getFloat();
+  RaceSimulation::PlayerInput getInput();
+
+  /** @brief false si algún dato estaba truncado o mal formado. */
+  bool ok() const { return m_ok; }
+
+private:
+  const std::vector<std::uint8_t>& m_in;
+  std::size_t m_pos = 0;
+  bool        m_ok = true;
+};
+
+/**
+ * @brief Los mandos tal y como llegan al otro extremo (putInput() + getInput()).
+ *        Quien simula con ellos en local debe usar también éstos.
+ */
+RaceSimulation::PlayerInput quantizeInput(const RaceSimulation::PlayerInput& input);
+
+/**
+ * @struct NetRacerState
+ * @brief Estado de un corredor tal y como viaja por la red (cuantizado).
+ */
+struct NetRacerState {
+  std::int32_t  x = 0;       ///< 1/8 px.
+  std::int32_t  y = 0;       ///< 1/8 px.
+  std::uint16_t angle = 0;   ///< Rumbo; 65536 = vuelta completa.
+  std::int16_t  speed = 0;   ///< Velocidad hacia delante (px/s).
+  std::uint8_t  lap = 0;
+  std::uint8_t  sector = 0;
+  std::uint8_t  place = 0;   ///< 0 = en carrera.
+
+  /** @brief Posición en el mundo (px). */
+  sf::Vector2f getPosition() const;
+
+  /** @brief Rumbo en radianes. */
+  float getHeading() const;
+
+  bool operator==(const NetRacerState& other) const;
+};
+
+/**
+ * @struct NetSnapshot
+ * @brief Todos los corredores en un tick del servidor.
+ *
+ * Se codifica contra otro snapshot que el cliente ya confirmó: por corredor un byte de
+ * campos cambiados y, por cada campo, la diferencia en zigzag + varint. Un kart a 380 px/s
+ * enviado a 30 Hz cuesta unos 6 bytes; uno parado, 1. Sin base se codifica contra ceros.
+ */
+struct NetSnapshot {
+  static constexpr std::uint8_t kRaceOver = 1 << 0;
+
+  std::uint32_t tick = 0;
+  std::uint8_t  flags = 0;
+  std::vector<NetRacerState> racers;
+
+  /**
+   * @brief Captura @p sim en el tick @p tick.
+   * @param dt Duración del tick (velocidad de la IA sin física).
+   */
+  void capture(const RaceSimulation& sim, std::uint32_t tick, float dt);
+
+  /**
+   * @brief Escribe flags y corredores como delta contra @p base (nullptr = completo).
+   */
+  void encode(NetWriter& out, const NetSnapshot* base) const;
+
+  /**
+   * @brief Lee lo escrito por encode() con la misma @p base.
+   * @return false si el datagrama está mal formado.
+   */
+  bool decode(NetReader& in, const NetSnapshot* base);
+};
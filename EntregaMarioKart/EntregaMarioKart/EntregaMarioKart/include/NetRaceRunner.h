@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file NetRaceRunner.h
+ * @brief Modos de línea de comandos de la carrera en red: servidor, cliente, pruebas en un proceso
+ *        (servidor autoritativo y rollback entre pares).
+ */
+
+#include "Prerequisites.h"
+#include "NetClient.h"
+#include "NetServer.h"
+#include "RollbackSession.h"
+
+#include <string>
+
+/**
+ * @class NetRaceRunner
+ * @brief Lanza un NetServer o un NetClient sobre UDP, o ambos sobre LoopbackNetwork.
+ *
+ * Los clientes no tienen ventana: un bot conduce su kart hacia la línea de carrera a
+ * partir del snapshot recibido, así que se ve el efecto real de la latencia en el mando.
+ * Al terminar imprime por cliente el tráfico (bytes por snapshot, kbit/s en cada sentido,
+ * fracción de deltas) y la latencia (RTT medio y máximo).
+ *
+ * En --net-test además se compara cada snapshot decodificado por los clientes con el que
+ * guardó el servidor para ese tick: deben ser idénticos bit a bit.
+ *
+ * --rollback-test corre N pares con RollbackSession sobre LoopbackNetwork, cada uno con su
+ * simulación y un bot que conduce sobre lo que predice. Al final todos deben coincidir con
+ * una simulación de referencia que aplica los mandos registrados sin red ni predicción.
+ *
+ * Uso: EntregaMarioKart --net-server [--port P] [--clients N] [--karts K] [--laps L]
+ *      [--snapshot-interval T]
+ *      EntregaMarioKart --net-client HOST [--port P]
+ *      EntregaMarioKart --net-test [--clients N] [--latency ms] [--jitter ms] [--loss %]
+ *      [--karts K] [--laps L] [--snapshot-interval T]
+ *      EntregaMarioKart --rollback-test [--clients N] [--latency ms] [--jitter ms] [--loss %]
+ *      [--input-delay T] [--max-rollback T] [--karts K] [--laps L] [--items]
+ */
+class NetRaceRunner {
+public:
+  /**
+   * @brief Qué se ejecuta.
+   */
+  enum class Mode {
+    None,
+    Server,    ///< Servidor UDP en tiempo real.
+    Client,    ///< Cliente UDP (bot) en tiempo real.
+    Loopback,  ///< Servidor y clientes en este proceso, red simulada, sin esperar al reloj.
+    Rollback   ///< Pares con rollback en este proceso, red simulada.
+  };
+
+  /**
+   * @brief Opciones de línea de comandos.
+   */
+  struct Config {
+    Mode           mode = Mode::None;
+    std::string    host = "127.0.0.1";
+    unsigned short port = 47017;
+    int            clients = 2;        ///< Servidor: clientes a esperar. Rollback: pares.
+    int            karts = 4;
+    int            laps = 3;
+    float          hz = 60.f;
+    int            snapshotInterval = 2;
+    float          latencyMs = 50.f;   ///< Prueba: retardo de un sentido.
+    float          jitterMs = 10.f;    ///< Prueba: retardo extra aleatorio.
+    float          lossPercent = 2.f;  ///< Prueba: datagramas perdidos.
+    float          maxSeconds = 300.f; ///< Límite de la carrera (s).
+    int            inputDelay = 2;     ///< Rollback: ticks de retardo del mando local.
+    int            maxRollback = 10;   ///< Rollback: ticks de predicción como máximo.
+    bool           items = false;      ///< Rollback: carrera con objetos (los bots los usan).
+  };
+
+  /**
+   * @brief Interpreta argv.
+   * @return true si se pidió algún modo de red.
+   */
+  static bool parseArgs(int argc, char* argv[], Config& out);
+
+  /**
+   * @brief Ejecuta el modo pedido.
+   * @return 0 si todo va bien; 1 si falló la red o (prueba) algún snapshot no coincide.
+   */
+  int run(const Config& config);
+
+private:
+  int runServer(const Config& config);
+  int runClient(const Config& config);
+  int runLoopback(const Config& config);
+  int runRollback(const Config& config);
+
+  /** @brief Resumen de un cliente visto desde el servidor. */
+  static void printServerStats(const NetServer& server, float seconds);
+
+  /** @brief Resumen visto desde un cliente. */
+  static void printClientStats(const NetClient& client, float seconds, const char* label);
+};
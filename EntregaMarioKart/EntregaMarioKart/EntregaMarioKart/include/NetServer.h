@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * @file NetServer.h
+ * @brief Servidor autoritativo de la carrera en red: simula, recibe mandos y envía snapshots.
+ */
+
+#include "Prerequisites.h"
+#include "NetProtocol.h"
+#include "NetTransport.h"
+#include "RaceSimulation.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class NetServer
+ * @brief Dueño de la única RaceSimulation que cuenta. Cada cliente conduce un kart
+ *        (RaceSimulation::setRemoteControl) y recibe el estado de todos.
+ *
+ * Cada snapshotInterval ticks se captura un NetSnapshot y se guarda en un historial
+ * circular. A cada cliente se le envía como delta contra el último snapshot que confirmó
+ * en sus mensajes de Input; si ese snapshot ya no está en el historial (o aún no confirmó
+ * ninguno), va completo. Las confirmaciones también dan el RTT de cada cliente.
+ */
+class NetServer {
+public:
+  /** @brief Snapshots guardados para servir de base (a 30 Hz, ~2 s). */
+  static constexpr std::size_t kHistorySize = 64;
+
+  /**
+   * @brief Configuración de la carrera y del envío.
+   */
+  struct Config {
+    int   karts = 4;
+    int   laps = 3;
+    float hz = 60.f;               ///< Ticks por segundo de la simulación.
+    int   snapshotInterval = 2;    ///< Ticks entre snapshots (2 = 30 Hz).
+    bool  collisions = true;
+  };
+
+  /**
+   * @brief Tráfico y latencia de un cliente.
+   */
+  struct ClientStats {
+    int           racer = -1;       ///< Kart que conduce.
+    std::uint64_t bytesIn = 0;      ///< Bytes de Input/Hello recibidos.
+    std::uint64_t bytesOut = 0;     ///< Bytes de Welcome/Snapshot enviados.
+    std::uint32_t packetsIn = 0;
+    std::uint32_t snapshots = 0;    ///< Snapshots enviados.
+    std::uint32_t deltas = 0;       ///< De ellos, codificados contra una base.
+    float         rttSum = 0.f;     ///< Suma de RTT medidos (s).
+    float         rttMax = 0.f;
+    std::uint32_t rttSamples = 0;
+
+    float getRttAverage() const { return rttSamples ? rttSum / static_cast<float>(rttSamples) : 0.f; }
+  };
+
+  /**
+   * @brief Prepara la carrera (en parrilla, aún sin avanzar) y escucha en @p transport.
+   *        @p transport debe vivir mientras se use el servidor.
+   */
+  void start(NetTransport& transport, const Config& config);
+
+  /**
+   * @brief Procesa los datagramas recibidos (altas y mandos).
+   * @param now Reloj del servidor (s), para el RTT.
+   */
+  void poll(float now);
+
+  /**
+   * @brief Avanza un tick y, si toca, envía un snapshot a cada cliente.
+   */
+  void step(float now);
+
+  /** @brief Clientes dados de alta. */
+  std::size_t getClientCount() const { return m_clients.size(); }
+
+  /** @brief Estadísticas del cliente @p idx (orden de alta). */
+  const ClientStats& getClientStats(std::size_t idx) const { return m_clients[idx].stats; }
+
+  /** @brief Snapshot del historial con ese tick (nulo si ya no está). */
+  const NetSnapshot* findSnapshot(std::uint32_t tick) const;
+
+  /** @brief Tick actual. */
+  std::uint32_t getTick() const { return m_tick; }
+
+  RaceSimulation& getSimulation() { return m_sim; }
+  const RaceSimulation& getSimulation() const { return m_sim; }
+
+private:
+  struct Client {
+    int           peer = -1;
+    std::uint32_t lastInputTick = 0;  ///< Último tick de Input aplicado (descarta desordenados).
+    std::uint32_t ackedSnapshot = 0;  ///< Último snapshot confirmado (0 = ninguno).
+    ClientStats   stats;
+  };
+
+  struct HistoryEntry {
+    NetSnapshot snapshot;
+    float       sentAt = 0.f;
+  };
+
+  /** @brief Da de alta (o re-saluda) al par @p peer. */
+  void handleHello(int peer, std::size_t bytes);
+
+  /** @brief Aplica los mandos de un cliente y su confirmación. */
+  void handleInput(Client& client, NetReader& in, float now);
+
+  /** @brief Captura el tick actual y lo envía a todos. */
+  void sendSnapshots(float now);
+
+  Client* findClient(int peer);
+
+  NetTransport*             m_transport = nullptr;
+  Config                    m_config;
+  RaceSimulation            m_sim;
+  std::vector<Client>       m_clients;
+  std::vector<HistoryEntry> m_history = std::vector<HistoryEntry>(kHistorySize);
+  std::uint32_t             m_tick = 0;
+  std::vector<std::uint8_t> m_packet;   ///< Datagrama reutilizado.
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * @file NetTransport.h
+ * @brief Envío de datagramas entre procesos (UDP) o dentro del mismo proceso (red simulada).
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class NetTransport
+ * @brief Datagramas no fiables y sin orden garantizado, dirigidos a pares numerados.
+ *
+ * El servidor y los clientes sólo ven esta interfaz, así que la misma lógica corre sobre
+ * UDP real o sobre LoopbackNetwork (latencia, jitter y pérdida reproducibles).
+ */
+class NetTransport {
+public:
+  virtual ~NetTransport() = default;
+
+  /**
+   * @brief Envía @p packet al par @p peer. Puede perderse o llegar desordenado.
+   */
+  virtual void send(int peer, const std::vector<std::uint8_t>& packet) = 0;
+
+  /**
+   * @brief Saca el siguiente datagrama recibido.
+   * @param peer Par que lo envió.
+   * @return false si no queda ninguno.
+   */
+  virtual bool receive(int& peer, std::vector<std::uint8_t>& packet) = 0;
+};
+
+class LoopbackTransport;
+
+/**
+ * @class LoopbackNetwork
+ * @brief Red en memoria con reloj propio: cada datagrama se entrega tras la latencia
+ *        (más jitter) del enlace, o se pierde con la probabilidad configurada.
+ *
+ * El azar sale de un generador con semilla, así que una prueba da siempre el mismo
+ * resultado. El tiempo sólo avanza con advance().
+ */
+class LoopbackNetwork {
+public:
+  /**
+   * @brief Condiciones del enlace (iguales en ambos sentidos).
+   */
+  struct Conditions {
+    float latency = 0.f;  ///< Retardo de un sentido (s).
+    float jitter = 0.f;   ///< Retardo extra aleatorio en [0, jitter] (s).
+    float loss = 0.f;     ///< Probabilidad de pérdida (0..1).
+  };
+
+  explicit LoopbackNetwork(std::uint32_t seed = 1) : m_rng(seed ? seed : 1) {}
+
+  /**
+   * @brief Crea un extremo nuevo; su número de par es el orden de creación (0, 1, ...).
+   *        Los extremos guardan un puntero a la red: no deben sobrevivirla.
+   */
+  EngineUtilities::TSharedPointer<LoopbackTransport> createEndpoint();
+
+  /** @brief Condiciones para los datagramas que se envíen a partir de ahora. */
+  void setConditions(const Conditions& conditions) { m_conditions = conditions; }
+
+  /** @brief Avanza el reloj de la red. */
+  void advance(float dt) { m_time += dt; }
+
+  /** @brief Reloj de la red (s). */
+  float getTime() const { return m_time; }
+
+  /** @brief Datagramas perdidos a propósito. */
+  std::uint64_t getDropped() const { return m_dropped; }
+
+private:
+  friend class LoopbackTransport;
+
+  struct Datagram {
+    float         deliverAt = 0.f;
+    std::uint64_t order = 0;      ///< Desempate estable entre entregas simultáneas.
+    int           from = 0;
+    int           to = 0;
+    std::vector<std::uint8_t> data;
+  };
+
+  void post(int from, int to, const std::vector<std::uint8_t>& data);
+  bool take(int to, int& from, std::vector<std::uint8_t>& data);
+  float random01();
+
+  Conditions            m_conditions;
+  std::vector<Datagram> m_inFlight;
+  float                 m_time = 0.f;
+  std::uint32_t         m_rng;
+  std::uint64_t         m_sent = 0;
+  std::uint64_t         m_dropped = 0;
+  int                   m_endpoints = 0;
+};
+
+/**
+ * @class LoopbackTransport
+ * @brief Extremo de una LoopbackNetwork.
+ */
+class LoopbackTransport : public NetTransport {
+public:
+  LoopbackTransport(LoopbackNetwork& network, int id) : m_network(network), m_id(id) {}
+
+  void send(int peer, const std::vector<std::uint8_t>& packet) override { m_network.post(m_id, peer, packet); }
+  bool receive(int& peer, std::vector<std::uint8_t>& packet) override { return m_network.take(m_id, peer, packet); }
+
+  /** @brief Número de par de este extremo. */
+  int getId() const { return m_id; }
+
+private:
+  LoopbackNetwork& m_network;
+  int              m_id;
+};
+
+/**
+ * @class UdpTransport
+ * @brief Datagramas UDP con sf::UdpSocket no bloqueante. Los pares se numeran en el
+ *        orden en que se añaden o en que llega su primer datagrama.
+ */
+class UdpTransport : public NetTransport {
+public:
+  /**
+   * @brief Abre el socket en @p port (0 = cualquiera libre).
+   */
+  bool bind(unsigned short port);
+
+  /**
+   * @brief Registra un par conocido (el servidor, en un cliente).
+   * @return Número de par.
+   */
+  int addPeer(const sf::IpAddress& address, unsigned short port);
+
+  void send(int peer, const std::vector<std::uint8_t>& packet) override;
+  bool receive(int& peer, std::vector<std::uint8_t>& packet) override;
+
+private:
+  struct Peer {
+    sf::IpAddress  address = sf::IpAddress::LocalHost;
+    unsigned short port = 0;
+  };
+
+  sf::UdpSocket             m_socket;
+  std::vector<Peer>         m_peers;
+  std::vector<std::uint8_t> m_buffer = std::vector<std::uint8_t>(sf::UdpSocket::MaxDatagramSize);
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+ * @file ParticleSystem.h
+ * @brief Partículas (chispas, polvo, humo) en anillos SoA y un sf::VertexArray por lote.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class Window;
+
+/**
+ * @class ParticleSystem
+ * @brief Todas las partículas de la escena, agrupadas en lotes de misma textura y mezcla.
+ *
+ * Cada lote guarda sus partículas en arrays paralelos (posición, velocidad, edad, vida,
+ * tamaño, color) usados como anillo de capacidad fija: emitir escribe en la cabeza y, con el
+ * anillo lleno, pisa la partícula más antigua (getStats().overwritten). update() recorre los
+ * arrays en uno o dos tramos contiguos con bucles sin saltos ni llamadas, que el compilador
+ * vectoriza, y después retira por la cola las que han caducado.
+ *
+ * render() rellena un sf::VertexArray de triángulos por lote (seis vértices por partícula,
+ * reutilizando la memoria del frame anterior) y hace una sola llamada de dibujo por lote.
+ * Con setCullRect() sólo se generan vértices para las partículas que tocan el rectángulo;
+ * las de fuera se siguen simulando.
+ * Durante la partida no se reserva memoria: todo se dimensiona en addBatch().
+ */
+class ParticleSystem {
+public:
+  /**
+   * @brief Una partícula nueva.
+   */
+  struct Spawn {
+    sf::Vector2f position{ 0.f, 0.f };
+    sf::Vector2f velocity{ 0.f, 0.f };  ///< px/s.
+    float        life = 0.5f;           ///< s.
+    float        size = 2.f;            ///< Media anchura del cuadrado al nacer (px).
+    float        growth = 0.f;          ///< px/s que crece la media anchura.
+    sf::Color    color = sf::Color::White; ///< El alfa se desvanece hasta 0 al final de la vida.
+  };
+
+  /**
+   * @brief Contadores del último update() y render().
+   */
+  struct Stats {
+    std::size_t   live = 0;            ///< Partículas en los anillos (vivas o por retirar).
+    std::size_t   quads = 0;           ///< Partículas dibujadas.
+    std::size_t   drawCalls = 0;       ///< Lotes no vacíos dibujados.
+    std::size_t   culled = 0;          ///< Vivas sin dibujar por estar fuera de setCullRect().
+    std::uint64_t overwritten = 0;     ///< Partículas pisadas con el anillo lleno (acumulado).
+    double        updateSeconds = 0.0;
+    double        buildSeconds = 0.0;  ///< Relleno de los vertex arrays.
+  };
+
+  /**
+   * @brief Crea un lote. Las partículas de un lote se dibujan juntas, en orden de emisión.
+   * @param texture Textura de cada partícula (nullptr = cuadrado de color). Debe vivir más que el sistema.
+   * @param capacity Partículas como máximo (memoria reservada aquí, una sola vez).
+   * @param drag Frenado de la velocidad (1/s).
+   * @return Índice del lote para emit().
+   */
+  std::size_t addBatch(const sf::Texture* texture, const sf::BlendMode& blend, std::size_t capacity,
+                       float drag = 0.f);
+
+  /** @brief Lotes creados. */
+  std::size_t getBatchCount() const { return m_batches.size(); }
+
+  /** @brief Añade una partícula al lote @p batch. */
+  void emit(std::size_t batch, const Spawn& spawn);
+
+  /** @brief Mueve, envejece y retira las partículas de todos los lotes. */
+  void update(float dt);
+
+  /** @brief buildVertices() omite las partículas que no tocan @p rect (coordenadas de mundo). */
+  void setCullRect(const sf::FloatRect& rect) { m_cullRect = rect; }
+
+  /** @brief Vuelve a generar vértices para todas las partículas. */
+  void clearCullRect() { m_cullRect.reset(); }
+
+  /** @brief Rellena los vertex arrays de todos los lotes (render() lo hace antes de dibujar). */
+  void buildVertices();
+
+  /** @brief buildVertices() y una llamada de dibujo por lote no vacío. */
+  void render(const EngineUtilities::TSharedPointer<Window>& window);
+
+  /** @brief Vacía todos los lotes (conserva la memoria). */
+  void clear();
+
+  const Stats& getStats() const { return m_stats; }
+
+private:
+  /**
+   * @brief Anillo SoA de un lote y su geometría.
+   */
+  struct Batch {
+    const sf::Texture* texture = nullptr;
+    sf::BlendMode      blend = sf::BlendAlpha;
+    float              drag = 0.f;
+    std::size_t        capacity = 0;
+    std::size_t        head = 0;     ///< Siguiente hueco a escribir.
+    std::size_t        count = 0;    ///< Ocupados, terminando en head (la cola es la más antigua).
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> age, life, size, growth;
+    std::vector<sf::Color> color;
+    sf::VertexArray    vertices{ sf::PrimitiveType::Triangles };
+  };
+
+  std::vector<Batch> m_batches;
+  Stats              m_stats;
+  std::optional<sf::FloatRect> m_cullRect;
+};
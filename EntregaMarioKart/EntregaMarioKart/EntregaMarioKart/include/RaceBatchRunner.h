@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file RaceBatchRunner.h
+ * @brief Lotes Monte Carlo de carreras headless en paralelo para ajustar parámetros de los corredores.
+ */
+
+#include "Prerequisites.h"
+#include "RaceSimulation.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class RaceBatchRunner
+ * @brief Barre combinaciones de maxSpeed / lookaheadDistance / arriveRadius de un corredor,
+ *        simula N carreras por combinación repartidas entre todos los núcleos y escribe un CSV.
+ *
+ * Cada carrera usa RaceSimulation (el mismo código que el juego) con una semilla propia
+ * que decide el orden de parrilla y una pequeña variación de velocidad por corredor.
+ * La semilla depende sólo del índice de la carrera, así que el resultado es idéntico
+ * con 1 o con 32 hilos.
+ *
+ * Uso: EntregaMarioKart --batch [--races N] [--laps L] [--threads T] [--seed S]
+ *      [--jitter J] [--no-shuffle] [--tune NOMBRE] [--speeds a,b,..] [--lookaheads a,b,..]
+ *      [--arrive a,b,..] [--csv ruta]
+ */
+class RaceBatchRunner {
+public:
+  /**
+   * @brief Configuración del lote.
+   */
+  struct Config {
+    int           racesPerCombo = 200;   ///< Carreras por combinación de parámetros.
+    int           laps = 3;              ///< Vueltas por carrera.
+    float         hz = 60.f;             ///< Frecuencia de simulación.
+    float         maxRaceSeconds = 600.f;///< Límite por carrera (DNF).
+    int           threads = 0;           ///< 0 = std::thread::hardware_concurrency().
+    std::uint32_t seed = 12345;          ///< Semilla base.
+    float         speedJitter = 0.03f;   ///< Variación aleatoria de maxSpeed (+-3 %).
+    bool          shuffleGrid = true;    ///< Sortear el orden de parrilla en cada carrera.
+    std::string   tunedRacer = "princesa"; ///< Corredor cuyos parámetros se barren.
+    std::vector<float> speeds;           ///< Valores de maxSpeed (vacío = el de por defecto).
+    std::vector<float> lookaheads;       ///< Valores de lookaheadDistance (vacío = por defecto).
+    std::vector<float> arriveRadii;      ///< Valores de arriveRadius (vacío = por defecto).
+    std::string   csvPath = "race_batch.csv"; ///< Salida CSV.
+  };
+
+  /**
+   * @brief Interpreta argv.
+   * @return true si se pidió el modo lote (--batch).
+   */
+  static bool parseArgs(int argc, char* argv[], Config& out);
+
+  /**
+   * @brief Ejecuta el lote completo, imprime un resumen y escribe el CSV.
+   * @return 0 si todo va bien, 1 si no se pudo escribir el CSV.
+   */
+  int run(const Config& config);
+
+private:
+  /**
+   * @brief Parámetros del corredor ajustado en una combinación del barrido.
+   */
+  struct Combo {
+    float maxSpeed = 0.f;
+    float lookahead = 0.f;
+    float arriveRadius = 0.f;
+  };
+
+  /**
+   * @brief Resultado compacto de una carrera (por índice de corredor en la parrilla por defecto).
+   */
+  struct RaceResult {
+    std::vector<std::uint8_t> places;    ///< 0 = DNF, 1..N.
+    std::vector<float>        finishTimes;
+    std::vector<float>        lapTimes;  ///< racers * laps; <0 = vuelta no completada.
+  };
+
+  /**
+   * @brief Estado propio de cada hilo: su simulación y sus corredores (nada compartido).
+   */
+  struct Worker {
+    RaceSimulation sim;
+    std::vector<EngineUtilities::TSharedPointer<A_Racer>> roster; ///< Orden de la parrilla por defecto.
+  };
+
+  /**
+   * @brief Simula una carrera de la combinación @p combo con la semilla @p seed.
+   * @param worker Simulación y corredores del hilo (se reutilizan entre carreras).
+   */
+  void simulate(Worker& worker, const Combo& combo, std::uint32_t seed, RaceResult& out) const;
+
+  /**
+   * @brief Agrega los resultados y escribe el CSV (una fila por combinación y corredor).
+   */
+  bool writeCsv(const std::vector<Combo>& combos, const std::vector<RaceResult>& results) const;
+
+  Config m_config;
+  std::vector<std::string> m_names;     ///< Nombres en el orden de la parrilla por defecto.
+  std::vector<float>       m_baseSpeeds;
+  std::vector<float>       m_baseLookaheads;
+  std::vector<float>       m_baseArriveRadii;
+  int                      m_tunedIdx = 0;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file RaceRanking.h
+ * @brief Clasificación en vivo mantenida de forma incremental (la comparten HUD, IA y resultados).
+ */
+
+#include "Prerequisites.h"
+#include "A_Racer.h"
+#include "StateBuffer.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class RaceRanking
+ * @brief Orden de carrera actualizado por inserción: entre ticks casi nunca cambia,
+ *        así que cada update() cuesta O(n) más un intercambio por adelantamiento.
+ *
+ * Los que han terminado van delante en orden de llegada y ya no se mueven; el resto
+ * se ordena por A_Racer::getRaceProgress(). Si dos terminan en el mismo tick llega
+ * antes el que iba delante en la clasificación anterior.
+ */
+class RaceRanking {
+public:
+  RaceRanking() = default;
+
+  /**
+   * @brief Empieza una clasificación nueva con el orden de parrilla.
+   * @param racers Corredores (el índice en este vector es su id).
+   */
+  void reset(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers);
+
+  /**
+   * @brief Recalcula progresos, reordena y detecta llegadas. Llamar una vez por tick.
+   * @return Número de corredores que han terminado en este tick.
+   */
+  std::size_t update();
+
+  /**
+   * @brief Orden, llegadas y claves (los corredores los aporta reset()).
+   */
+  void saveState(StateWriter& out) const;
+
+  /** @brief Restaura lo guardado con saveState() sobre los mismos corredores. */
+  void loadState(StateReader& in);
+
+  /** @brief Ids de corredor de primero a último. */
+  const std::vector<std::uint32_t>& getOrder() const { return m_order; }
+
+  /** @brief Ids en orden de llegada (sólo los que han terminado). */
+  const std::vector<std::uint32_t>& getFinishOrder() const { return m_finishOrder; }
+
+  /**
+   * @brief Los ids que han llegado en el último update() (al final de getFinishOrder()).
+   */
+  std::size_t getNewFinishers() const { return m_newFinishers; }
+
+  /** @brief Posición actual (1..N) del corredor @p id; 0 si no existe. */
+  int getPosition(std::size_t id) const { return id < m_positions.size() ? m_positions[id] : 0; }
+
+  /** @brief Número de corredores clasificados. */
+  std::size_t size() const { return m_order.size(); }
+
+  /** @brief Número de corredores que han terminado. */
+  std::size_t getFinishedCount() const { return m_finishOrder.size(); }
+
+  /** @brief Intercambios hechos en el último update() (adelantamientos detectados). */
+  std::size_t getLastSwaps() const { return m_lastSwaps; }
+
+private:
+  std::vector<EngineUtilities::TSharedPointer<A_Racer>> m_racers;
+  std::vector<std::uint32_t> m_order;       ///< Ids por posición.
+  std::vector<std::uint32_t> m_finishOrder; ///< Ids por orden de llegada.
+  std::vector<int>           m_positions;   ///< Posición por id (1..N).
+  std::vector<float>         m_keys;        ///< Clave de orden por id (mayor = delante).
+  std::vector<std::uint8_t>  m_finished;    ///< 1 si el id ya está en m_finishOrder.
+  std::size_t                m_newFinishers = 0;
+  std::size_t                m_lastSwaps = 0;
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+/**
+ * @file RaceReplay.h
+ * @brief Grabación y reproducción determinista de carreras a partir de la entrada por tick.
+ */
+
+#include "Prerequisites.h"
+#include "RaceSimulation.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class RaceReplay
+ * @brief Guarda la configuración de la carrera y la entrada del jugador de cada tick;
+ *        para reproducir se vuelve a simular desde la parrilla con las mismas entradas.
+ *
+ * RaceSimulation no tiene azar: con la misma configuración, el mismo dt y las mismas
+ * entradas produce la misma carrera. No se guarda estado por frame, sólo los cambios de
+ * entrada: cada registro lleva qué campos cambian (delta en zigzag + varint) y cuántos
+ * ticks dura (varint), así que una carrera con teclado ocupa unos pocos KB.
+ * Cada kChecksumInterval ticks se guarda RaceSimulation::checksum() para detectar en qué
+ * tick se separa una reproducción (regresiones, bugs de determinismo).
+ */
+class RaceReplay {
+public:
+  /** @brief Ticks entre huellas de estado. */
+  static constexpr std::uint32_t kChecksumInterval = 60;
+
+  /**
+   * @brief Configuración de la carrera grabada (parrilla por defecto).
+   */
+  struct Setup {
+    std::uint16_t karts = 4;
+    std::uint8_t  laps = 3;
+    std::uint8_t  sectors = 3;
+    std::uint8_t  collisions = 1;
+    std::uint8_t  imageSurface = 0;  ///< 1 = superficie de la imagen de la pista (como BaseApp).
+    std::uint8_t  racingLine = 0;    ///< 1 = IA con la trazada optimizada de la pista.
+    std::uint8_t  kartPhysics = 0;   ///< 1 = IA conducida con KartPhysics.
+    std::uint8_t  items = 0;         ///< 1 = carrera con objetos.
+    float         hz = 60.f;         ///< Frecuencia de simulación.
+  };
+
+  /**
+   * @brief Configuración actual de @p sim.
+   * @param hz Frecuencia a la que se va a simular.
+   * @param imageSurface true si la superficie viene de la imagen de la pista.
+   */
+  static Setup capture(const RaceSimulation& sim, float hz, bool imageSurface);
+
+  /**
+   * @brief Prepara @p sim con la configuración grabada y la deja en parrilla.
+   * @return false si falta la superficie de imagen o la trazada grabadas (la reproducción divergirá).
+   */
+  bool apply(RaceSimulation& sim) const;
+
+  /**
+   * @brief Empieza una grabación nueva (descarta la anterior).
+   */
+  void begin(const Setup& setup);
+
+  /**
+   * @brief Graba la entrada vigente de @p sim y avanza un tick. La entrada se cuantiza
+   *        antes del tick, así que la carrera en vivo ya usa exactamente lo grabado.
+   */
+  void recordStep(RaceSimulation& sim, float dt);
+
+  /**
+   * @brief Vuelve al primer tick para reproducir.
+   */
+  void rewind();
+
+  /**
+   * @brief Aplica la entrada del siguiente tick grabado, avanza @p sim y comprueba la huella.
+   * @return false si ya no quedan ticks.
+   */
+  bool playStep(RaceSimulation& sim, float dt);
+
+  /**
+   * @brief Guarda en disco (cierra antes el registro en curso).
+   */
+  bool save(const std::string& path);
+
+  /**
+   * @brief Carga una grabación y la deja lista para reproducir.
+   */
+  bool load(const std::string& path);
+
+  /** @brief Configuración grabada. */
+  const Setup& getSetup() const { return m_setup; }
+
+  /** @brief Ticks grabados. */
+  std::uint32_t getTickCount() const { return m_tickCount; }
+
+  /** @brief Ticks reproducidos desde rewind(). */
+  std::uint32_t getPlayedTicks() const { return m_played; }
+
+  /** @brief Huellas grabadas. */
+  std::size_t getChecksumCount() const { return m_checksums.size(); }
+
+  /** @brief Bytes de entradas + huellas. */
+  std::size_t getByteSize() const { return m_stream.size() + m_checksums.size() * sizeof(std::uint32_t); }
+
+  /** @brief Primer tick cuya huella no coincide (0 = ninguno). */
+  std::uint32_t getDesyncTick() const { return m_desyncTick; }
+
+private:
+  /**
+   * @brief Entrada de un tick cuantizada (-127..127).
+   */
+  struct Frame {
+    std::int8_t player = -1;
+    std::int8_t throttle = 0;
+    std::int8_t steer = 0;
+    std::int8_t drift = 0;  ///< 0 / 1.
+    std::int8_t item = 0;   ///< 0 / 1 (botón de usar objeto).
+
+    bool operator==(const Frame& other) const {
+      return player == other.player && throttle == other.throttle && steer == other.steer
+        && drift == other.drift && item == other.item;
+    }
+  };
+
+  /** @brief Escribe el registro pendiente (m_pending durante m_run ticks). */
+  void flush();
+
+  /** @brief Lee el siguiente registro del flujo. */
+  bool decode();
+
+  Setup                      m_setup;
+  std::vector<std::uint8_t>  m_stream;     ///< Registros de cambios de entrada.
+  std::vector<std::uint32_t> m_checksums;  ///< Una huella cada kChecksumInterval ticks.
+  std::uint32_t              m_tickCount = 0;
+
+  // --- Grabación ---
+  Frame         m_written;                 ///< Último frame escrito (base de los deltas).
+  Frame         m_pending;                 ///< Frame que se repite desde el último registro.
+  std::uint32_t m_run = 0;                 ///< Ticks de m_pending aún sin escribir.
+
+  // --- Reproducción ---
+  std::size_t   m_cursor = 0;              ///< Byte de lectura en m_stream.
+  Frame         m_decoded;                 ///< Frame del registro en curso.
+  std::uint32_t m_left = 0;                ///< Ticks que quedan del registro en curso.
+  std::uint32_t m_played = 0;
+  std::uint32_t m_desyncTick = 0;
+};
@@ -0,0 +1,372 @@
+#pragma once
+
+/**
+ * @file RaceSimulation.h
+ * @brief Estado y lógica de una carrera, sin ventana ni GUI (la usan BaseApp y el modo headless).
+ */
+
+#include "Prerequisites.h"
+#include "A_Racer.h"
+#include "ECS/KartPhysics.h"
+#include "ItemSystem.h"
+#include "LapTimer.h"
+#include "RaceRanking.h"
+#include "RacingLine.h"
+#include "RacingSpline.h"
+#include "SpatialGrid.h"
+#include "StateBuffer.h"
+#include "TrackSurface.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @class RaceSimulation
+ * @brief Corredores, pista, vueltas, podio y kart del jugador avanzados por ticks fijos.
+ *
+ * No conoce Window, EngineGUI ni texturas: BaseApp la dibuja y el modo headless
+ * la ejecuta tan rápido como permite la CPU con exactamente el mismo código.
+ */
+class RaceSimulation {
+public:
+  /**
+   * @brief Entrada del jugador para un tick (ya muestreada del teclado o de una repetición).
+   */
+  struct PlayerInput {
+    float throttle = 0.f; ///< -1 (freno/atrás) .. 1 (acelerar).
+    float steer = 0.f;    ///< -1 (izquierda) .. 1 (derecha).
+    bool  drift = false;  ///< Botón de derrape.
+    bool  useItem = false; ///< Usar el objeto en mano (con objetos activados).
+  };
+
+  RaceSimulation() = default;
+
+  /**
+   * @brief Crea la parrilla por defecto (princesa, sonic, virdo, wario) y la pista por defecto.
+   * @param racerCount Karts en pista; por encima de 4 se repiten los personajes (pruebas de carga).
+   */
+  void setupDefaultRace(std::size_t racerCount = 4);
+
+  /**
+   * @brief Añade un corredor a la parrilla (el orden define el carril de salida).
+   */
+  void addRacer(const EngineUtilities::TSharedPointer<A_Racer>& racer);
+
+  /**
+   * @brief Quita todos los corredores.
+   */
+  void clearRacers();
+
+  /**
+   * @brief Define el recorrido; se aplica en el siguiente reset(). La meta es el
+   *        inicio de la línea de carrera (primer waypoint).
+   * @param path Waypoints del circuito cerrado.
+   */
+  void setTrack(const std::vector<sf::Vector2f>& path);
+
+  /**
+   * @brief Sectores por vuelta (puertas de LapTimer); se aplica en el siguiente reset().
+   */
+  void setSectorCount(int sectors) { m_sectorCount = sectors; }
+
+  /** @brief Sectores por vuelta configurados. */
+  int getSectorCount() const { return m_sectorCount; }
+
+  /**
+   * @brief Usa un mapa de superficie ya construido (p. ej. desde la imagen de la pista).
+   *        Si no se asigna ninguno, reset() genera uno a partir de la línea de carrera.
+   */
+  void setSurface(const EngineUtilities::TSharedPointer<TrackSurface>& surface);
+
+  /**
+   * @brief Superficie a partir de la imagen de la pista por defecto (bin/pista de carreras.png,
+   *        con caché en disco). Sólo se aplica si cubre la línea de carrera; requiere reset() previo.
+   * @return true si se aplicó; si no, se queda la calzada generada desde la línea.
+   */
+  bool loadDefaultTrackSurface();
+
+  /**
+   * @brief Trazada optimizada para la IA (nula = cada kart por su carril); se aplica en reset().
+   */
+  void setRacingLine(const EngineUtilities::TSharedPointer<RacingLine>& line) { m_racingLine = line; }
+
+  /**
+   * @brief Carga la trazada de la pista por defecto (bin/pista de carreras.line, generada con
+   *        --optimize-line) si corresponde a la línea actual. Requiere reset() previo.
+   * @return true si se cargó; se aplica en el siguiente reset().
+   */
+  bool loadDefaultRacingLine();
+
+  /**
+   * @brief IA con física de kart (KartPhysics) en vez de desplazamiento directo; se aplica en reset().
+   */
+  void setKartPhysicsAI(bool enabled) { m_kartPhysicsAI = enabled; }
+
+  /** @brief true si la IA conduce con KartPhysics. */
+  bool isKartPhysicsAI() const { return m_kartPhysicsAI; }
+
+  /** @brief Parámetros del kart del jugador (modificables desde la GUI). */
+  KartPhysics::Params& getPlayerKart() { return m_playerKart; }
+
+  /** @brief Trazada optimizada (nula si no hay). */
+  const EngineUtilities::TSharedPointer<RacingLine>& getRacingLine() const { return m_racingLine; }
+
+  /** @brief Mapa de superficie actual (nulo antes del primer reset()). */
+  const EngineUtilities::TSharedPointer<TrackSurface>& getSurface() const { return m_surface; }
+
+  /**
+   * @brief Fija el número de vueltas de la carrera (se aplica en reset()).
+   */
+  void setTotalLaps(int laps) { m_totalLaps = laps; }
+
+  /** @brief Número de vueltas configurado. */
+  int getTotalLaps() const { return m_totalLaps; }
+
+  /**
+   * @brief Reconstruye la línea de carrera, coloca a los corredores en parrilla y
+   *        reinicia vueltas, podio y cronómetro.
+   */
+  void reset();
+
+  /**
+   * @brief Avanza la carrera un tick de duración fija.
+   * @param dt Duración del tick en segundos.
+   */
+  void step(float dt);
+
+  /**
+   * @brief Selecciona el corredor controlado por el jugador (-1 = todos IA).
+   */
+  void setPlayer(int idx);
+
+  /** @brief Índice del corredor del jugador (-1 = ninguno). */
+  int getPlayer() const { return m_playerIdx; }
+
+  /**
+   * @brief Entrada del jugador que se aplicará en los siguientes ticks.
+   */
+  void setPlayerInput(const PlayerInput& input) { m_playerInput = input; }
+
+  /** @brief Entrada del jugador vigente. */
+  const PlayerInput& getPlayerInput() const { return m_playerInput; }
+
+  /**
+   * @brief Pone un corredor bajo control externo (jugador en red) o lo devuelve a la IA.
+   *        Convive con el jugador local; cada kart conduce con su propia entrada.
+   */
+  void setRemoteControl(int idx, bool remote);
+
+  /**
+   * @brief Entrada de un corredor controlado (local o remoto); se mantiene hasta la siguiente.
+   */
+  void setRacerInput(int idx, const PlayerInput& input);
+
+  /**
+   * @brief Huella del estado de la carrera (tiempo, posiciones, vueltas y karts con física).
+   *        Dos simulaciones con la misma salida y las mismas entradas dan la misma huella.
+   */
+  std::uint32_t checksum() const;
+
+  /**
+   * @brief Copia en @p out todo lo que step() puede cambiar: corredores (transform, progreso,
+   *        física), vueltas, clasificación, rejilla, tiempo y entradas de los karts controlados.
+   *
+   * Con @p out ya dimensionado por un guardado anterior no se reserva memoria; con 4 karts
+   * son algo más de 1 KB y se copian en menos de un microsegundo. La pista, la línea de carrera y
+   * los parámetros no forman parte del estado: sólo se puede restaurar sobre la misma
+   * parrilla y el mismo reset().
+   */
+  void saveState(std::vector<std::uint8_t>& out) const;
+
+  /**
+   * @brief Restaura un estado de saveState(). Tras restaurar, step() con las mismas entradas
+   *        da exactamente los mismos ticks que la primera vez.
+   * @return false (sin cambios garantizados) si el buffer no es de esta parrilla.
+   */
+  bool loadState(const std::vector<std::uint8_t>& in);
+
+  /** @brief true cuando todos los corredores han terminado. */
+  bool isRaceOver() const;
+
+  /** @brief Tiempo simulado desde la salida (se detiene al terminar la carrera). */
+  float getRaceTime() const { return m_raceTime; }
+
+  /**
+   * @brief Tiempo de llegada del corredor @p idx (negativo si no ha terminado).
+   *        Interpolado dentro del tick en que cruzó la meta.
+   */
+  float getFinishTime(std::size_t idx) const;
+
+  /** @brief Corredores en orden de parrilla. */
+  const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& getRacers() const { return m_racers; }
+
+  /**
+   * @brief Clasificación en vivo y orden de llegada (ids = índices de getRacers()).
+   */
+  const RaceRanking& getRanking() const { return m_ranking; }
+
+  /**
+   * @brief Vueltas, parciales y mejores tiempos (registros por índice de parrilla).
+   */
+  const LapTimer& getLapTimer() const { return m_lapTimer; }
+
+  /**
+   * @brief Broadphase de corredores (id = índice de parrilla), actualizada al final de cada step().
+   */
+  const SpatialGrid& getGrid() const { return m_grid; }
+
+  /** @brief Radio de colisión de un kart (px). */
+  float getRacerRadius() const { return m_racerRadius; }
+
+  /**
+   * @brief Activa o desactiva choques y evitación entre karts.
+   */
+  void setCollisionsEnabled(bool enabled) { m_collisionsEnabled = enabled; }
+
+  /** @brief true si los karts chocan y se esquivan. */
+  bool areCollisionsEnabled() const { return m_collisionsEnabled; }
+
+  /**
+   * @brief Activa cajas, objetos y proyectiles (desactivados por defecto: la carrera
+   *        sin objetos no cambia). Se aplica en el siguiente reset().
+   */
+  void setItemsEnabled(bool enabled) { m_itemsEnabled = enabled; }
+
+  /** @brief true si hay objetos en la carrera. */
+  bool areItemsEnabled() const { return m_itemsEnabled; }
+
+  /** @brief Cajas, objetos en mano y proyectiles (vacío sin objetos). */
+  const ItemSystem& getItems() const { return m_items; }
+
+  /** @brief Ajustes de los objetos (se aplican en el siguiente reset()). */
+  ItemSystem::Params& getItemParams() { return m_items.getParams(); }
+
+  /**
+   * @brief Máximo de corredores IA cuya evitación se recalcula por tick (el resto conserva la anterior).
+   */
+  void setAvoidanceBudget(std::size_t racersPerTick) { m_avoidBudget = racersPerTick; }
+
+  /** @brief Contactos kart-kart resueltos en el último tick. */
+  std::size_t getContactCount() const { return m_contactCount; }
+
+  /** @brief Recorrido actual (waypoints). */
+  const std::vector<sf::Vector2f>& getPath() const { return m_path; }
+
+  /** @brief Línea de carrera compartida (nula antes del primer reset()). */
+  const EngineUtilities::TSharedPointer<RacingSpline>& getSpline() const { return m_spline; }
+
+  /**
+   * @brief Nombres de los personajes de la parrilla por defecto (también son los nombres de textura).
+   */
+  static const std::vector<std::string>& defaultCharacters();
+
+private:
+  /**
+   * @brief Karts conducidos a mano (jugador local y remotos): integra su KartPhysics.
+   */
+  void updatePlayer(float dt);
+
+  /**
+   * @brief Integra el kart @p idx con @p input.
+   */
+  void driveKart(int idx, const PlayerInput& input, float dt);
+
+  /**
+   * @brief Vuelca la posición de cada corredor en m_grid (incremental).
+   *        Los que ya terminaron salen de la rejilla: no chocan ni estorban.
+   */
+  void updateGrid();
+
+  /**
+   * @brief Lee la superficie bajo cada kart IA: frenado fuera de pista y modo recuperación.
+   */
+  void applySurface();
+
+  /**
+   * @brief Devuelve al borde del muro a los karts que lo atraviesan y anula su velocidad hacia fuera.
+   */
+  void enforceWalls(float dt);
+
+  /**
+   * @brief Separación / adelantamiento de la IA: calcula el desvío lateral y el
+   *        factor de velocidad de hasta m_avoidBudget corredores (round-robin).
+   */
+  void updateAvoidance();
+
+  /**
+   * @brief Choques círculo-círculo: corrección de posición e impulso con restitución.
+   */
+  void resolveCollisions(float dt);
+
+  /**
+   * @brief Deja en m_neighbors sólo los m_maxNeighbors más cercanos a @p center.
+   */
+  void keepNearestNeighbors(const sf::Vector2f& center);
+
+  /**
+   * @brief Velocidad del corredor @p idx en el tick actual (px/s).
+   */
+  sf::Vector2f racerVelocity(std::size_t idx, float dt) const;
+
+  /**
+   * @brief Aplica un cambio de velocidad por choque al corredor @p idx.
+   */
+  void applyImpulse(std::size_t idx, const sf::Vector2f& deltaVelocity);
+
+  // --- Parrilla ---
+  std::vector<EngineUtilities::TSharedPointer<A_Racer>> m_racers;
+  RaceRanking               m_ranking;               ///< Posiciones en vivo y orden de llegada.
+  LapTimer                  m_lapTimer;              ///< Puertas de sector y cronometraje.
+  std::vector<float>        m_finishTimes;           ///< Por índice de parrilla; <0 = en carrera.
+
+  // --- Pista ---
+  std::vector<sf::Vector2f> m_path;
+  EngineUtilities::TSharedPointer<RacingSpline> m_spline; ///< Línea compartida por todos los corredores.
+  EngineUtilities::TSharedPointer<TrackSurface> m_surface; ///< Asfalto / fuera de pista / muro.
+  EngineUtilities::TSharedPointer<RacingLine> m_racingLine; ///< Trazada y velocidades de la IA (opcional).
+  bool                      m_kartPhysicsAI = false; ///< IA integrada con KartPhysics.
+  bool                      m_surfaceFromSpline = false; ///< true = generada aquí; se rehace con la pista.
+  float                     m_roadHalfWidth = 70.f; ///< Media anchura del asfalto generado (px).
+  float                     m_offroadSpeedScale = 0.55f; ///< Velocidad máxima relativa fuera de pista.
+  int                       m_totalLaps = 3;
+  int                       m_sectorCount = 3;      ///< Sectores por vuelta (puertas de control).
+  float                     m_laneSpacing = 18.f;   ///< Separación lateral entre carriles (px).
+  float                     m_rowSpacing = 40.f;    ///< Separación entre filas de la parrilla (px).
+  std::size_t               m_gridColumns = 4;      ///< Karts por fila (se amplía si no caben).
+  std::size_t               m_maxGridColumns = 6;   ///< Karts por fila como máximo (ancho de la meta).
+  float                     m_raceTime = 0.f;       ///< Tiempo simulado de carrera (s).
+
+  // --- Proximidad ---
+  SpatialGrid               m_grid{ 64.f };          ///< Celda ~ 4 radios de kart.
+  float                     m_racerRadius = 16.f;   ///< Radio de colisión del kart (px).
+  std::vector<std::uint32_t> m_neighbors;            ///< Resultado reutilizado de las consultas.
+
+  // --- Choques y evitación ---
+  bool                      m_collisionsEnabled = true;
+  float                     m_restitution = 0.3f;   ///< 0 = choque plástico, 1 = elástico.
+  float                     m_avoidRange = 90.f;    ///< Distancia a la que la IA empieza a esquivar (px).
+  float                     m_avoidMargin = 6.f;    ///< Hueco lateral extra al adelantar (px).
+  float                     m_maxAvoidOffset = 40.f;///< Desvío máximo sobre el carril (px).
+  std::size_t               m_maxNeighbors = 8;     ///< Vecinos considerados por kart (acota el coste).
+  std::size_t               m_avoidBudget = 256;    ///< Corredores con evitación recalculada por tick.
+  std::size_t               m_avoidCursor = 0;      ///< Siguiente corredor del round-robin.
+  std::size_t               m_contactCount = 0;
+
+  // --- Objetos ---
+  bool                      m_itemsEnabled = false;
+  ItemSystem                m_items;                 ///< Pool de proyectiles reservado una vez.
+
+  // --- Jugador ---
+  int           m_playerIdx = -1;     // -1 = nadie
+  PlayerInput   m_playerInput;
+  KartPhysics::Params m_playerKart;  // el estado vive en el KartPhysics del corredor
+
+  /** @brief Kart conducido desde fuera (red) y su última entrada. */
+  struct RemoteKart {
+    int         idx = -1;
+    PlayerInput input;
+  };
+  std::vector<RemoteKart> m_remoteKarts;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @file RacingLine.h
+ * @brief Trazada optimizada y perfil de velocidad precalculados sobre la línea central (asset binario).
+ */
+
+#include "Prerequisites.h"
+#include "RacingSpline.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class RacingLine
+ * @brief Desplazamiento lateral y velocidad objetivo por muestra de la RacingSpline central.
+ *
+ * Lo genera fuera de línea RacingLineOptimizer y el juego sólo lo lee: en tiempo de
+ * carrera cada consulta es un acceso a tabla con interpolación lineal. La velocidad es
+ * una fracción de la máxima de cada kart (1 = recta). Cuantizado: 2 bytes de offset
+ * (cuartos de píxel) + 2 bytes de velocidad por muestra.
+ */
+class RacingLine {
+public:
+  /**
+   * @brief Rellena la tabla desde valores por muestra de @p spline.
+   * @param offsets Desplazamiento sobre la normal de la línea central (px), uno por muestra.
+   * @param speedScales Fracción de la velocidad máxima (0..1), una por muestra.
+   */
+  void assign(const RacingSpline& spline, const std::vector<float>& offsets, const std::vector<float>& speedScales);
+
+  /** @brief Desplazamiento lateral en la distancia de arco @p s (px). */
+  float getOffset(float s) const;
+
+  /** @brief Fracción de la velocidad máxima en la distancia de arco @p s. */
+  float getSpeedScale(float s) const;
+
+  /** @brief true si no tiene datos. */
+  bool empty() const { return m_offsets.empty(); }
+
+  /** @brief Muestras de la tabla. */
+  std::size_t size() const { return m_offsets.size(); }
+
+  /** @brief Guarda el asset junto con la huella de la spline para la que se calculó. */
+  bool save(const std::string& path) const;
+
+  /**
+   * @brief Carga el asset si se calculó para @p spline (misma LUT); si no, lo rechaza.
+   */
+  bool load(const std::string& path, const RacingSpline& spline);
+
+  /** @brief Huella de la LUT de @p spline (posiciones cuantizadas). */
+  static std::uint64_t splineKey(const RacingSpline& spline);
+
+private:
+  /** @brief Índice y fracción de @p s en la tabla. */
+  std::size_t locate(float s, float& u) const;
+
+  std::vector<std::int16_t>  m_offsets;  ///< Cuartos de píxel.
+  std::vector<std::uint16_t> m_speeds;   ///< 65535 = velocidad máxima.
+  std::uint64_t m_key = 0;
+  float m_length = 0.f;
+  float m_invStep = 0.f;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+/**
+ * @file RacingLineOptimizer.h
+ * @brief Herramienta fuera de línea: trazada de mínima curvatura y perfil de velocidad para la IA.
+ */
+
+#include "Prerequisites.h"
+#include "RacingLine.h"
+#include "RacingSpline.h"
+#include "TrackSurface.h"
+
+#include <string>
+
+/**
+ * @class RacingLineOptimizer
+ * @brief Calcula un RacingLine a partir de la línea central y del ancho de pista del mapa de superficie.
+ *
+ * 1. Ancho disponible a cada lado de cada muestra: se avanza por la normal mientras el
+ *    campo de distancia diga asfalto con @c margin píxeles de holgura.
+ * 2. Trazada: desplazamiento lateral por muestra que minimiza la curvatura (descenso sobre
+ *    la cuarta diferencia de los puntos, proyectado en la normal y limitado al ancho),
+ *    primero en una rejilla gruesa y luego refinado en la LUT completa.
+ * 3. Velocidad: límite por aceleración lateral v = sqrt(a / |curvatura|), y pasadas hacia
+ *    delante (aceleración) y hacia atrás (frenada) para que los cambios sean alcanzables.
+ *
+ * Uso: EntregaMarioKart --optimize-line [--out fichero] [--generated] [--margin px]
+ *      [--lateral-accel a] [--accel a] [--brake a] [--reference-speed v] [--iterations n]
+ */
+class RacingLineOptimizer {
+public:
+  /**
+   * @brief Parámetros de la optimización.
+   */
+  struct Config {
+    std::string outPath = "bin/pista de carreras.line"; ///< Asset de salida.
+    bool  generatedSurface = false;  ///< true = calzada generada desde la línea (sin imagen).
+    float margin = 20.f;             ///< Holgura hasta el borde del asfalto (px).
+    float lateralAccel = 200.f;      ///< Aceleración lateral máxima (px/s^2).
+    float accel = 220.f;             ///< Aceleración en recta (px/s^2).
+    float brake = 400.f;             ///< Frenada (px/s^2).
+    float referenceSpeed = 165.f;    ///< Velocidad que corresponde a escala 1 (px/s).
+    int   iterations = 20000;        ///< Iteraciones en la rejilla gruesa.
+  };
+
+  /**
+   * @brief Resumen de la trazada calculada.
+   */
+  struct Report {
+    float centerLength = 0.f;   ///< Longitud de la línea central (px).
+    float lineLength = 0.f;     ///< Longitud de la trazada (px).
+    float minWidth = 0.f;       ///< Ancho útil mínimo (px, suma de ambos lados).
+    float minRadius = 0.f;      ///< Radio de curva mínimo de la trazada (px).
+    float centerMinRadius = 0.f;///< Radio mínimo de la línea central (px).
+    float lapTime = 0.f;        ///< Vuelta estimada con el perfil (s).
+    float centerLapTime = 0.f;  ///< Vuelta estimada por el centro con el mismo modelo (s).
+    float minSpeedScale = 1.f;  ///< Fracción de velocidad más baja del perfil.
+  };
+
+  /**
+   * @brief Interpreta argv.
+   * @return true si se pidió la herramienta (--optimize-line).
+   */
+  static bool parseArgs(int argc, char* argv[], Config& out);
+
+  /**
+   * @brief Optimiza la pista por defecto, escribe el asset e imprime el resumen.
+   * @return 0 si todo va bien, 1 si no se pudo escribir.
+   */
+  int run(const Config& config);
+
+  /**
+   * @brief Calcula la trazada y el perfil para @p spline sobre @p surface.
+   * @param report Resumen opcional.
+   */
+  static RacingLine optimize(const RacingSpline& spline, const TrackSurface& surface,
+                             const Config& config, Report* report = nullptr);
+};
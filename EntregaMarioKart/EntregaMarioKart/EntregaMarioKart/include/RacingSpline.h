@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file RacingSpline.h
+ * @brief Línea de carrera Catmull-Rom precomputada en una tabla (LUT) indexada por longitud de arco.
+ */
+
+#include "Prerequisites.h"
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+/**
+ * @class RacingSpline
+ * @brief Spline Catmull-Rom (centrípeta) muestreada a paso de arco constante.
+ *
+ * Se construye una sola vez a partir de los waypoints y se comparte entre corredores.
+ * En tiempo de juego sólo se hacen búsquedas en la tabla e interpolación lineal:
+ * no se vuelve a evaluar el polinomio.
+ */
+class RacingSpline {
+public:
+  /**
+   * @brief Muestra de la LUT: posición, tangente unitaria y curvatura con signo (1/px).
+   */
+  struct Sample {
+    sf::Vector2f position{ 0.f, 0.f };
+    sf::Vector2f tangent{ 1.f, 0.f };
+    float        curvature = 0.f;
+  };
+
+  RacingSpline() = default;
+
+  /**
+   * @brief Construye la spline y la LUT a partir de puntos de control.
+   * @param controlPoints Waypoints en coordenadas de mundo (mínimo 2).
+   * @param closed true si el recorrido es un circuito cerrado.
+   * @param step Paso de muestreo en píxeles de arco.
+   * @return false si no hay puntos suficientes.
+   */
+  bool build(const std::vector<sf::Vector2f>& controlPoints, bool closed = true, float step = 8.f);
+
+  /**
+   * @brief Evalúa la LUT en la distancia de arco @p s (interpolada).
+   * @param s Distancia a lo largo de la línea; se envuelve si es cerrada, se satura si es abierta.
+   */
+  Sample sample(float s) const;
+
+  /**
+   * @brief Proyecta un punto sobre la línea buscando sólo alrededor de @p hint.
+   * @param point Punto de mundo a proyectar.
+   * @param hint Distancia de arco aproximada (p. ej. la del frame anterior).
+   * @param window Distancia de búsqueda hacia atrás y hacia delante de @p hint.
+   * @return Distancia de arco del punto más cercano.
+   */
+  float project(const sf::Vector2f& point, float hint, float window) const;
+
+  /**
+   * @brief Proyecta un punto recorriendo toda la LUT (usar sólo al inicializar).
+   */
+  float project(const sf::Vector2f& point) const;
+
+  /**
+   * @brief Normaliza una distancia de arco al rango [0, longitud).
+   */
+  float wrap(float s) const;
+
+  /** @brief Longitud total de la línea en píxeles. */
+  float getLength() const { return m_length; }
+
+  /** @brief Paso real de muestreo (ajustado para cerrar el circuito). */
+  float getStep() const { return m_step; }
+
+  /** @brief Indica si la línea es un circuito cerrado. */
+  bool isClosed() const { return m_closed; }
+
+  /** @brief true si todavía no se ha construido. */
+  bool empty() const { return m_samples.empty(); }
+
+  /** @brief Número de muestras de la LUT. */
+  std::size_t getSampleCount() const { return m_samples.size(); }
+
+  /** @brief Acceso directo a la LUT (sólo lectura). */
+  const std::vector<Sample>& getSamples() const { return m_samples; }
+
+private:
+  /**
+   * @brief Muestra discreta @p i, envuelta o saturada según el tipo de línea.
+   */
+  const Sample& at(int i) const;
+
+  std::vector<Sample> m_samples;   ///< LUT a paso de arco constante.
+  float m_length = 0.f;            ///< Longitud total.
+  float m_step = 8.f;              ///< Paso de arco entre muestras.
+  float m_invStep = 1.f / 8.f;     ///< 1 / m_step (evita divisiones en sample()).
+  bool  m_closed = true;           ///< Circuito cerrado.
+};
@@ -2,12 +2,24 @@
 
 #include <Prerequisites.h>
 #include <unordered_map>
+#include <vector>
 #include <ECS/Texture.h>
+#include "TextureAtlas.h"
 
 class ResourceManager {
 public:
+  /**
+   * @brief Empaqueta (o lee de la cach) un atlas con las imgenes @p names.
+   *        Llamar una vez, antes de loadTexture(): las imgenes del atlas ya no se cargan sueltas.
+   * @param cacheBase Ruta base de la cach (ver TextureAtlas::loadOrBuild()).
+   * @return false si no se pudo crear el atlas (las texturas se cargarn sueltas).
+   */
+  bool loadAtlas(const std::vector<std::string>& names, const std::string& cacheBase = "bin/atlas",
+                 const std::string& extension = "png");
+
   /**
    * @brief Carga una textura y la almacena bajo la clave fileName.
+   *        Si fileName est en el atlas, el componente usa su recorte y no lee ningn fichero.
    * @param fileName Nombre base del archivo (sin extensin).
    * @param extension Extensin del archivo (por defecto "png").
    * @return true si la textura ya exista o se carg correctamente.
@@ -15,11 +27,22 @@ public:
   bool loadTexture(const std::string& fileName, const std::string& extension = "png");
 
   /**
-   * @brief Devuelve la textura cargada con fileName, o la textura por defecto si no existe.
+   * @brief Devuelve la textura cargada con fileName, o un puntero nulo si no existe.
    */
   EngineUtilities::TSharedPointer<Texture> getTexture(const std::string& fileName);
 
+  /**
+   * @brief Pgina del atlas y recorte de fileName (texture nullptr si no est en el atlas).
+   */
+  TextureAtlas::Region getAtlasRegion(const std::string& fileName) const { return m_atlas.find(fileName); }
+
+  /** @brief Atlas cargado con loadAtlas(). */
+  const TextureAtlas& getAtlas() const { return m_atlas; }
+
 private:
   // Mapa de texturas cargadas: clave = fileName, valor = puntero compartido a Texture
   std::unordered_map<std::string, EngineUtilities::TSharedPointer<Texture>> m_textures;
+
+  // Pginas compartidas por los componentes Texture creados desde el atlas
+  TextureAtlas m_atlas;
 };
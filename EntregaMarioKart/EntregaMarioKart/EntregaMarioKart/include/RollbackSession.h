@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * @file RollbackSession.h
+ * @brief Carrera en red entre pares con predicción de mandos y rollback (sin servidor).
+ */
+
+#include "Prerequisites.h"
+#include "NetProtocol.h"
+#include "NetTransport.h"
+#include "RaceSimulation.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class RollbackSession
+ * @brief Cada par simula la carrera entera con sus mandos al instante y los de los demás
+ *        predichos (se repite el último confirmado). Cuando llega un mando que no coincide
+ *        con lo predicho, restaura el estado guardado de ese tick y vuelve a simular hasta
+ *        el presente con los mandos corregidos.
+ *
+ * Antes de cada tick se guarda el estado con RaceSimulation::saveState() en un anillo de
+ * buffers dimensionado en start(): durante la carrera no se reserva memoria. Los mandos
+ * locales se aplican inputDelay ticks después de leerlos, lo que esconde esa parte de la
+ * latencia sin rollback. Si algún par va más de maxRollback ticks por detrás de lo
+ * confirmado, advance() no avanza (el par rápido espera al lento).
+ *
+ * Cada datagrama lleva todos los mandos locales que el otro par aún no ha confirmado
+ * (redundancia contra pérdidas) y el siguiente tick que se espera de él (confirmación).
+ * Los mandos se cuantizan antes de simularlos en local, así que todos los pares usan los
+ * mismos bits y la simulación, determinista, converge al mismo estado.
+ */
+class RollbackSession {
+public:
+  /** @brief Ticks de mandos guardados por jugador (anillo). */
+  static constexpr std::uint32_t kInputWindow = 128;
+
+  /** @brief Mandos por datagrama como máximo. */
+  static constexpr std::uint32_t kMaxInputsPerPacket = 32;
+
+  /**
+   * @brief Retardo de entrada y margen de predicción.
+   */
+  struct Config {
+    float hz = 60.f;
+    int   inputDelay = 2;    ///< Ticks entre leer el mando local y aplicarlo.
+    int   maxRollback = 10;  ///< Ticks que se puede simular por delante de lo confirmado.
+  };
+
+  /**
+   * @brief Otro jugador: su par en el transporte y el kart que conduce.
+   */
+  struct Remote {
+    int peer = -1;
+    int racer = -1;
+  };
+
+  /**
+   * @brief Rollbacks, coste medido y tráfico.
+   */
+  struct Stats {
+    std::uint32_t ticks = 0;            ///< Ticks avanzados (sin contar re-simulaciones).
+    std::uint32_t stalls = 0;           ///< advance() que esperó a los demás.
+    std::uint32_t mispredictions = 0;   ///< Mandos confirmados distintos de lo predicho.
+    std::uint32_t rollbacks = 0;
+    std::uint32_t resimulated = 0;      ///< Ticks vueltos a simular.
+    std::uint32_t maxDepth = 0;         ///< Rollback más largo (ticks).
+    std::uint32_t saves = 0;
+    std::uint32_t loads = 0;
+    double        saveSeconds = 0.0;
+    double        loadSeconds = 0.0;
+    double        resimSeconds = 0.0;   ///< Tiempo re-simulando (guardados incluidos).
+    std::uint64_t bytesIn = 0;
+    std::uint64_t bytesOut = 0;
+    std::uint32_t packetsOut = 0;
+  };
+
+  /**
+   * @brief Toma el control de @p sim (ya en parrilla, sin avanzar): todos los karts de los
+   *        jugadores pasan a control externo. @p sim y @p transport deben sobrevivir a la sesión.
+   * @param localRacer Kart de este par.
+   */
+  void start(RaceSimulation& sim, NetTransport& transport, int localRacer,
+             const std::vector<Remote>& remotes, const Config& config);
+
+  /**
+   * @brief Un tick: procesa lo recibido (con rollback si hace falta), simula el tick
+   *        siguiente con @p localInput (leído ahora, aplicado tras inputDelay) y lo envía.
+   * @return false si se ha esperado a los demás: @p localInput no se ha usado.
+   */
+  bool advance(const RaceSimulation::PlayerInput& localInput);
+
+  /**
+   * @brief Procesa lo recibido y reenvía lo no confirmado sin avanzar (para terminar la carrera).
+   */
+  void poll();
+
+  /** @brief Ticks simulados (el siguiente a simular). */
+  std::uint32_t getTick() const { return m_tick; }
+
+  /** @brief Ticks con los mandos de todos confirmados: el estado antes de este tick es definitivo. */
+  std::uint32_t getConfirmedTick() const;
+
+  /** @brief Bytes de cada estado guardado. */
+  std::size_t getStateSize() const { return m_stateSize; }
+
+  const Stats& getStats() const { return m_stats; }
+
+private:
+  /** @brief Mando de un tick: confirmado o predicho. */
+  struct InputSlot {
+    std::uint32_t tick = UINT32_MAX;   ///< Tick al que pertenece (el anillo se reutiliza).
+    bool          confirmed = false;
+    RaceSimulation::PlayerInput input;
+  };
+
+  /** @brief Jugador: el local (peer -1) o uno remoto. */
+  struct Player {
+    int           peer = -1;
+    int           racer = -1;
+    std::uint32_t received = 0;   ///< Todos sus mandos anteriores a este tick están confirmados.
+    std::uint32_t acked = 0;      ///< (Remoto) tiene nuestros mandos anteriores a este tick.
+    std::array<InputSlot, kInputWindow> inputs{};
+  };
+
+  /** @brief Estado guardado antes de simular @c tick. */
+  struct SavedState {
+    std::uint32_t             tick = UINT32_MAX;
+    std::vector<std::uint8_t> bytes;
+  };
+
+  /** @brief Lee los datagramas y marca el tick más antiguo mal predicho. */
+  void receive();
+
+  /** @brief Guarda un mando confirmado; si se había predicho otro, pide rollback. */
+  void confirmInput(Player& player, std::uint32_t tick, const RaceSimulation::PlayerInput& input);
+
+  /** @brief Restaura el estado más antiguo mal predicho y re-simula hasta el tick actual. */
+  void rollback();
+
+  /** @brief Guarda el estado, aplica los mandos (predichos si faltan) y avanza un tick. */
+  void simulateTick();
+
+  /** @brief Mando de @p player en @p tick: el confirmado o el último confirmado repetido. */
+  const RaceSimulation::PlayerInput& inputFor(Player& player, std::uint32_t tick);
+
+  /** @brief Envía a cada par los mandos locales que aún no ha confirmado. */
+  void sendInputs();
+
+  RaceSimulation*           m_sim = nullptr;
+  NetTransport*             m_transport = nullptr;
+  Config                    m_config;
+  std::vector<Player>       m_players;           ///< [0] = local.
+  std::vector<SavedState>   m_states;            ///< Anillo de maxRollback + 2 estados.
+  std::size_t               m_stateSize = 0;
+  std::uint32_t             m_tick = 0;
+  std::uint32_t             m_rollbackTo = UINT32_MAX; ///< Tick más antiguo mal predicho.
+  Stats                     m_stats;
+  std::vector<std::uint8_t> m_packet;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file ShapeGeometry.h
+ * @brief Geometría inmutable y compartida de las formas de CShape (una por tipo y parámetros).
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ShapeGeometry
+ * @brief Triángulos locales de una forma convexa, creados una vez y compartidos por todos los CShape iguales.
+ *
+ * get() devuelve siempre el mismo objeto para la misma clave: cien actores con el círculo
+ * por defecto comparten un único ShapeGeometry y cada CShape sólo guarda su transformación
+ * y su color. La geometría no cambia después de crearse.
+ *
+ * La caché es por hilo: el contador de TSharedPointer no es atómico y RaceBatchRunner crea
+ * actores en varios hilos a la vez; así cada hilo comparte sólo con sus propios actores.
+ */
+class ShapeGeometry {
+public:
+  /**
+   * @brief Tipo y parámetros que identifican una geometría.
+   *
+   * - CIRCLE: radio = width, points lados.
+   * - RECTANGLE: width x height.
+   * - TRIANGLE: isósceles de base width (arriba) y altura height, con el vértice abajo.
+   * - POLYGON: regular de radio width y points lados.
+   *
+   * outline > 0 añade un borde de ese grosor por fuera del contorno (como sf::Shape).
+   */
+  struct Key {
+    ShapeType     type = ShapeType::EMPTY;
+    float         width = 0.f;
+    float         height = 0.f;
+    std::uint32_t points = 0;
+    float         outline = 0.f;
+
+    bool operator==(const Key& other) const {
+      return type == other.type && width == other.width && height == other.height && points == other.points &&
+        outline == other.outline;
+    }
+  };
+
+  /** @brief Clave con los parámetros por defecto de cada tipo (los de CShape(ShapeType)). */
+  static Key defaultKey(ShapeType type);
+
+  /**
+   * @brief Geometría de @p key, creándola la primera vez que se pide en este hilo.
+   */
+  static EngineUtilities::TSharedPointer<ShapeGeometry> get(const Key& key);
+
+  /** @brief Geometrías distintas creadas en este hilo. */
+  static std::size_t getCacheSize();
+
+  /** @brief Usar get(): construir a mano no comparte nada. */
+  explicit ShapeGeometry(const Key& key);
+
+  const Key& getKey() const { return m_key; }
+
+  /**
+   * @brief Vértices locales de 3 en 3: primero el relleno (abanico desde el primer punto del
+   *        contorno) y después el borde, si lo hay.
+   */
+  const std::vector<sf::Vector2f>& getTriangles() const { return m_triangles; }
+
+  /**
+   * @brief Coordenada de textura de cada vértice de getTriangles(), como fracción (0..1) de
+   *        getBounds(): basta escalarla por el recorte de la textura.
+   */
+  const std::vector<sf::Vector2f>& getTexCoords() const { return m_texCoords; }
+
+  /** @brief Vértices del relleno; los siguientes son del borde. */
+  std::size_t getFillCount() const { return m_fillCount; }
+
+  /** @brief Caja local del contorno (para mapear la textura, como sf::Shape). */
+  const sf::FloatRect& getBounds() const { return m_bounds; }
+
+private:
+  Key                       m_key;
+  std::vector<sf::Vector2f> m_triangles;
+  std::vector<sf::Vector2f> m_texCoords;
+  std::size_t               m_fillCount = 0;
+  sf::FloatRect             m_bounds;
+};
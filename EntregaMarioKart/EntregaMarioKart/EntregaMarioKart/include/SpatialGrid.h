@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * @file SpatialGrid.h
+ * @brief Rejilla uniforme con hash espacial para consultas de proximidad (broadphase).
+ */
+
+#include "Prerequisites.h"
+#include "StateBuffer.h"
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SpatialGrid
+ * @brief Hash espacial de celdas cuadradas: cada entidad vive en la celda de su centro.
+ *
+ * Las entidades se identifican por un índice denso (0..N-1, p. ej. el índice de parrilla).
+ * update() es incremental: si la entidad no cambia de celda sólo se guarda la posición;
+ * si cambia, se quita de la celda vieja con swap-and-pop y se añade a la nueva (O(1)).
+ * Las consultas amplían la zona por el radio máximo insertado, así que una entidad
+ * se encuentra aunque su centro esté en una celda vecina.
+ *
+ * Conviene que cellSize sea >= 2 * radio típico de consulta: así una consulta toca 3x3 celdas.
+ */
+class SpatialGrid {
+public:
+  /**
+   * @param cellSize Lado de la celda en píxeles.
+   */
+  explicit SpatialGrid(float cellSize = 64.f);
+
+  /**
+   * @brief Cambia el tamaño de celda y vacía la rejilla.
+   */
+  void setCellSize(float cellSize);
+
+  /** @brief Lado de la celda en píxeles. */
+  float getCellSize() const { return m_cellSize; }
+
+  /**
+   * @brief Quita todas las entidades (conserva la memoria reservada).
+   */
+  void clear();
+
+  /**
+   * @brief Inserta o mueve la entidad @p id.
+   * @param id Índice denso de la entidad.
+   * @param position Centro en coordenadas de mundo.
+   * @param radius Radio de la entidad (se usa para filtrar en las consultas).
+   */
+  void update(std::uint32_t id, const sf::Vector2f& position, float radius);
+
+  /**
+   * @brief Quita la entidad @p id (no hace nada si no estaba).
+   */
+  void remove(std::uint32_t id);
+
+  /** @brief true si @p id está en la rejilla. */
+  bool contains(std::uint32_t id) const;
+
+  /** @brief Centro guardado de @p id (indefinido si no está). */
+  const sf::Vector2f& getPosition(std::uint32_t id) const { return m_entries[id].position; }
+
+  /** @brief Radio guardado de @p id (indefinido si no está). */
+  float getRadius(std::uint32_t id) const { return m_entries[id].radius; }
+
+  /**
+   * @brief Entidades cuyo círculo toca el círculo (@p center, @p radius).
+   * @param out Se vacía y se rellena con los ids encontrados.
+   * @param ignore Id a excluir (p. ej. el que consulta); UINT32_MAX = ninguno.
+   */
+  void queryRadius(const sf::Vector2f& center, float radius, std::vector<std::uint32_t>& out,
+                   std::uint32_t ignore = UINT32_MAX) const;
+
+  /**
+   * @brief Entidades cuyo círculo toca el rectángulo @p area.
+   * @param out Se vacía y se rellena con los ids encontrados.
+   */
+  void queryAABB(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+
+  /**
+   * @brief Entradas por id. Las celdas no se copian: se reconstruyen con la celda y el
+   *        hueco de cada entrada, así que las consultas devuelven los ids en el mismo orden.
+   *        Ninguna consulta depende del número de celdas ni del orden del mapa, que pueden
+   *        diferir tras un rollback (quedan celdas vacías de futuros descartados).
+   */
+  void saveState(StateWriter& out) const;
+
+  /** @brief Restaura lo guardado con saveState() (mismo tamaño de celda). */
+  void loadState(StateReader& in);
+
+  /** @brief Número de entidades insertadas. */
+  std::size_t size() const { return m_count; }
+
+  /** @brief Celdas creadas (las vacías se conservan para no volver a reservar memoria). */
+  std::size_t getCellCount() const { return m_cells.size(); }
+
+private:
+  /**
+   * @brief Datos por entidad: posición, radio, celda actual y posición dentro de esa celda.
+   */
+  struct Entry {
+    sf::Vector2f  position{ 0.f, 0.f };
+    float         radius = 0.f;
+    std::uint64_t cell = 0;
+    std::uint32_t slot = 0;
+    bool          active = false;
+  };
+
+  /** @brief Clave de celda: coordenadas enteras empaquetadas en 64 bits. */
+  static std::uint64_t makeKey(std::int32_t cx, std::int32_t cy) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+  }
+
+  /** @brief Coordenada de celda que contiene @p v. */
+  std::int32_t cellCoord(float v) const;
+
+  /** @brief Saca @p e de su celda actual (no toca m_count ni active). */
+  void unlink(const Entry& e);
+
+  /**
+   * @brief Recorre las celdas que cubren [min, max] ampliado por m_maxRadius.
+   */
+  template<typename Fn>
+  void forEachCandidate(const sf::Vector2f& min, const sf::Vector2f& max, Fn&& fn) const;
+
+  float m_cellSize = 64.f;
+  float m_invCellSize = 1.f / 64.f;
+  float m_maxRadius = 0.f;                ///< Mayor radio insertado desde el último clear().
+  std::size_t m_count = 0;
+  std::vector<Entry> m_entries;           ///< Indexado por id.
+  std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> m_cells;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * @file SpriteBatch.h
+ * @brief Agrupa los sprites y formas de los actores en un sf::VertexArray por textura.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class CShape;
+class Window;
+
+/**
+ * @class SpriteBatch
+ * @brief Cola de quads texturizados que se dibuja con una llamada por tramo de textura.
+ *
+ * draw() no dibuja nada: transforma los vértices del sprite (dos triángulos) o de la forma
+ * (CShape::appendTo()) y los guarda en la cola. flush() ordena la cola por capa y, dentro de
+ * cada capa, por textura (a igualdad, en orden de llegada), y envía cada tramo de misma capa
+ * y textura como un único sf::VertexArray de triángulos. Las capas se dibujan de menor a
+ * mayor; dentro de una capa el orden entre texturas distintas no está garantizado.
+ *
+ * Con setCullRect(), draw() descarta lo que no toca el rectángulo (lo que queda fuera de la
+ * cámara) antes de encolarlo.
+ *
+ * Los vectores y vertex arrays se reutilizan de un frame a otro: tras los primeros frames
+ * no se reserva memoria.
+ */
+class SpriteBatch {
+public:
+  /**
+   * @brief Contadores desde el último beginFrame().
+   */
+  struct Stats {
+    std::size_t quads = 0;        ///< Sprites enviados.
+    std::size_t shapes = 0;       ///< Formas (CShape) enviadas.
+    std::size_t drawCalls = 0;    ///< Llamadas de dibujo (una por tramo de textura).
+    std::size_t flushes = 0;      ///< Veces que se ha vaciado la cola con algo dentro.
+    std::size_t culled = 0;       ///< Quads descartados por setCullRect().
+  };
+
+  /** @brief Pone a cero los contadores (una vez por frame, antes del primer draw()). */
+  void beginFrame();
+
+  /**
+   * @brief Encola un sprite con su textura, recorte, transformación y color.
+   * @param layer Capa de dibujo; las menores quedan debajo.
+   */
+  void draw(const sf::Sprite& sprite, int layer = 0);
+
+  /**
+   * @brief Encola un quad de @p rect (píxeles de @p texture) transformado por @p transform.
+   * @param texture nullptr = quad de color liso.
+   */
+  void draw(const sf::Texture* texture, const sf::IntRect& rect, const sf::Transform& transform,
+            const sf::Color& color, int layer = 0);
+
+  /**
+   * @brief Encola los triángulos de @p shape con su transformación, colores y textura.
+   * @param layer Capa de dibujo; las menores quedan debajo.
+   */
+  void draw(const CShape& shape, int layer = 0);
+
+  /**
+   * @brief Descarta en draw() los quads que no tocan @p rect (coordenadas de mundo).
+   */
+  void setCullRect(const sf::FloatRect& rect) { m_cullRect = rect; }
+
+  /** @brief Deja de descartar quads. */
+  void clearCullRect() { m_cullRect.reset(); }
+
+  /**
+   * @brief Ordena la cola, la dibuja y la vacía.
+   */
+  void flush(const EngineUtilities::TSharedPointer<Window>& window);
+
+  /** @brief Sprites y formas en cola sin dibujar. */
+  std::size_t getPending() const { return m_items.size(); }
+
+  const Stats& getStats() const { return m_stats; }
+
+private:
+  /**
+   * @brief Un sprite o forma en cola; sus triángulos, ya en coordenadas de mundo, están en
+   *        m_vertices[first, first + count).
+   */
+  struct Item {
+    const sf::Texture* texture = nullptr;
+    int                layer = 0;
+    std::uint32_t      order = 0;   ///< Orden de llegada (desempate estable).
+    std::uint32_t      first = 0;
+    std::uint32_t      count = 0;
+  };
+
+  /**
+   * @brief Cierra el elemento cuyos vértices empiezan en @p first; lo descarta (y devuelve
+   *        false) si no toca el rectángulo de setCullRect().
+   */
+  bool enqueue(const sf::Texture* texture, int layer, std::size_t first);
+
+  std::vector<Item>            m_items;
+  sf::VertexArray              m_vertices{ sf::PrimitiveType::Triangles }; ///< Triángulos de toda la cola.
+  std::vector<std::uint32_t>   m_sorted;   ///< Índices de m_items en orden de dibujo.
+  std::vector<sf::VertexArray> m_arrays;   ///< Uno por tramo; se reutilizan entre frames.
+  Stats                        m_stats;
+  std::optional<sf::FloatRect> m_cullRect;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @file SpriteSheetBaker.h
+ * @brief Herramienta fuera de línea: hornea cada personaje en una hoja de N direcciones.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @class SpriteSheetBaker
+ * @brief Genera bin/<personaje> direcciones.png a partir del sprite cenital bin/<personaje>.png.
+ *
+ * Cada fotograma es el sprite girado para que el morro apunte al rumbo relativo del
+ * fotograma y aplastado en vertical (@c tilt), como se vería desde la cámara baja del
+ * Mode 7. El muestreo es bilineal y pondera el color por el alfa, así que los bordes no
+ * se oscurecen. El reparto de fotogramas es el que lee DirectionalSprite.
+ *
+ * Uso: EntregaMarioKart --bake-sprites [--directions n] [--cell px] [--tilt t]
+ *      [--offset grados] [--names a,b,..]
+ */
+class SpriteSheetBaker {
+public:
+  /**
+   * @brief Parámetros del horneado.
+   */
+  struct Config {
+    int   directions = 16;           ///< Fotogramas por hoja.
+    unsigned cellWidth = 64;         ///< Ancho de cada celda (px); la diagonal del sprite lo llena.
+    float tilt = 0.5f;               ///< Alto / ancho aparente del suelo visto desde la cámara.
+    float spriteAngleOffset = -90.f; ///< Como A_Racer: el morro del sprite apunta a -offset grados.
+    std::vector<std::string> names;  ///< Personajes (vacío = RaceSimulation::defaultCharacters()).
+  };
+
+  /**
+   * @brief Interpreta argv.
+   * @return true si se pidió el horneado (--bake-sprites).
+   */
+  static bool parseArgs(int argc, char* argv[], Config& out);
+
+  /**
+   * @brief Hoja de fotogramas de @p source según @p config.
+   */
+  static sf::Image bake(const sf::Image& source, const Config& config);
+
+  /**
+   * @brief Hornea y guarda la hoja de cada personaje.
+   * @return 0 si todas se escribieron, 1 si alguna falló.
+   */
+  int run(const Config& config);
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file StateBuffer.h
+ * @brief Copia binaria del estado de la simulación en un buffer reutilizable (rollback).
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class StateWriter
+ * @brief Vuelca valores trivialmente copiables, tal cual están en memoria, al final de un buffer.
+ *
+ * No es un formato de fichero ni de red: sólo lo lee el mismo binario (mismo endianness y
+ * mismo relleno de structs). A cambio guardar es un memcpy por bloque. El buffer se vacía
+ * al empezar pero conserva su capacidad, así que a partir del segundo guardado en el mismo
+ * buffer no se reserva memoria.
+ */
+class StateWriter {
+public:
+  explicit StateWriter(std::vector<std::uint8_t>& out) : m_out(out) { m_out.clear(); }
+
+  template<typename T>
+  void put(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateWriter::put sólo copia tipos triviales");
+    putBytes(&value, sizeof(T));
+  }
+
+  /** @brief Tamaño y elementos de @p values. */
+  template<typename T>
+  void putVector(const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateWriter::putVector sólo copia tipos triviales");
+    put(static_cast<std::uint32_t>(values.size()));
+    putBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  /** @brief Los @p count primeros elementos de @p values, sin tamaño (lo escribe quien llama). */
+  template<typename T>
+  void putArray(const T* values, std::size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateWriter::putArray sólo copia tipos triviales");
+    putBytes(values, count * sizeof(T));
+  }
+
+private:
+  void putBytes(const void* data, std::size_t size) {
+    if (size == 0) {
+      return;
+    }
+    const std::size_t at = m_out.size();
+    m_out.resize(at + size);
+    std::memcpy(m_out.data() + at, data, size);
+  }
+
+  std::vector<std::uint8_t>& m_out;
+};
+
+/**
+ * @class StateReader
+ * @brief Lee en el mismo orden lo escrito con StateWriter; al salirse del buffer deja ok() en false.
+ */
+class StateReader {
+public:
+  explicit StateReader(const std::vector<std::uint8_t>& in) : m_in(in) {}
+
+  template<typename T>
+  void get(T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateReader::get sólo copia tipos triviales");
+    getBytes(&value, sizeof(T));
+  }
+
+  /** @brief Lee lo escrito con putVector(); reutiliza la capacidad de @p values. */
+  template<typename T>
+  void getVector(std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateReader::getVector sólo copia tipos triviales");
+    std::uint32_t count = 0;
+    get(count);
+    if (!m_ok || static_cast<std::size_t>(count) * sizeof(T) > m_in.size() - m_pos) {
+      m_ok = false;
+      return;
+    }
+    values.resize(count);
+    getBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  /** @brief Lee lo escrito con putArray() en @p values, que ya tiene sitio para @p count. */
+  template<typename T>
+  void getArray(T* values, std::size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "StateReader::getArray sólo copia tipos triviales");
+    getBytes(values, count * sizeof(T));
+  }
+
+  /** @brief Marca el buffer como inválido (p. ej. un tamaño leído fuera de rango). */
+  void fail() { m_ok = false; }
+
+  /** @brief false si se intentó leer más de lo que había. */
+  bool ok() const { return m_ok; }
+
+  /** @brief true si se ha leído el buffer entero. */
+  bool atEnd() const { return m_pos == m_in.size(); }
+
+private:
+  void getBytes(void* data, std::size_t size) {
+    if (!m_ok || size > m_in.size() - m_pos) {
+      m_ok = false;
+      return;
+    }
+    if (size > 0) {
+      std::memcpy(data, m_in.data() + m_pos, size);
+      m_pos += size;
+    }
+  }
+
+  const std::vector<std::uint8_t>& m_in;
+  std::size_t m_pos = 0;
+  bool        m_ok = true;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file TextureAtlas.h
+ * @brief Empaqueta imágenes pequeñas (personajes, objetos) en páginas de atlas con caché en disco.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class TextureAtlas
+ * @brief Páginas de textura compartidas y el recorte de cada imagen dentro de ellas.
+ *
+ * La primera ejecución carga las imágenes, las coloca en estanterías (de más alta a más
+ * baja) dentro de páginas de getPageSize() de lado y escribe las páginas como PNG junto
+ * a un fichero de metadatos con los recortes. Las siguientes ejecuciones sólo leen los
+ * metadatos y las páginas, mientras la clave (nombre, tamaño y fecha de cada imagen y
+ * parámetros de empaquetado) coincida.
+ *
+ * Los sprites de todas las imágenes de una página comparten el mismo sf::Texture, así
+ * que SpriteBatch los dibuja con una sola llamada.
+ */
+class TextureAtlas {
+public:
+  /**
+   * @brief Imagen dentro del atlas: página y recorte en píxeles.
+   */
+  struct Region {
+    const sf::Texture* texture = nullptr;  ///< Página (nullptr = no está en el atlas).
+    sf::IntRect        rect;
+  };
+
+  /**
+   * @brief Posición de una imagen empaquetada.
+   */
+  struct Placement {
+    std::uint32_t page = 0;
+    sf::IntRect   rect;           ///< Sin el margen.
+    bool          placed = false; ///< false si la imagen no cabe en una página.
+  };
+
+  /**
+   * @param pageSize Lado máximo de cada página (px).
+   * @param padding Margen transparente alrededor de cada imagen (evita sangrado al filtrar).
+   */
+  explicit TextureAtlas(unsigned pageSize = 1024, unsigned padding = 2);
+
+  /**
+   * @brief Carga el atlas de @p cacheBase si corresponde a las imágenes actuales; si no,
+   *        lo construye con las que existan y lo reescribe.
+   * @param names Imágenes como en Texture: "bin/<name>.<extension>". Las que falten se omiten.
+   * @param cacheBase Ruta base de la caché: "<cacheBase>.atlas" y "<cacheBase>_<página>.png".
+   * @return false si no se ha podido empaquetar ninguna imagen.
+   */
+  bool loadOrBuild(const std::vector<std::string>& names, const std::string& cacheBase,
+                   const std::string& extension = "png");
+
+  /**
+   * @brief Reparto en estanterías de rectángulos de @p sizes en páginas de @p pageSize.
+   * @return Una colocación por tamaño, en el mismo orden.
+   */
+  static std::vector<Placement> pack(const std::vector<sf::Vector2u>& sizes, unsigned pageSize,
+                                     unsigned padding);
+
+  /** @brief Página y recorte de @p name (texture nullptr si no está). */
+  Region find(const std::string& name) const;
+
+  /** @brief true si @p name está en el atlas. */
+  bool contains(const std::string& name) const { return m_entries.count(name) != 0; }
+
+  std::size_t getPageCount() const { return m_pages.size(); }
+  std::size_t getImageCount() const { return m_entries.size(); }
+  unsigned    getPageSize() const { return m_pageSize; }
+
+  /** @brief true si el último loadOrBuild() leyó la caché en lugar de empaquetar. */
+  bool isFromCache() const { return m_fromCache; }
+
+private:
+  /**
+   * @brief Imagen registrada: página y recorte.
+   */
+  struct Entry {
+    std::uint32_t page = 0;
+    sf::IntRect   rect;
+  };
+
+  /** @brief Escribe los metadatos con la clave de las fuentes. */
+  bool saveMeta(const std::string& path, std::uint64_t sourceKey) const;
+
+  /** @brief Lee los metadatos si la clave coincide (no toca m_pages). */
+  bool loadMeta(const std::string& path, std::uint64_t sourceKey, std::uint32_t& pageCount);
+
+  unsigned m_pageSize = 1024;
+  unsigned m_padding = 2;
+  bool     m_fromCache = false;
+  std::vector<sf::Texture>                m_pages;    ///< Se dimensiona una vez por carga (Region apunta aquí).
+  std::unordered_map<std::string, Entry>  m_entries;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+/**
+ * @file TrackChunker.h
+ * @brief Herramienta fuera de línea: trocea la imagen de una pista en chunks para TrackStreamer.
+ */
+
+#include "Prerequisites.h"
+#include "TrackStreamer.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <string>
+
+/**
+ * @class TrackChunker
+ * @brief Corta la pista en cuadrados de @c chunkSize px y escribe el índice y un PNG por chunk.
+ *
+ * Los chunks totalmente transparentes no se escriben: el índice los marca vacíos y
+ * TrackStreamer nunca los pide. Con el índice presente, BaseApp carga la pista por chunks
+ * en lugar de entera.
+ *
+ * Uso: EntregaMarioKart --chunk-track [--track imagen] [--out base] [--chunk px]
+ */
+class TrackChunker {
+public:
+  /**
+   * @brief Entrada y tamaño de los chunks.
+   */
+  struct Config {
+    std::string trackPath = "bin/pista de carreras.png";
+    std::string outBase = "bin/pista de carreras";  ///< <base>.chunks y <base>_<columna>_<fila>.png.
+    unsigned    chunkSize = 512;
+  };
+
+  /**
+   * @brief Interpreta argv.
+   * @return true si se pidió el troceado (--chunk-track).
+   */
+  static bool parseArgs(int argc, char* argv[], Config& out);
+
+  /**
+   * @brief Escribe los chunks de @p image y su índice.
+   * @param index Índice escrito (tamaños y chunks vacíos).
+   * @return false si no se pudo escribir algún fichero.
+   */
+  static bool build(const sf::Image& image, const std::string& outBase, unsigned chunkSize,
+                    TrackStreamer::Index& index);
+
+  /**
+   * @brief Trocea la pista de la configuración e imprime un resumen.
+   * @return 0 si todo va bien, 1 si falló la lectura o la escritura.
+   */
+  int run(const Config& config);
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * @file TrackStreamer.h
+ * @brief Pista troceada en chunks que se cargan en segundo plano alrededor de la cámara.
+ */
+
+#include "Prerequisites.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class SpriteBatch;
+
+/**
+ * @class TrackStreamer
+ * @brief Mantiene en GPU sólo los chunks de pista cercanos a la cámara, dentro de un presupuesto.
+ *
+ * Formato (TrackChunker lo genera): <base>.chunks con el índice (tamaño de la pista, lado del
+ * chunk, columnas, filas y qué chunks están vacíos) y una imagen por chunk no vacío,
+ * <base>_<columna>_<fila>.png.
+ *
+ * Cada frame, update() marca los chunks que tocan la vista (más un margen para llegar antes
+ * que la cámara) y pide los que faltan, el más cercano primero. Un hilo decodifica los PNG
+ * a sf::Image; el hilo principal sólo sube a GPU unos pocos por frame (uploadsPerFrame), así
+ * que cargar nunca cuesta más que eso en un frame. Si se pasa del presupuesto, se descargan
+ * los chunks usados hace más tiempo que no están a la vista. Lo que sale de la vista antes
+ * de empezar a cargarse se cancela.
+ */
+class TrackStreamer {
+public:
+  /**
+   * @brief Índice de una pista troceada.
+   */
+  struct Index {
+    static constexpr std::uint32_t kMaxChunkSize = 4096;     ///< 64 MB por chunk en RGBA.
+    static constexpr std::uint32_t kMaxTrackSize = 1u << 20; ///< Lado máximo de la pista (px).
+
+    std::uint32_t width = 0;          ///< Tamaño de la pista entera (px).
+    std::uint32_t height = 0;
+    std::uint32_t chunkSize = 512;    ///< Lado de cada chunk (px; los del borde pueden ser menores).
+    std::uint32_t columns = 0;
+    std::uint32_t rows = 0;
+    std::vector<std::uint8_t> empty;  ///< 1 = chunk totalmente transparente (sin imagen).
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    /** @brief Rectángulo del chunk (columna, fila) en px de pista. */
+    sf::IntRect chunkRect(std::uint32_t column, std::uint32_t row) const;
+  };
+
+  /**
+   * @brief Presupuesto y ritmo de carga.
+   */
+  struct Params {
+    std::size_t budgetBytes = 64u << 20;  ///< Memoria de GPU máxima para chunks (RGBA).
+    float       margin = 256.f;           ///< Px alrededor de la vista que también se cargan.
+    int         uploadsPerFrame = 2;      ///< Chunks subidos a GPU como mucho por frame.
+  };
+
+  /**
+   * @brief Contadores (los de carga son acumulados).
+   */
+  struct Stats {
+    std::size_t resident = 0;        ///< Chunks en GPU.
+    std::size_t residentBytes = 0;
+    std::size_t wanted = 0;          ///< Chunks no vacíos que toca la vista con margen.
+    std::size_t pending = 0;         ///< Pedidos sin subir todavía.
+    std::size_t loads = 0;           ///< Chunks subidos.
+    std::size_t evictions = 0;       ///< Chunks descargados por presupuesto.
+    std::size_t failures = 0;        ///< Imágenes que no se pudieron leer.
+    bool        overBudget = false;  ///< La vista necesita más chunks de los que caben.
+  };
+
+  static std::string indexPath(const std::string& base) { return base + ".chunks"; }
+  static std::string chunkPath(const std::string& base, std::uint32_t column, std::uint32_t row);
+
+  TrackStreamer() = default;
+  ~TrackStreamer();
+  TrackStreamer(const TrackStreamer&) = delete;
+  TrackStreamer& operator=(const TrackStreamer&) = delete;
+
+  /**
+   * @brief Lee el índice de @p base y arranca el hilo de carga.
+   * @return false si no hay índice válido (la pista se carga entera como siempre).
+   */
+  bool open(const std::string& base, const Params& params);
+  bool open(const std::string& base) { return open(base, Params()); }
+
+  /** @brief Para el hilo y libera todos los chunks. */
+  void close();
+
+  bool isOpen() const { return m_worker.joinable(); }
+
+  /**
+   * @brief Pide los chunks que toca @p visible, sube los que ya estén decodificados y
+   *        descarga los que sobran. Una vez por frame, antes de submit().
+   */
+  void update(const sf::FloatRect& visible);
+
+  /**
+   * @brief Encola en @p batch los chunks residentes que tocan @p visible.
+   */
+  void submit(SpriteBatch& batch, const sf::FloatRect& visible, int layer) const;
+
+  /** @brief Tamaño de la pista entera (px). */
+  sf::Vector2f getSize() const { return { static_cast<float>(m_index.width), static_cast<float>(m_index.height) }; }
+
+  const Index& getIndex() const { return m_index; }
+  const Stats& getStats() const { return m_stats; }
+
+private:
+  enum class State : std::uint8_t { Unloaded, Queued, Resident };
+
+  /**
+   * @brief Estado de un chunk (sólo lo toca el hilo principal).
+   */
+  struct Chunk {
+    State                        state = State::Unloaded;
+    std::uint64_t                lastUsed = 0;   ///< Último frame en que estuvo a la vista.
+    std::unique_ptr<sf::Texture> texture;
+  };
+
+  /**
+   * @brief Imagen decodificada por el hilo de carga, pendiente de subir.
+   */
+  struct Decoded {
+    std::uint32_t chunk = 0;
+    bool          ok = false;
+    sf::Image     image;
+  };
+
+  /** @brief Bucle del hilo de carga: decodifica los pedidos en orden. */
+  void workerLoop();
+
+  /** @brief Columnas y filas [first, last) que toca @p rect (vacío si queda fuera). */
+  bool chunkRange(const sf::FloatRect& rect, sf::Vector2u& first, sf::Vector2u& last) const;
+
+  std::string        m_base;
+  Index              m_index;
+  Params             m_params;
+  std::vector<Chunk> m_chunks;
+  std::uint64_t      m_frame = 0;
+  std::size_t        m_budgetChunks = 1;
+  Stats              m_stats;
+  std::vector<Decoded> m_ready;                                      ///< Decodificados que esperan turno de subida.
+  std::vector<std::pair<float, std::uint32_t>> m_missing;            ///< (distancia^2, chunk) por pedir este frame.
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> m_evictable;  ///< (último uso, chunk) descargables.
+
+  // --- Compartido con el hilo de carga (bajo m_mutex) ---
+  std::mutex                 m_mutex;
+  std::condition_variable    m_wake;
+  std::deque<std::uint32_t>  m_requests;   ///< Chunks por decodificar, el más urgente delante.
+  std::vector<Decoded>       m_decoded;    ///< Decodificados, por subir.
+  bool                       m_stop = false;
+  std::thread                m_worker;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * @file TrackSurface.h
+ * @brief Mapa de superficie de la pista (asfalto / fuera de pista / muro) con campo de distancia con signo.
+ */
+
+#include "Prerequisites.h"
+#include "RacingSpline.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class TrackSurface
+ * @brief Rejilla compacta (1 byte de tipo + 2 bytes de distancia por celda) consultada en O(1) por kart.
+ *
+ * La distancia es con signo respecto al borde del asfalto: negativa dentro, positiva fuera.
+ * Más allá de getWallDistance() se considera muro. Se construye una vez:
+ *  - desde la imagen de la pista (o desde una máscara "<imagen>_mask.png" si existe:
+ *    blanco = asfalto, verde = fuera de pista, negro = muro), con caché binaria en disco;
+ *  - o desde la línea de carrera, con un ancho de calzada fijo (modo headless, sin imágenes).
+ */
+class TrackSurface {
+public:
+  /**
+   * @brief Tipo de superficie de una celda.
+   */
+  enum class Surface : std::uint8_t {
+    Road = 0,    ///< Asfalto: sin penalización.
+    Offroad = 1, ///< Hierba / tierra: frena el kart.
+    Wall = 2     ///< No transitable: el kart rebota.
+  };
+
+  TrackSurface() = default;
+
+  /**
+   * @brief Carga la caché @p cachePath si corresponde a la imagen actual; si no, la
+   *        construye desde @p imagePath (o su máscara) y reescribe la caché.
+   * @param imagePath Ruta de la imagen de la pista (p. ej. "bin/pista de carreras.png").
+   * @param cachePath Ruta del fichero de caché.
+   * @param cellSize Lado de la celda en píxeles de imagen (= píxeles de mundo).
+   * @return false si no se pudo leer la imagen.
+   */
+  bool loadOrBuild(const std::string& imagePath, const std::string& cachePath, float cellSize = 4.f);
+
+  /**
+   * @brief Clasifica los píxeles de una imagen y calcula el campo de distancia.
+   * @param isMask true si la imagen es una máscara de colores planos (blanco/verde/negro).
+   */
+  void buildFromImage(const sf::Image& image, bool isMask, float cellSize = 4.f);
+
+  /**
+   * @brief Calzada de ancho fijo alrededor de la línea de carrera (sin imagen).
+   * @param spline Línea de carrera ya construida.
+   * @param roadHalfWidth Media anchura del asfalto (px).
+   * @param bounds Zona de mundo cubierta por la rejilla.
+   */
+  void buildFromSpline(const RacingSpline& spline, float roadHalfWidth, const sf::FloatRect& bounds,
+                       float cellSize = 4.f);
+
+  /**
+   * @brief Guarda la rejilla en disco junto con la clave de la fuente.
+   */
+  bool saveCache(const std::string& path, std::uint64_t sourceKey) const;
+
+  /**
+   * @brief Carga la rejilla si el fichero existe y su clave coincide con @p sourceKey.
+   */
+  bool loadCache(const std::string& path, std::uint64_t sourceKey);
+
+  /** @brief true si no se ha construido. */
+  bool empty() const { return m_surface.empty(); }
+
+  /** @brief Tipo de superficie en @p pos (fuera de la rejilla = muro). */
+  Surface getSurface(const sf::Vector2f& pos) const;
+
+  /**
+   * @brief Distancia con signo al borde del asfalto en @p pos (px, interpolada).
+   */
+  float getDistance(const sf::Vector2f& pos) const;
+
+  /**
+   * @brief Dirección unitaria en la que crece la distancia (hacia fuera de la pista).
+   */
+  sf::Vector2f getGradient(const sf::Vector2f& pos) const;
+
+  /**
+   * @brief Fracción de las muestras de @p spline que caen sobre asfalto (validación de la imagen).
+   */
+  float roadCoverage(const RacingSpline& spline) const;
+
+  /** @brief Distancia al asfalto a partir de la cual todo es muro (px). */
+  float getWallDistance() const { return m_wallDistance; }
+
+  /** @brief Cambia la distancia de muro; se aplica en la siguiente construcción. */
+  void setWallDistance(float d) { m_wallDistance = d; }
+
+  /** @brief Memoria de la rejilla en bytes. */
+  std::size_t getMemoryBytes() const { return m_surface.size() + m_distance.size() * sizeof(std::int16_t); }
+
+private:
+  /**
+   * @brief Calcula m_distance a partir de la máscara de asfalto (chamfer 3x3, dos pasadas)
+   *        y marca como muro todo lo que quede más allá de m_wallDistance.
+   */
+  void computeDistanceField(const std::vector<std::uint8_t>& road);
+
+  /** @brief Distancia de la celda (x, y) en px, con la rejilla saturada en los bordes. */
+  float cellDistance(int x, int y) const;
+
+  int   m_width = 0;
+  int   m_height = 0;
+  float m_cellSize = 4.f;
+  float m_invCellSize = 0.25f;
+  sf::Vector2f m_origin{ 0.f, 0.f };      ///< Esquina superior izquierda de la rejilla en mundo.
+  float m_wallDistance = 40.f;            ///< Ancho de la franja de fuera de pista (px).
+  std::vector<std::uint8_t> m_surface;    ///< Surface por celda.
+  std::vector<std::int16_t> m_distance;   ///< Distancia con signo por celda, en cuartos de píxel.
+};
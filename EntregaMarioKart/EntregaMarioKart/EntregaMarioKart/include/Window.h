@@ -58,6 +58,27 @@ public:
   void draw(const sf::Drawable& drawable,
     const sf::RenderStates& states = sf::RenderStates::Default);
 
+  /**
+   * @brief Cambia la vista con la que se dibuja el mundo (cmara).
+   * @param view Centro y tamao en coordenadas de mundo.
+   */
+  void setView(const sf::View& view);
+
+  /**
+   * @brief Vista actual (la ltima de setView(), o la de la ventana al crearse).
+   */
+  const sf::View& getView() const { return m_view; }
+
+  /**
+   * @brief Vuelve a la vista por defecto (1 px de mundo = 1 px de ventana), p. ej. para el HUD.
+   */
+  void resetView();
+
+  /**
+   * @brief Tamao de la ventana en pxeles (0,0 si no est creada).
+   */
+  sf::Vector2u getSize() const;
+
   /**
    * @brief Intercambia buffers y presenta en pantalla.
    */
@@ -0,0 +1,70 @@
+#include "A_Ghost.h"
+#include "SpriteBatch.h"
+#include "Window.h"
+
+A_Ghost::A_Ghost(const std::string& name)
+  : Actor(name)
+{
+  if (auto shape = getComponent<CShape>()) {
+    shape->setFillColor(m_tint);
+  }
+}
+
+void A_Ghost::setGhostTexture(const EngineUtilities::TSharedPointer<Texture>& texture) {
+  m_texture = texture;
+  m_sprite.reset();
+  const sf::Sprite* sprite = texture ? texture->getSprite() : nullptr;
+  if (!sprite) {
+    return;
+  }
+  // Misma textura (o página del atlas), recorte y origen centrado que el corredor.
+  m_sprite.emplace(*sprite);
+  m_sprite->setColor(m_tint);
+}
+
+void A_Ghost::setLapTime(float time) {
+  auto xf = getComponent<Transform>();
+  sf::Vector2f position;
+  float rotation = 0.f;
+  m_visible = xf && m_lap && m_lap->sample(time, position, rotation);
+  if (!m_visible) {
+    return;
+  }
+  xf->setPosition(position);
+  xf->setRotation(rotation);
+  xf->storePrevious(); // ya viene interpolado de las muestras
+  Actor::update(0.f);
+}
+
+void A_Ghost::render(const EngineUtilities::TSharedPointer<Window>& window) {
+  if (!m_visible) {
+    return;
+  }
+  if (placeSprite()) {
+    window->draw(*m_sprite);
+    return;
+  }
+  Actor::render(window);
+}
+
+bool A_Ghost::submit(SpriteBatch& batch, int layer) {
+  if (!m_visible) {
+    return true;
+  }
+  if (!placeSprite()) {
+    return Actor::submit(batch, layer);
+  }
+  batch.draw(*m_sprite, layer);
+  return true;
+}
+
+bool A_Ghost::placeSprite() {
+  auto xf = getComponent<Transform>();
+  if (!m_sprite || !xf) {
+    return false;
+  }
+  m_sprite->setPosition(xf->getPosition());
+  m_sprite->setRotation(sf::degrees(xf->getRotation()));
+  m_sprite->setScale(xf->getScale());
+  return true;
+}
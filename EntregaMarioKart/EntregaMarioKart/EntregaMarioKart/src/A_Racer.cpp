@@ -1,36 +1,285 @@
-#pragma once
-
-#include "Prerequisites.h
+#include "A_Racer.h"
 #include "ECS/Transform.h"
-#include <vector>
+
+#include <algorithm>
 #include <cmath>
 
-/**
- * @class ChrisEngineRacer
- * @brief Representa un coche/corredor en la pista de ChrisEngine.
- */
-class ChrisEngineRacer : public Actor {
-public:
-    /**
-     * @brief Constructor: recibe el nombre del personaje.
-     */
-    ChrisEngineRacer(const std::string& characterName)
-        : Actor(characterName) {
+namespace {
+  constexpr float kRadToDeg = 57.2957795f;
+
+  float length(const sf::Vector2f& v) {
+    return std::sqrt(v.x * v.x + v.y * v.y);
+  }
+}
+
+A_Racer::A_Racer(const std::string& name, int playerId)
+  : Actor(name)
+  , m_playerIndex(playerId)
+  , m_physics(EngineUtilities::MakeShared<KartPhysics>())
+{
+  setPlayerId(playerId);
+  addComponent(m_physics);
+}
+
+void A_Racer::setPath(const std::vector<sf::Vector2f>& pathPoints) {
+  path = pathPoints;
+  reset();
+}
+
+void A_Racer::setSpline(const EngineUtilities::TSharedPointer<RacingSpline>& spline, float laneOffset,
+                        float startDistance) {
+  m_spline = spline;
+  m_laneOffset = laneOffset;
+  m_startDistance = startDistance;
+  reset();
+}
+
+void A_Racer::reset() {
+  m_currentLap = 0;
+  m_place = 0;
+  m_sector = 0;
+  m_raceStarted = (m_startDistance >= 0.f);
+  currentWaypointIndex = (path.size() > 1 ? 1 : 0);
+  m_splineDistance = 0.f;
+  m_avoidTarget = 0.f;
+  m_avoidOffset = 0.f;
+  m_speedScale = 1.f;
+  m_bumpVelocity = { 0.f, 0.f };
+  m_terrainScale = 1.f;
+  m_recovering = false;
+  m_spinTime = 0.f;
+  m_boostTime = 0.f;
+
+  auto xf = getComponent<Transform>();
+  if (!xf) {
+    return;
+  }
+  if (m_spline && !m_spline->empty()) {
+    m_splineDistance = m_spline->wrap(m_startDistance);
+    RacingSpline::Sample s = m_spline->sample(m_splineDistance);
+    sf::Vector2f normal{ -s.tangent.y, s.tangent.x };
+    xf->setPosition(s.position + normal * m_laneOffset);
+    xf->setRotation(std::atan2(s.tangent.y, s.tangent.x) * kRadToDeg + m_spriteAngleOffset);
+  }
+  else if (!path.empty()) {
+    xf->setPosition(path.front());
+    xf->setRotation(0.f);
+  }
+  m_physics->reset((xf->getRotation() - m_spriteAngleOffset) / kRadToDeg);
+  xf->storePrevious(); // sin interpolación desde la posición anterior al reset
+  Actor::update(0.f);  // sincroniza sprite/shape con el transform
+}
+
+A_Racer::State A_Racer::getState() const {
+  State state;
+  if (auto xf = getComponent<Transform>()) {
+    state.position = xf->getPosition();
+    state.previousPosition = xf->getPreviousPosition();
+    state.rotation = xf->getRotation();
+    state.previousRotation = xf->getPreviousRotation();
+  }
+  state.waypoint = currentWaypointIndex;
+  state.splineDistance = m_splineDistance;
+  state.avoidTarget = m_avoidTarget;
+  state.avoidOffset = m_avoidOffset;
+  state.speedScale = m_speedScale;
+  state.bumpVelocity = m_bumpVelocity;
+  state.terrainScale = m_terrainScale;
+  state.lap = m_currentLap;
+  state.sector = m_sector;
+  state.sectorCount = m_sectorCount;
+  state.place = m_place;
+  state.standing = m_standing;
+  state.raceStarted = m_raceStarted;
+  state.recovering = m_recovering;
+  state.manualControl = m_manualControl;
+  state.spinTime = m_spinTime;
+  state.boostTime = m_boostTime;
+  state.physics = m_physics->getState();
+  return state;
+}
+
+void A_Racer::setState(const State& state) {
+  if (auto xf = getComponent<Transform>()) {
+    xf->setPosition(state.position);
+    xf->setRotation(state.rotation);
+    xf->setPrevious(state.previousPosition, state.previousRotation);
+  }
+  currentWaypointIndex = state.waypoint;
+  m_splineDistance = state.splineDistance;
+  m_avoidTarget = state.avoidTarget;
+  m_avoidOffset = state.avoidOffset;
+  m_speedScale = state.speedScale;
+  m_bumpVelocity = state.bumpVelocity;
+  m_terrainScale = state.terrainScale;
+  m_currentLap = state.lap;
+  m_sector = state.sector;
+  m_sectorCount = state.sectorCount;
+  m_place = state.place;
+  m_standing = state.standing;
+  m_raceStarted = state.raceStarted;
+  m_recovering = state.recovering;
+  m_manualControl = state.manualControl;
+  m_spinTime = state.spinTime;
+  m_boostTime = state.boostTime;
+  m_physics->setState(state.physics);
+}
+
+void A_Racer::spinOut(float seconds) {
+  m_spinTime = std::max(m_spinTime, seconds);
+  m_boostTime = 0.f;
+  m_bumpVelocity = { 0.f, 0.f };
+  m_physics->addVelocity(-0.8f * m_physics->getVelocity());
+}
+
+void A_Racer::startBoost(float seconds) {
+  m_boostTime = std::max(m_boostTime, seconds);
+  m_physics->startBoost(seconds);
+}
+
+void A_Racer::update(float deltaTime) {
+  if (!isFinished()) {
+    m_spinTime = std::max(0.f, m_spinTime - deltaTime);
+    m_boostTime = std::max(0.f, m_boostTime - deltaTime);
+
+    // Rebote de los choques: se suma al movimiento propio y se amortigua.
+    auto bumpXf = getComponent<Transform>();
+    if (bumpXf && (m_bumpVelocity.x != 0.f || m_bumpVelocity.y != 0.f)) {
+      bumpXf->setPosition(bumpXf->getPosition() + m_bumpVelocity * deltaTime);
+      m_bumpVelocity *= std::exp(-m_bumpDamping * deltaTime);
+      if (length(m_bumpVelocity) < 1.f) {
+        m_bumpVelocity = { 0.f, 0.f };
+      }
     }
 
-    /**
-     * @brief Define el camino/pista por la que se mover el corredor.
-     */
-    void setPath(const std::vector<sf::Vector2f>& pathPoints) {
-        path = pathPoints;
-        if (!path.empty()) {
-            auto xf = getComponent<Transform>();
-            xf->setPosition(path.front());
-            xf->setRotation(0.f);
-        }
-        currentWaypointIndex = (path.size() > 1 ? 1 : 0);
-        Actor::update(0.f); // sincroniza sprite
+    if (m_manualControl) {
+      trackProgress(deltaTime);
     }
+    else {
+      doPathFollowing(deltaTime);
+    }
+  }
+  Actor::update(deltaTime);
+}
+
+float A_Racer::getProgress() const {
+  if (m_spline && !m_spline->empty()) {
+    return m_splineDistance / m_spline->getLength();
+  }
+  if (path.size() < 2) {
+    return 0.f;
+  }
+  // Sin spline: índice del último waypoint alcanzado sobre el total.
+  const int n = static_cast<int>(path.size());
+  const int reached = (currentWaypointIndex - 1 + n) % n;
+  return static_cast<float>(reached) / static_cast<float>(n);
+}
+
+float A_Racer::getRaceProgress() const {
+  float progress = getProgress();
+  // Junto a la meta la proyección sobre la línea y el cruce de la puerta pueden
+  // no coincidir por unos píxeles: manda el sector que dice LapTimer.
+  if (!m_raceStarted) {
+    progress -= 1.f; // filas traseras: aún no han cruzado la salida
+  }
+  else if (m_sector == 0 && progress > 0.5f) {
+    progress -= 1.f; // ya cruzó, la proyección sigue justo antes de s = 0
+  }
+  else if (m_sector == m_sectorCount - 1 && m_sectorCount > 1 && progress < 0.5f) {
+    progress += 1.f; // aún no cruzó, la proyección ya pasó s = 0
+  }
+  return static_cast<float>(m_currentLap) + progress;
+}
+
+void A_Racer::trackProgress(float deltaTime) {
+  auto xf = getComponent<Transform>();
+  if (!xf) {
+    return;
+  }
+  const sf::Vector2f pos = xf->getPosition();
+  if (m_spline && !m_spline->empty()) {
+    // Proyección local alrededor de la distancia anterior: sólo unas pocas
+    // muestras de la LUT, nunca toda la tabla.
+    const float window = lookaheadDistance + m_maxSpeed * deltaTime + m_spline->getStep();
+    m_splineDistance = m_spline->project(pos, m_splineDistance, window);
+  }
+  else if (!path.empty()) {
+    if (length(path[currentWaypointIndex] - pos) < arriveRadius) {
+      currentWaypointIndex = (currentWaypointIndex + 1) % static_cast<int>(path.size());
+    }
+  }
+}
+
+void A_Racer::doPathFollowing(float deltaTime) {
+  auto xf = getComponent<Transform>();
+  if (!xf) {
+    return;
+  }
+  trackProgress(deltaTime);
+
+  const sf::Vector2f pos = xf->getPosition();
+  sf::Vector2f target = pos;
+  float lineSpeed = 1.f;
+
+  if (m_spline && !m_spline->empty()) {
+    // El cambio de trazada por tráfico se limita a m_avoidRate px/s. Fuera de
+    // pista se olvida el tráfico y se apunta más cerca para volver al asfalto.
+    const float maxShift = m_avoidRate * deltaTime;
+    const float avoidTarget = m_recovering ? 0.f : m_avoidTarget;
+    m_avoidOffset += std::clamp(avoidTarget - m_avoidOffset, -maxShift, maxShift);
+
+    const float lookahead = m_recovering ? 0.5f * lookaheadDistance : lookaheadDistance;
+    RacingSpline::Sample ahead = m_spline->sample(m_splineDistance + lookahead);
+    sf::Vector2f normal{ -ahead.tangent.y, ahead.tangent.x };
+    float lateral = m_laneOffset + m_avoidOffset;
+    if (m_racingLine) {
+      // Trazada precalculada: dos lecturas de tabla. El carril sólo separa en la salida.
+      const float travelled = getRaceProgress() * m_spline->getLength() - m_startDistance;
+      const float laneWeight = std::clamp(1.f - travelled / m_laneBlend, 0.f, 1.f);
+      lateral = m_racingLine->getOffset(m_splineDistance + lookahead) + m_laneOffset * laneWeight + m_avoidOffset;
+      lineSpeed = m_racingLine->getSpeedScale(m_splineDistance);
+    }
+    target = ahead.position + normal * lateral;
+  }
+  else if (!path.empty()) {
+    const int n = static_cast<int>(path.size());
+
+    // Pure Pursuit: punto a lookaheadDistance recorriendo la polilínea
+    // desde la posición actual a través de los siguientes waypoints.
+    int i = currentWaypointIndex;
+    target = path[i];
+    float remaining = lookaheadDistance - length(target - pos);
+    for (int visited = 0; remaining > 0.f && visited < n; ++visited) {
+      const int next = (i + 1) % n;
+      const sf::Vector2f seg = path[next] - path[i];
+      const float segLen = length(seg);
+      if (segLen >= remaining) {
+        target = path[i] + seg * (remaining / segLen);
+        break;
+      }
+      remaining -= segLen;
+      i = next;
+      target = path[i];
+    }
+  }
+  else {
+    return;
+  }
+
+  // Tras un impacto no se acelera; con turbo de objeto se va por encima del máximo.
+  const float itemScale = (m_spinTime > 0.f) ? 0.f : (m_boostTime > 0.f) ? m_boostSpeedScale : 1.f;
+  const float desiredSpeed = m_maxSpeed * lineSpeed * m_speedScale * m_terrainScale * itemScale;
+  if (m_physicsDriven) {
+    m_physics->getParams().maxSpeed = m_maxSpeed;
+    m_physics->setTerrainScale(m_terrainScale);
+    m_physics->setInput(m_physics->steerTowards(pos, target, desiredSpeed));
+    m_physics->integrate(*xf, deltaTime, nullptr, m_spriteAngleOffset);
+    return;
+  }
+  xf->seek(target, desiredSpeed, deltaTime, arriveRadius);
 
-    /**
-     * @brief Reinici*
+  const sf::Vector2f moved = xf->getPosition() - pos;
+  if (length(moved) > 1e-4f) {
+    xf->setRotation(std::atan2(moved.y, moved.x) * kRadToDeg + m_spriteAngleOffset);
+  }
+}
@@ -1,61 +1,711 @@
-﻿#include <SFML/Graphics.hpp>
-#include <vector>
-#include <string>
-
-int main() {
-    // Crear ventana
-    sf::RenderWindow window(sf::VideoMode(800, 600), "ChrisEngine Test");
-
-    // Lista de archivos de personajes
-    std::vector<std::string> characters = {
-        "princesa.png",
-        "sonic.png",
-        "virdo.png",
-        "wario.png"
-    };
-
-    // Vector de sprites
-    std::vector<sf::Sprite> sprites;
-    std::vector<sf::Texture> textures; // Guardamos texturas para que no se destruyan
-
-    // Cargar textura de la pista
-    sf::Texture trackTexture;
-    if (!trackTexture.loadFromFile("pista de carreras.png")) return -1;
-    sf::Sprite trackSprite(trackTexture);
-    trackSprite.setPosition(0.f, 0.f); // Coloca la pista en el origen
-
-    // Cargar personajes
-    float startX = 100.f;
-    float startY = 100.f;
-    for (auto& file : characters) {
-        sf::Texture tex;
-        if (!tex.loadFromFile(file)) return -1;
-        sf::Sprite spr(tex);
-        spr.setPosition(startX, startY);
-        startY += 100.f; // Separar personajes verticalmente
-        textures.push_back(tex);  // Guardar la textura
-        sprites.push_back(spr);   // Guardar el sprite
-    }
-
-    // Bucle principal
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
+#include "BaseApp.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  constexpr const char* kLastReplayPath = "bin/last_race.replay";
+  constexpr const char* kGhostPath = "bin/best_lap.ghost";
+  constexpr const char* kTrackChunksBase = "bin/pista de carreras"; ///< Pista troceada (--chunk-track).
+
+  constexpr float kDegToRad = 0.0174532925f;
+  constexpr float kEffectsTopSpeed = 300.f;  ///< px/s a los que polvo y escape van a tope.
+
+  // Capas de m_spriteBatch (las menores debajo).
+  constexpr int kTrackLayer = 0;
+  constexpr int kGhostLayer = 1;
+  constexpr int kItemLayer = 2;
+  constexpr int kKartLayer = 3;
+
+  // Vista Mode 7 (px de pista).
+  constexpr float kMode7Behind = 70.f;     ///< Cámara por detrás del kart seguido.
+  constexpr float kMode7KartScale = 1.f;   ///< Tamaño de los billboards respecto al sprite cenital.
+  constexpr int kKartDirections = 16;      ///< Fotogramas de las hojas horneadas (--bake-sprites por defecto).
+  /// Puntos del minimapa por índice de parrilla (el jugador va en blanco).
+  constexpr std::array<sf::Color, 4> kMinimapColors = { sf::Color(255, 110, 180), sf::Color(60, 120, 255),
+                                                        sf::Color(90, 220, 90), sf::Color(250, 210, 40) };
+
+  // Imágenes de objetos que van al atlas con los personajes (bin/<nombre>.png; opcionales:
+  // sin imagen se dibujan con formas).
+  constexpr const char* kBoxImage = "caja";
+  constexpr const char* kBananaImage = "platano";
+  constexpr const char* kGreenShellImage = "caparazon verde";
+  constexpr const char* kRedShellImage = "caparazon rojo";
+
+  /**
+   * Recorte de atlas centrado en @p center y escalado a @p diameter px de ancho.
+   */
+  sf::Transform regionTransform(const TextureAtlas::Region& region, const sf::Vector2f& center, float diameter) {
+    const sf::Vector2f size(region.rect.size);
+    sf::Transform transform;
+    transform.translate(center);
+    transform.scale(sf::Vector2f(diameter / size.x, diameter / size.x));
+    transform.translate(-0.5f * size);
+    return transform;
+  }
+
+  /**
+   * Círculo de @p radius px (con los lados de sf::CircleShape) y borde de @p outline px,
+   * centrado en el origen de @p shape.
+   */
+  void setCircle(CShape& shape, float radius, float outline) {
+    ShapeGeometry::Key key = ShapeGeometry::defaultKey(ShapeType::CIRCLE);
+    key.width = radius;
+    key.height = radius;
+    key.outline = outline;
+    shape.setGeometry(key);
+    shape.setOrigin({ radius, radius });
+  }
+
+  bool keyDown(sf::Keyboard::Key a, sf::Keyboard::Key b) {
+    return sf::Keyboard::isKeyPressed(a) || sf::Keyboard::isKeyPressed(b);
+  }
+}
+
+BaseApp::~BaseApp() {
+}
+
+int BaseApp::run() {
+  if (!init()) {
+    ERROR("BaseApp", "run", "init() failed");
+  }
+
+  while (m_windowPtr->isOpen()) {
+    m_windowPtr->handleEvents([this](const sf::Event& event) {
+      gui.processEvent(m_windowPtr, event);
+      if (const auto* key = event.getIf<sf::Event::KeyPressed>()) {
+        if (key->code == sf::Keyboard::Key::M) {
+          // Sólo cambia la vista: vale también viendo una grabación. Con la pista por chunks
+          // Mode 7 no tiene imagen del suelo, así que se queda la vista cenital.
+          m_mode7Enabled = !m_mode7Enabled && !m_trackStreamer.isOpen();
+          return;
+        }
+        if (m_watching && key->code != sf::Keyboard::Key::Escape) {
+          return; // la grabación decide quién conduce
+        }
+        switch (key->code) {
+        case sf::Keyboard::Key::Num0: m_sim.setPlayer(-1); break;
+        case sf::Keyboard::Key::Num1: m_sim.setPlayer(0);  break;
+        case sf::Keyboard::Key::Num2: m_sim.setPlayer(1);  break;
+        case sf::Keyboard::Key::Num3: m_sim.setPlayer(2);  break;
+        case sf::Keyboard::Key::Num4: m_sim.setPlayer(3);  break;
+        case sf::Keyboard::Key::Escape: m_windowPtr->close(); break;
+        default: break;
+        }
+      }
+      });
+    m_windowPtr->update();
+    const sf::Time frameTime = m_windowPtr->deltaTime;
+
+    if (gui.shouldQuit()) {
+      m_windowPtr->close();
+      break;
+    }
+    if (gui.shouldResetWaypoints()) {
+      if (m_watching) {
+        m_replay.rewind();
+        m_sim.setPlayer(-1); // misma parrilla y corredores: basta volver a la salida
+        m_sim.reset();
+      }
+      else {
+        m_replay.save(kLastReplayPath);
+        startRecording();
+      }
+      m_particles.clear();
+      m_timestep.reset();
+    }
+
+    // Paso fijo: el tiempo real (escalado por la GUI) se acumula y se consume
+    // en ticks de duración constante; el render interpola el resto.
+    if (!gui.isPaused()) {
+      const int steps = m_timestep.advance(frameTime.asSeconds() * gui.getSpeedMultiplier());
+      for (int i = 0; i < steps; ++i) {
+        fixedUpdate(m_timestep.getStep());
+      }
+    }
+
+    gui.update(m_windowPtr, frameTime, m_sim.getRaceTime());
+    updateCamera(frameTime.asSeconds(), m_timestep.getAlpha());
+    render(m_timestep.getAlpha());
+  }
+
+  destroy();
+  return 0;
+}
+
+bool BaseApp::init() {
+  m_windowPtr = EngineUtilities::MakeShared<Window>(1024, 768, "ChrisEngine - Mario Kart");
+  if (!m_windowPtr || !m_windowPtr->isOpen()) {
+    ERROR("BaseApp", "init", "m_windowPtr");
+    return false;
+  }
+  gui.init(m_windowPtr);
+
+  // --- Carrera ---
+  if (m_watching) {
+    m_timestep.setHz(m_replay.getSetup().hz);
+    if (!m_replay.apply(m_sim)) {
+      std::cerr << "BaseApp::init : falta la superficie de la imagen de la pista; la reproducción divergirá\n";
+    }
+  }
+  else {
+    m_sim.setItemsEnabled(true);
+    m_sim.setupDefaultRace();
+  }
+
+  // --- Recursos ---
+  // Personajes y objetos comparten páginas de atlas: SpriteBatch los dibuja juntos.
+  // La pista, mucho mayor, sigue siendo una textura aparte.
+  const auto& characters = RaceSimulation::defaultCharacters();
+  std::vector<std::string> atlasImages(characters.begin(), characters.end());
+  atlasImages.insert(atlasImages.end(), { kBoxImage, kBananaImage, kGreenShellImage, kRedShellImage });
+  for (const auto& name : characters) {
+    atlasImages.push_back(DirectionalSprite::sheetName(name)); // opcional: sin hoja, billboard cenital
+  }
+  resourceMan.loadAtlas(atlasImages);
+  // Con la pista troceada sólo se cargan los chunks cercanos a la cámara; si no, la imagen entera.
+  const bool streamedTrack = m_trackStreamer.open(kTrackChunksBase);
+  if (!streamedTrack) {
+    resourceMan.loadTexture("pista de carreras");
+  }
+  for (const auto& name : characters) {
+    resourceMan.loadTexture(name);
+  }
+  m_boxRegion = resourceMan.getAtlasRegion(kBoxImage);
+  m_projectileRegions[static_cast<std::size_t>(ItemSystem::Item::Banana)] = resourceMan.getAtlasRegion(kBananaImage);
+  m_projectileRegions[static_cast<std::size_t>(ItemSystem::Item::GreenShell)] = resourceMan.getAtlasRegion(kGreenShellImage);
+  m_projectileRegions[static_cast<std::size_t>(ItemSystem::Item::RedShell)] = resourceMan.getAtlasRegion(kRedShellImage);
+
+  // --- Escena ---
+  m_trackActor = EngineUtilities::MakeShared<Actor>("Track");
+  sf::Vector2f trackSize(m_windowPtr->getSize()); // sin imagen, la calzada generada cabe en la ventana
+  const sf::Texture* trackImage = nullptr;
+  if (streamedTrack) {
+    trackSize = m_trackStreamer.getSize();
+    m_camera.setBounds(sf::FloatRect({ 0.f, 0.f }, trackSize));
+  }
+  else if (auto trackTexture = resourceMan.getTexture("pista de carreras")) {
+    trackTexture->setOrigin({ 0.f, 0.f }); // mundo = píxeles de la imagen
+    m_trackActor->setTexture(trackTexture);
+    trackImage = &trackTexture->getTexture();
+    trackSize = sf::Vector2f(trackImage->getSize());
+    m_camera.setBounds(sf::FloatRect({ 0.f, 0.f }, trackSize));
+    m_mode7.setTrack(trackTexture->getTexture().copyToImage());
+  }
+  m_mode7.setSkyColor(sf::Color(110, 170, 240));
+  m_mode7.setSize(m_windowPtr->getSize().x, m_windowPtr->getSize().y);
+  for (auto& racer : m_sim.getRacers()) {
+    auto texture = resourceMan.getTexture(racer->getName());
+    racer->setTexture(texture);
+    const TextureAtlas::Region sheet = resourceMan.getAtlasRegion(DirectionalSprite::sheetName(racer->getName()));
+    const sf::Sprite* sprite = texture ? texture->getSprite() : nullptr;
+    if (sheet.texture && sprite) {
+      // La celda horneada abarca la diagonal del sprite cenital.
+      const sf::Vector2f size(sprite->getTextureRect().size);
+      const float worldWidth = std::sqrt(size.x * size.x + size.y * size.y) * racer->getComponent<Transform>()->getScale().x;
+      auto directional = EngineUtilities::MakeShared<DirectionalSprite>(sheet, kKartDirections, worldWidth);
+      if (directional->isValid()) {
+        racer->addComponent(directional);
+      }
+      else {
+        std::cerr << "BaseApp::init : la hoja de " << racer->getName() << " no tiene " << kKartDirections << " direcciones\n";
+      }
+    }
+  }
+  setupEffects();
+
+  // --- Cámara: sigue al jugador (o al líder) sin salirse de la pista ---
+  m_camera.setViewportSize(sf::Vector2f(m_windowPtr->getSize()));
+  if (auto xf = cameraTarget()) {
+    m_camera.reset(xf->getPosition());
+  }
+
+  // --- Superficie: desde la imagen de la pista (cacheada en disco) si encaja con
+  // la línea de carrera; si no, o si la pista va por chunks (no se carga la imagen
+  // entera), se queda la calzada generada por RaceSimulation.
+  if (!m_watching) {
+    if (!streamedTrack) {
+      m_imageSurface = m_sim.loadDefaultTrackSurface();
+      if (!m_imageSurface) {
+        std::cerr << "BaseApp::init : la imagen de la pista no cubre la línea de carrera; se usa la calzada generada\n";
+      }
+    }
+    if (m_sim.loadDefaultRacingLine()) {
+      MESSAGE("BaseApp", "init", "bin/pista de carreras.line");
+    }
+    startRecording();
+  }
+
+  // --- Minimapa: la pista (o, troceada, la línea de carrera) se pinta una vez ---
+  if (m_minimap.build(trackSize, trackImage, m_sim.getSpline().get())) {
+    m_minimap.setDotCount(m_sim.getRacers().size());
+  }
+
+  // --- Fantasma: la mejor vuelta guardada en sesiones anteriores ---
+  m_ghost = EngineUtilities::MakeShared<A_Ghost>();
+  auto bestLap = EngineUtilities::MakeShared<GhostLap>();
+  if (bestLap->load(kGhostPath)) {
+    m_ghost->setLap(bestLap);
+    m_ghost->setGhostTexture(resourceMan.getTexture(bestLap->getRacerName()));
+  }
+
+  gui.setRacers(m_sim.getRacers());
+  gui.setRanking(&m_sim.getRanking());
+  gui.setLapTimer(&m_sim.getLapTimer());
+  gui.setItems(m_sim.areItemsEnabled() ? &m_sim.getItems() : nullptr);
+  gui.setSpriteBatch(&m_spriteBatch);
+  gui.setTrackStreamer(streamedTrack ? &m_trackStreamer : nullptr);
+  return true;
+}
+
+void BaseApp::destroy() {
+  if (!m_watching && m_replay.getTickCount() > 0 && !m_replay.save(kLastReplayPath)) {
+    std::cerr << "BaseApp::destroy : no se pudo guardar " << kLastReplayPath << "\n";
+  }
+  gui.destroy();
+  m_kartEffects.clear();
+  m_sim.clearRacers();
+  m_particles.clear();
+  m_trackActor.reset();
+  m_ghost.reset();
+  if (m_windowPtr) {
+    m_windowPtr->destroy();
+  }
+}
+
+void BaseApp::updatePlayerControl(float /*dt*/) {
+  if (m_sim.getPlayer() < 0) {
+    return;
+  }
+  using Key = sf::Keyboard::Key;
+  RaceSimulation::PlayerInput input;
+  input.throttle = (keyDown(Key::Up, Key::W) ? 1.f : 0.f) - (keyDown(Key::Down, Key::S) ? 1.f : 0.f);
+  input.steer = (keyDown(Key::Right, Key::D) ? 1.f : 0.f) - (keyDown(Key::Left, Key::A) ? 1.f : 0.f);
+  input.drift = keyDown(Key::Space, Key::LShift);
+  // Un objeto por pulsación: mantener la tecla no dispara cada objeto nuevo al recogerlo.
+  const bool itemKeyDown = keyDown(Key::E, Key::RControl);
+  input.useItem = itemKeyDown && !m_itemKeyWasDown;
+  m_itemKeyWasDown = itemKeyDown;
+  m_sim.setPlayerInput(input);
+}
+
+bool BaseApp::watchReplay(const std::string& path) {
+  m_watching = m_replay.load(path);
+  return m_watching;
+}
+
+void BaseApp::startRecording() {
+  m_sim.reset();
+  m_ghostRacer = -1;
+  m_replay.begin(RaceReplay::capture(m_sim, m_timestep.getHz(), m_imageSurface));
+}
+
+void BaseApp::fixedUpdate(float dt) {
+  updateEffects(dt);
+  if (m_watching) {
+    m_replay.playStep(m_sim, dt); // al acabar la grabación la carrera se queda congelada
+  }
+  else {
+    updatePlayerControl(dt);
+    m_replay.recordStep(m_sim, dt);
+    updateGhost();
+  }
+  m_particles.update(dt);
+}
+
+void BaseApp::setupEffects() {
+  // Punto blanco difuminado: cada lote lo tiñe con el color de sus partículas.
+  const unsigned size = 16;
+  sf::Image dot({ size, size }, sf::Color::Transparent);
+  for (unsigned y = 0; y < size; ++y) {
+    for (unsigned x = 0; x < size; ++x) {
+      const float dx = (x + 0.5f) / size * 2.f - 1.f;
+      const float dy = (y + 0.5f) / size * 2.f - 1.f;
+      const float fade = std::max(0.f, 1.f - std::sqrt(dx * dx + dy * dy));
+      dot.setPixel({ x, y }, sf::Color(255, 255, 255, static_cast<std::uint8_t>(255.f * fade * fade)));
+    }
+  }
+  if (!m_particleTexture.loadFromImage(dot)) {
+    std::cerr << "BaseApp::setupEffects : no se pudo crear la textura de partículas\n";
+  }
+  m_particleTexture.setSmooth(true);
+
+  // Orden de dibujo = orden de los lotes: humo y polvo debajo, chispas (aditivas) encima.
+  const std::size_t smokeBatch = m_particles.addBatch(&m_particleTexture, sf::BlendAlpha, 2048, 1.5f);
+  const std::size_t dustBatch = m_particles.addBatch(&m_particleTexture, sf::BlendAlpha, 4096, 2.f);
+  const std::size_t sparkBatch = m_particles.addBatch(&m_particleTexture, sf::BlendAdd, 4096, 4.f);
+
+  m_kartEffects.clear();
+  for (auto& racer : m_sim.getRacers()) {
+    auto xf = racer->getComponent<Transform>();
+    // Los emisores van en ejes del sprite: el morro apunta a -spriteAngleOffset.
+    const float forward = -racer->getSpriteAngleOffset();
+    const sf::Vector2f tail{ -14.f * std::cos(forward * kDegToRad), -14.f * std::sin(forward * kDegToRad) };
+
+    ParticleEmitter::Params exhaust;
+    exhaust.batch = smokeBatch;
+    exhaust.rate = 25.f;
+    exhaust.offset = tail;
+    exhaust.direction = forward + 180.f;
+    exhaust.spread = 12.f;
+    exhaust.lifeMin = 0.4f;
+    exhaust.lifeMax = 0.8f;
+    exhaust.growth = 6.f;
+    exhaust.color = sf::Color(200, 200, 200, 90);
+    exhaust.inherit = 0.3f;
+
+    ParticleEmitter::Params dust = exhaust;
+    dust.batch = dustBatch;
+    dust.rate = 60.f;
+    dust.spread = 35.f;
+    dust.speedMin = 30.f;
+    dust.speedMax = 80.f;
+    dust.lifeMin = 0.5f;
+    dust.lifeMax = 1.f;
+    dust.size = 4.f;
+    dust.growth = 10.f;
+    dust.color = sf::Color(150, 120, 70, 140);
+    dust.inherit = 0.2f;
+
+    ParticleEmitter::Params sparks = exhaust;
+    sparks.batch = sparkBatch;
+    sparks.rate = 90.f;
+    sparks.spread = 60.f;
+    sparks.speedMin = 60.f;
+    sparks.speedMax = 160.f;
+    sparks.lifeMin = 0.15f;
+    sparks.lifeMax = 0.35f;
+    sparks.size = 1.5f;
+    sparks.growth = 0.f;
+    sparks.color = sf::Color(255, 170, 40);
+    sparks.inherit = 0.5f;
+
+    KartEffects effects;
+    effects.exhaust = EngineUtilities::MakeShared<ParticleEmitter>(m_particles, xf, exhaust);
+    effects.dust = EngineUtilities::MakeShared<ParticleEmitter>(m_particles, xf, dust);
+    effects.sparks = EngineUtilities::MakeShared<ParticleEmitter>(m_particles, xf, sparks);
+    racer->addComponent(effects.exhaust);
+    racer->addComponent(effects.dust);
+    racer->addComponent(effects.sparks);
+    m_kartEffects.push_back(effects);
+  }
+  gui.setParticles(&m_particles);
+}
+
+void BaseApp::updateEffects(float dt) {
+  const auto& racers = m_sim.getRacers();
+  const TrackSurface* surface = m_sim.getSurface().get();
+  for (std::size_t i = 0; i < racers.size() && i < m_kartEffects.size(); ++i) {
+    const auto& racer = racers[i];
+    KartEffects& effects = m_kartEffects[i];
+    auto xf = racer->getComponent<Transform>();
+    if (!xf || racer->isFinished() || dt <= 0.f) {
+      effects.exhaust->setRateScale(0.f);
+      effects.dust->setRateScale(0.f);
+      effects.sparks->setRateScale(0.f);
+      continue;
+    }
+    const sf::Vector2f moved = xf->getPosition() - xf->getPreviousPosition();
+    const float pace = std::min(std::sqrt(moved.x * moved.x + moved.y * moved.y) / dt / kEffectsTopSpeed, 1.f);
+    const bool offroad = surface && surface->getSurface(xf->getPosition()) == TrackSurface::Surface::Offroad;
+    effects.exhaust->setRateScale(0.3f + 0.7f * pace);
+    effects.dust->setRateScale(offroad ? pace : 0.f);
+
+    // Chispas al derrapar: naranjas y azules cuando el mini-turbo ya está cargado.
+    const KartPhysics& kart = *racer->getPhysics();
+    const bool drifting = racer->isPhysicsDriven() && kart.isDrifting();
+    effects.sparks->setRateScale(drifting ? 1.f : 0.f);
+    effects.sparks->getParams().color = (kart.getDriftTime() >= kart.getParams().miniTurboTime)
+      ? sf::Color(90, 160, 255) : sf::Color(255, 170, 40);
+  }
+}
+
+void BaseApp::updateGhost() {
+  const int player = m_sim.getPlayer();
+  const LapTimer& timer = m_sim.getLapTimer();
+  if (player < 0 || static_cast<std::size_t>(player) >= timer.size()) {
+    m_ghostRacer = -1;
+    return;
+  }
+  const auto& racer = m_sim.getRacers()[player];
+  const LapTimer::LapRecord& rec = timer.getRecord(player);
+  auto xf = racer->getComponent<Transform>();
+  if (!xf || !rec.started) {
+    return;
+  }
+
+  const float now = m_sim.getRaceTime();
+  if (player != m_ghostRacer || rec.lap != m_ghostLap) {
+    if (player == m_ghostRacer && m_ghostValid && rec.lap == m_ghostLap + 1) {
+      // Vuelta cerrada: último punto pasada la meta y duración exacta de LapTimer.
+      m_ghostRecording.record(now - rec.lapStart + rec.lastLap, xf->getPosition(), xf->getRotation());
+      m_ghostRecording.finish(rec.lastLap);
+      const auto& best = m_ghost->getLap();
+      if (!best || rec.lastLap < best->getDuration()) {
+        m_ghost->setLap(EngineUtilities::MakeShared<GhostLap>(m_ghostRecording));
+        m_ghost->setGhostTexture(resourceMan.getTexture(racer->getName()));
+        if (!m_ghostRecording.save(kGhostPath)) {
+          std::cerr << "BaseApp::updateGhost : no se pudo guardar " << kGhostPath << "\n";
         }
+      }
+    }
+    // Sólo se graba una vuelta entera: la que empieza en este mismo tick.
+    m_ghostRacer = player;
+    m_ghostLap = rec.lap;
+    m_ghostValid = (now - rec.lapStart <= m_timestep.getStep() + 1e-4f);
+    m_ghostRecording.begin(racer->getName());
+    if (m_ghostValid) {
+      m_ghostRecording.record(now - m_timestep.getStep() - rec.lapStart,
+        xf->getPreviousPosition(), xf->getInterpolatedRotation(0.f));
+    }
+  }
+  if (m_ghostValid && !racer->isFinished()) {
+    m_ghostRecording.record(now - rec.lapStart, xf->getPosition(), xf->getRotation());
+  }
+}
 
-        window.clear(sf::Color::Black);
+void BaseApp::placeGhost(float alpha) {
+  const int player = m_sim.getPlayer();
+  if (!m_ghost || player < 0 || static_cast<std::size_t>(player) >= m_sim.getLapTimer().size()
+      || m_sim.getRacers()[player]->isFinished()) {
+    if (m_ghost) {
+      m_ghost->hide();
+    }
+    return;
+  }
+  // Mismo instante que el kart interpolado: entre el tick anterior y el actual.
+  const LapTimer::LapRecord& rec = m_sim.getLapTimer().getRecord(player);
+  const float time = m_sim.getRaceTime() - (1.f - alpha) * m_timestep.getStep() - rec.lapStart;
+  if (rec.started) {
+    m_ghost->setLapTime(time);
+  }
+  else {
+    m_ghost->hide();
+  }
+}
 
-        // Dibujar pista
-        window.draw(trackSprite);
+EngineUtilities::TSharedPointer<A_Racer> BaseApp::followedRacer() const {
+  const auto& racers = m_sim.getRacers();
+  const int player = m_sim.getPlayer();
+  const auto& order = m_sim.getRanking().getOrder();
+  if (player >= 0 && static_cast<std::size_t>(player) < racers.size()) {
+    return racers[player];
+  }
+  if (!order.empty() && order.front() < racers.size()) {
+    return racers[order.front()]; // sin jugador (repetición): el líder
+  }
+  return EngineUtilities::TSharedPointer<A_Racer>();
+}
 
-        // Dibujar personajes
-        for (auto& spr : sprites)
-            window.draw(spr);
+EngineUtilities::TSharedPointer<Transform> BaseApp::cameraTarget() const {
+  auto racer = followedRacer();
+  return racer ? racer->getComponent<Transform>() : EngineUtilities::TSharedPointer<Transform>();
+}
 
-        window.display();
+void BaseApp::updateCamera(float dt, float alpha) {
+  if (auto xf = cameraTarget()) {
+    const sf::Vector2f velocity = (xf->getPosition() - xf->getPreviousPosition()) * m_timestep.getHz();
+    m_camera.follow(xf->getInterpolatedPosition(alpha), velocity, dt);
+  }
+  m_camera.apply(*m_windowPtr);
+}
+
+void BaseApp::render(float alpha) {
+  m_windowPtr->clear();
+  m_spriteBatch.beginFrame();
+  if (m_mode7Enabled) {
+    renderMode7(alpha);
+    renderMinimap(alpha);
+    gui.render(m_windowPtr);
+    m_windowPtr->display();
+    return;
+  }
+  // Lo que no toca la vista no genera vértices (las partículas se siguen simulando).
+  const sf::FloatRect visible = m_camera.getVisibleRect();
+  m_spriteBatch.setCullRect(visible);
+  m_particles.setCullRect(visible);
+  if (m_trackStreamer.isOpen()) {
+    m_trackStreamer.update(visible);
+    m_trackStreamer.submit(m_spriteBatch, visible, kTrackLayer);
+  }
+  else if (m_trackActor) {
+    submitActor(*m_trackActor, kTrackLayer);
+  }
+  placeGhost(alpha);
+  if (m_ghost) {
+    submitActor(*m_ghost, kGhostLayer);
+  }
+  m_spriteBatch.flush(m_windowPtr);
+  m_particles.render(m_windowPtr);
+  renderItems();
+  for (auto& racer : m_sim.getRacers()) {
+    racer->interpolate(alpha);
+    submitActor(*racer, kKartLayer);
+  }
+  m_spriteBatch.flush(m_windowPtr);
+  m_windowPtr->resetView();
+  renderMinimap(alpha);
+  gui.render(m_windowPtr);
+  m_windowPtr->display();
+}
+
+void BaseApp::renderMode7(float alpha) {
+  auto& racers = m_sim.getRacers();
+  for (auto& racer : racers) {
+    racer->interpolate(alpha);
+  }
+
+  // Suelo: la cámara va detrás del kart seguido, mirando hacia donde apunta su morro.
+  m_windowPtr->resetView();
+  m_spriteBatch.clearCullRect();
+  m_particles.clearCullRect();
+  const sf::Vector2u size = m_windowPtr->getSize();
+  m_mode7.setSize(size.x, size.y);
+  Mode7Renderer::View view;
+  view.focal = 0.5f * static_cast<float>(size.x);
+  if (auto followed = followedRacer()) {
+    auto xf = followed->getComponent<Transform>();
+    const float heading = (xf->getInterpolatedRotation(alpha) - followed->getSpriteAngleOffset()) * kDegToRad;
+    const sf::Vector2f forward{ std::cos(heading), std::sin(heading) };
+    view.position = xf->getInterpolatedPosition(alpha) - forward * kMode7Behind;
+    view.angle = heading;
+  }
+  if (m_mode7.render(view) || m_mode7Texture.getSize() != m_mode7.getSize()) {
+    m_mode7.upload(m_mode7Texture);
+  }
+  m_spriteBatch.draw(&m_mode7Texture, sf::IntRect({ 0, 0 }, sf::Vector2i(size)), sf::Transform::Identity,
+    sf::Color::White, kTrackLayer);
+
+  // Karts, de lejos a cerca. Con hoja horneada (DirectionalSprite) se elige el fotograma
+  // del ángulo de vista y se dibuja sin girar, centrado en su punto del suelo; sin hoja,
+  // el sprite cenital de pie. Una capa nueva sólo cuando cambia la textura, para que el
+  // orden no dependa del orden por textura del lote: con el atlas sale una sola llamada.
+  struct Billboard {
+    const sf::Texture* texture;
+    sf::IntRect        rect;
+    sf::Color          color;
+    sf::Vector2f       screen;
+    float              depthScale;  ///< px de pantalla por px de pista.
+    float              texelScale;  ///< px de pista por texel.
+    float              anchor;      ///< Fracción del alto por encima del punto del suelo.
+  };
+  std::vector<Billboard> billboards;
+  billboards.reserve(racers.size());
+  for (auto& racer : racers) {
+    auto xf = racer->getComponent<Transform>();
+    Billboard billboard{ nullptr, {}, sf::Color::White, {}, 0.f, 0.f, 0.f };
+    if (!m_mode7.project(xf->getInterpolatedPosition(alpha), billboard.screen, billboard.depthScale)) {
+      continue;
     }
+    auto directional = racer->getComponent<DirectionalSprite>();
+    auto texture = racer->getComponent<Texture>();
+    const sf::Sprite* sprite = texture ? texture->getSprite() : nullptr;
+    if (directional) {
+      const float heading = (xf->getInterpolatedRotation(alpha) - racer->getSpriteAngleOffset()) * kDegToRad;
+      billboard.texture = directional->getTexture();
+      billboard.rect = directional->getFrameRect(directional->frameFor(heading, view.angle));
+      billboard.texelScale = directional->getWorldWidth() / static_cast<float>(billboard.rect.size.x);
+      billboard.anchor = 0.5f;
+    }
+    else if (sprite) {
+      billboard.texture = &sprite->getTexture();
+      billboard.rect = sprite->getTextureRect();
+      billboard.texelScale = sprite->getScale().x;
+      billboard.anchor = 1.f;
+    }
+    else {
+      continue;
+    }
+    if (sprite) {
+      billboard.color = sprite->getColor();
+    }
+    billboards.push_back(billboard);
+  }
+  std::sort(billboards.begin(), billboards.end(),
+    [](const Billboard& a, const Billboard& b) { return a.depthScale < b.depthScale; });
+  int layer = kKartLayer;
+  const sf::Texture* previous = nullptr;
+  for (const Billboard& billboard : billboards) {
+    if (previous && previous != billboard.texture) {
+      ++layer;
+    }
+    previous = billboard.texture;
+    const float scale = billboard.depthScale * billboard.texelScale * kMode7KartScale;
+    const sf::Vector2f frameSize(billboard.rect.size);
+    sf::Transform transform;
+    transform.translate(billboard.screen);
+    transform.scale({ scale, scale });
+    transform.translate({ -0.5f * frameSize.x, -billboard.anchor * frameSize.y });
+    m_spriteBatch.draw(billboard.texture, billboard.rect, transform, billboard.color, layer);
+  }
+  m_spriteBatch.flush(m_windowPtr);
+}
 
-    return 0;
+void BaseApp::renderMinimap(float alpha) {
+  const auto& racers = m_sim.getRacers();
+  m_minimap.setDotCount(racers.size());
+  const int player = m_sim.getPlayer();
+  for (std::size_t i = 0; i < racers.size(); ++i) {
+    const bool isPlayer = static_cast<int>(i) == player;
+    const sf::Color color = isPlayer ? sf::Color::White : kMinimapColors[i % kMinimapColors.size()];
+    m_minimap.setDot(i, racers[i]->getComponent<Transform>()->getInterpolatedPosition(alpha), color,
+      isPlayer ? 1.5f : 1.f);
+  }
+  m_minimap.render(m_windowPtr);
+}
+
+void BaseApp::submitActor(Actor& actor, int layer) {
+  if (!actor.submit(m_spriteBatch, layer)) {
+    m_spriteBatch.flush(m_windowPtr);
+    actor.render(m_windowPtr);
+  }
+}
+
+void BaseApp::renderItems() {
+  if (!m_sim.areItemsEnabled()) {
+    return;
+  }
+  const ItemSystem& items = m_sim.getItems();
+  const sf::FloatRect visible = m_camera.getVisibleRect(std::max(items.getBoxRadius(), items.getProjectileRadius()));
+
+  // Sin imagen, las formas van al mismo lote que los sprites: todas en una llamada.
+  const float boxRadius = items.getBoxRadius();
+  setCircle(m_boxShape, boxRadius, 2.f);
+  m_boxShape.setFillColor(sf::Color(255, 200, 40, 170));
+  m_boxShape.setOutlineColor(sf::Color::White);
+  for (std::size_t i = 0; i < items.getBoxCount(); ++i) {
+    if (!items.isBoxActive(i) || !visible.contains(items.getBoxPosition(i))) {
+      continue;
+    }
+    if (m_boxRegion.texture) {
+      m_spriteBatch.draw(m_boxRegion.texture, m_boxRegion.rect,
+        regionTransform(m_boxRegion, items.getBoxPosition(i), 2.f * boxRadius), sf::Color::White, kItemLayer);
+      continue;
+    }
+    m_boxShape.setPosition(items.getBoxPosition(i));
+    m_spriteBatch.draw(m_boxShape, kItemLayer);
+  }
+
+  const float radius = items.getProjectileRadius();
+  setCircle(m_projectileShape, radius, 1.f);
+  m_projectileShape.setOutlineColor(sf::Color::Black);
+  for (std::size_t i = 0; i < items.getLiveCount(); ++i) {
+    if (!visible.contains(items.getProjectilePosition(i))) {
+      continue;
+    }
+    const ItemSystem::Item type = items.getProjectileType(i);
+    const TextureAtlas::Region& region = m_projectileRegions[static_cast<std::size_t>(type)];
+    if (region.texture) {
+      m_spriteBatch.draw(region.texture, region.rect,
+        regionTransform(region, items.getProjectilePosition(i), 2.f * radius), sf::Color::White, kItemLayer);
+      continue;
+    }
+    switch (type) {
+    case ItemSystem::Item::Banana:     m_projectileShape.setFillColor(sf::Color::Yellow); break;
+    case ItemSystem::Item::GreenShell: m_projectileShape.setFillColor(sf::Color::Green);  break;
+    default:                           m_projectileShape.setFillColor(sf::Color::Red);    break;
+    }
+    m_projectileShape.setPosition(items.getProjectilePosition(i));
+    m_spriteBatch.draw(m_projectileShape, kItemLayer);
+  }
 }
@@ -1,62 +1,189 @@
-// ==================== Includes ====================
-#include "Component.h"
+#include "CShape.h"
 #include "Window.h"
-#include "Texture.h"
-#include "TSharedPointer.h"
-#include "Prerequisites.h" // Para ShapeType, ComponentType
-
-#include <SFML/Graphics.hpp> // Librera SFML
-
-// ==================== CShape para ChrisEngine ====================
-Clase CShape : Component{
-    ShapeType m_shapeType
-    TSharedPointer<sf::Shape> m_shapePtr
-
-    // --- Constructores ---
-    Constructor() :
-        Component(ComponentType::SHAPE),
-        m_shapeType(ShapeType::EMPTY)
-    {
-        createShape(ShapeType::CIRCLE) // placeholder
+
+#include <algorithm>
+
+namespace {
+  /**
+   * Color por defecto de cada primitiva (los que tenían las sf::Shape de antes).
+   */
+  sf::Color defaultColor(ShapeType type) {
+    switch (type) {
+    case ShapeType::CIRCLE:    return sf::Color::Green;
+    case ShapeType::RECTANGLE: return sf::Color::White;
+    case ShapeType::TRIANGLE:  return sf::Color::Blue;
+    case ShapeType::POLYGON:   return sf::Color::Red;
+    default:                   return sf::Color::White;
+    }
+  }
+
+  /**
+   * Coordenada de textura de la fracción @p uv de la caja de la geometría estirada sobre
+   * @p rect, igual que hace sf::Shape con su textureRect.
+   */
+  sf::Vector2f texCoordFor(const sf::Vector2f& uv, const sf::FloatRect& rect) {
+    return { rect.position.x + uv.x * rect.size.x, rect.position.y + uv.y * rect.size.y };
+  }
+
+  /**
+   * Zona de la textura que cubre la forma: el recorte del sprite (atlas) o la textura entera.
+   */
+  sf::FloatRect textureRectOf(const Texture& texture) {
+    if (const sf::Sprite* sprite = texture.getSprite()) {
+      return sf::FloatRect(sprite->getTextureRect());
+    }
+    return sf::FloatRect({ 0.f, 0.f }, sf::Vector2f(texture.getTexture().getSize()));
+  }
+
+  /**
+   * Textura de SFML a la que apuntan las coordenadas de textureRectOf().
+   */
+  const sf::Texture* sfTextureOf(const Texture& texture) {
+    if (const sf::Sprite* sprite = texture.getSprite()) {
+      return &sprite->getTexture();
     }
+    return &texture.getTexture();
+  }
+}
+
+CShape::CShape()
+  : Component(ComponentType::SHAPE)
+{
+  createShape(ShapeType::CIRCLE);
+}
+
+CShape::CShape(ShapeType shapeType)
+  : Component(ComponentType::SHAPE)
+{
+  createShape(shapeType);
+}
+
+CShape::CShape(const ShapeGeometry::Key& key, const sf::Color& color)
+  : Component(ComponentType::SHAPE),
+    m_fillColor(color)
+{
+  setGeometry(key);
+}
+
+void CShape::start() {}
+
+void CShape::update(float) {}
+
+void CShape::destroy() {}
+
+void CShape::createShape(ShapeType shapeType) {
+  setGeometry(ShapeGeometry::defaultKey(shapeType));
+  setFillColor(defaultColor(shapeType));
+}
+
+void CShape::setGeometry(const ShapeGeometry::Key& key) {
+  m_shapeType = key.type;
+  if (key.type == ShapeType::EMPTY) {
+    m_geometry.reset();
+    m_verticesDirty = true;
+    return;
+  }
+  if (m_geometry && m_geometry->getKey() == key) {
+    return; // Misma forma: ni búsqueda en la caché ni vértices nuevos.
+  }
+  m_geometry = ShapeGeometry::get(key);
+  m_verticesDirty = true;
+}
+
+void CShape::setPosition(float x, float y) {
+  m_transform.setPosition({ x, y });
+}
+
+void CShape::setPosition(const sf::Vector2f& position) {
+  m_transform.setPosition(position);
+}
+
+void CShape::setFillColor(const sf::Color& color) {
+  if (color != m_fillColor) {
+    m_fillColor = color;
+    m_verticesDirty = true;
+  }
+}
+
+void CShape::setOutlineColor(const sf::Color& color) {
+  if (color != m_outlineColor) {
+    m_outlineColor = color;
+    m_verticesDirty = true;
+  }
+}
+
+void CShape::setOutlineThickness(float thickness) {
+  if (!m_geometry) {
+    return;
+  }
+  ShapeGeometry::Key key = m_geometry->getKey();
+  key.outline = std::max(thickness, 0.f);
+  setGeometry(key);
+}
+
+void CShape::setRotation(float angleDegrees) {
+  m_transform.setRotation(sf::degrees(angleDegrees));
+}
+
+void CShape::setScale(const sf::Vector2f& scl) {
+  m_transform.setScale(scl);
+}
+
+void CShape::setOrigin(const sf::Vector2f& origin) {
+  m_transform.setOrigin(origin);
+}
+
+void CShape::setTexture(const EngineUtilities::TSharedPointer<Texture>& texture) {
+  m_texture = texture;
+  m_verticesDirty = true;
+}
+
+const sf::Texture* CShape::getDrawTexture() const {
+  return m_texture ? sfTextureOf(*m_texture) : nullptr;
+}
+
+void CShape::appendTo(sf::VertexArray& triangles) const {
+  if (!m_geometry) {
+    return;
+  }
+  const std::vector<sf::Vector2f>& local = m_geometry->getTriangles();
+  const std::vector<sf::Vector2f>& uv = m_geometry->getTexCoords();
+  const std::size_t fillCount = m_geometry->getFillCount();
+  const sf::Transform& transform = m_transform.getTransform();
+  const sf::FloatRect rect = m_texture ? textureRectOf(*m_texture) : sf::FloatRect();
+
+  const std::size_t first = triangles.getVertexCount();
+  triangles.resize(first + local.size());
+  for (std::size_t i = 0; i < local.size(); ++i) {
+    sf::Vertex& vertex = triangles[first + i];
+    vertex.position = transform.transformPoint(local[i]);
+    vertex.color = i < fillCount ? m_fillColor : m_outlineColor;
+    vertex.texCoords = texCoordFor(uv[i], rect);
+  }
+}
 
-    Constructor(shapeType : ShapeType) :
-        Component(ComponentType::SHAPE),
-        m_shapeType(ShapeType::EMPTY)
-    {
-        createShape(shapeType)
+void CShape::render(const EngineUtilities::TSharedPointer<Window>& window) {
+  if (!window || !m_geometry) {
+    return;
+  }
+  // Los vértices locales sólo se rehacen si cambió la forma, el color o la textura; la
+  // posición, el giro y la escala van en los RenderStates.
+  if (m_verticesDirty) {
+    const std::vector<sf::Vector2f>& local = m_geometry->getTriangles();
+    const std::vector<sf::Vector2f>& uv = m_geometry->getTexCoords();
+    const std::size_t fillCount = m_geometry->getFillCount();
+    const sf::FloatRect rect = m_texture ? textureRectOf(*m_texture) : sf::FloatRect();
+    m_vertices.resize(local.size());
+    for (std::size_t i = 0; i < local.size(); ++i) {
+      m_vertices[i].position = local[i];
+      m_vertices[i].color = i < fillCount ? m_fillColor : m_outlineColor;
+      m_vertices[i].texCoords = texCoordFor(uv[i], rect);
     }
+    m_verticesDirty = false;
+  }
 
-    // --- Crear shape segn tipo ---
-    Mtodo createShape(shapeType : ShapeType) :
-        m_shapeType = shapeType
-        switch shapeType :
-            case ShapeType::CIRCLE:
-                m_shapePtr = TSharedPointer::MakeShared<sf::CircleShape>(10.f)
-                m_shapePtr.setFillColor(sf::Color::Green)
-            case ShapeType::RECTANGLE:
-                m_shapePtr = TSharedPointer::MakeShared<sf::RectangleShape>(sf::Vector2f(100.f,50.f))
-                m_shapePtr.setFillColor(sf::Color::White)
-            case ShapeType::TRIANGLE:
-                tri = TSharedPointer::MakeShared<sf::ConvexShape>(3)
-                tri.setPoint(0, {0,0}); tri.setPoint(1, {50,100}); tri.setPoint(2, {100,0})
-                tri.setFillColor(sf::Color::Blue)
-                m_shapePtr = tri
-            case ShapeType::POLYGON:
-                poly = TSharedPointer::MakeShared<sf::ConvexShape>(5)
-                poly.setPoint(0,{0,0}); poly.setPoint(1,{50,100}); poly.setPoint(2,{100,0})
-                poly.setPoint(3,{75,-50}); poly.setPoint(4,{-25,-50})
-                poly.setFillColor(sf::Color::Red)
-                m_shapePtr = poly
-            default:
-                m_shapePtr.reset()
-                    // LOG_ERROR("CShape", "createShape", "Unknown shape type")
-
-        // --- Ciclo de vida ---
-        Mtodo start() {}
-        Mtodo update(dt : float) {}
-        Mtodo destroy() {}
-
-        // --- Render ---
-        Mtodo render(window : TSharedPointer<Window>) :
-            si
+  sf::RenderStates states;
+  states.transform = m_transform.getTransform();
+  states.texture = getDrawTexture();
+  window->draw(m_vertices, states);
+}
@@ -0,0 +1,44 @@
+#include "Camera.h"
+#include "Window.h"
+
+#include <algorithm>
+#include <cmath>
+
+void Camera::reset(const sf::Vector2f& center) {
+  m_center = center;
+  clampToBounds();
+}
+
+void Camera::follow(const sf::Vector2f& target, const sf::Vector2f& velocity, float dt) {
+  const sf::Vector2f goal = target + velocity * m_params.lookAhead;
+  const float t = 1.f - std::exp(-m_params.stiffness * dt);
+  m_center += (goal - m_center) * t;
+  clampToBounds();
+}
+
+sf::View Camera::getView() const {
+  return sf::View(m_center, getSize());
+}
+
+void Camera::apply(Window& window) const {
+  window.setView(getView());
+}
+
+sf::FloatRect Camera::getVisibleRect(float margin) const {
+  const sf::Vector2f size = getSize();
+  const sf::Vector2f half = size * 0.5f;
+  return sf::FloatRect(m_center - half - sf::Vector2f{ margin, margin },
+                       size + sf::Vector2f{ 2.f * margin, 2.f * margin });
+}
+
+void Camera::clampToBounds() {
+  if (m_bounds.size.x <= 0.f || m_bounds.size.y <= 0.f) {
+    return;
+  }
+  // Eje a eje: si el mundo es más pequeño que la vista, se centra.
+  const sf::Vector2f half = getSize() * 0.5f;
+  const sf::Vector2f min = m_bounds.position + half;
+  const sf::Vector2f max = m_bounds.position + m_bounds.size - half;
+  m_center.x = (min.x <= max.x) ? std::clamp(m_center.x, min.x, max.x) : m_bounds.position.x + m_bounds.size.x * 0.5f;
+  m_center.y = (min.y <= max.y) ? std::clamp(m_center.y, min.y, max.y) : m_bounds.position.y + m_bounds.size.y * 0.5f;
+}
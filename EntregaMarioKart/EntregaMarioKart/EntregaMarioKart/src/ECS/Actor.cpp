@@ -1,102 +1,78 @@
-#include <SFML/Graphics.hpp>
-#include <memory>
-#include <vector>
-#include <string>
-#include <iostream>
-
-// ------------------------------------------------
-// Clase Actor: representa corredor o pista
-// ------------------------------------------------
-class Actor {
-    sf::Sprite sprite;
-    sf::Texture texture;
-
-public:
-    std::string name;
-
-    Actor(const std::string& filename, const std::string& actorName) : name(actorName) {
-        if (!texture.loadFromFile(filename)) {
-            std::cerr << "Error cargando textura: " << filename << "\n";
-        }
-        sprite.setTexture(texture);
-        // Centrar origen para rotaciones escalado
-        sf::FloatRect bounds = sprite.getLocalBounds();
-        sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+#include "ECS/Actor.h"
+#include "SpriteBatch.h"
+#include "Window.h"
+
+void Actor::update(float deltaTime) {
+  auto xf = getComponent<Transform>();
+  if (xf) {
+    if (auto shape = getComponent<CShape>()) {
+      shape->setPosition(xf->getPosition());
+      shape->setRotation(xf->getRotation());
+      shape->setScale(xf->getScale());
     }
-
-    void setPosition(float x, float y) { sprite.setPosition(x, y); }
-    void setScale(float sx, float sy) { sprite.setScale(sx, sy); }
-    void setRotation(float angle) { sprite.setRotation(angle); }
-
-    void render(sf::RenderWindow& window) { window.draw(sprite); }
-};
-
-// ------------------------------------------------
-// Clase Window: encapsula sf::RenderWindow
-// ------------------------------------------------
-class ChrisEngineWindow {
-    std::unique_ptr<sf::RenderWindow> window;
-
-public:
-    ChrisEngineWindow(int width, int height, const std::string& title) {
-        window = std::make_unique<sf::RenderWindow>(sf::VideoMode(width, height), title);
-        window->setFramerateLimit(60);
+    if (auto tex = getComponent<Texture>()) {
+      tex->setPosition(xf->getPosition());
+      tex->setRotation(xf->getRotation());
+      tex->setScale(xf->getScale());
     }
+  }
 
-    bool isOpen() const { return window->isOpen(); }
-    void clear() { window->clear(sf::Color::Black); }
-    void display() { window->display(); }
-    void draw(sf::Drawable& drawable) { window->draw(drawable); }
-
-    void handleEvents() {
-        sf::Event event;
-        while (window->pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window->close();
-        }
-    }
-
-    sf::RenderWindow& getInternal() { return *window; }
-};
-
-// ------------------------------------------------
-// Funcin principal
-// ------------------------------------------------
-int main() {
-    ChrisEngineWindow window(1024, 768, "ChrisEngine Carrera");
-
-    // Crear actores
-    Actor pista("pista de carreras.png", "Pista");
-    pista.setPosition(512, 384); // centro
-
-    Actor princesa("princesa.png", "Princesa");
-    princesa.setPosition(200, 600);
-
-    Actor sonic("sonic.png", "Sonic");
-    sonic.setPosition(400, 600);
-
-    Actor virdo("virdo.png", "Virdo");
-    virdo.setPosition(600, 600);
-
-    Actor wario("wario.png", "Wario");
-    wario.setPosition(800, 600);
-
-    std::vector<Actor*> racers = { &princesa, &sonic, &virdo, &wario };
+  for (auto& comp : components) {
+    comp->update(deltaTime);
+  }
+}
 
-    // Loop principal
-    while (window.isOpen()) {
-        window.handleEvents();
-        window.clear();
+void Actor::interpolate(float alpha) {
+  auto xf = getComponent<Transform>();
+  if (!xf) {
+    return;
+  }
+  if (auto shape = getComponent<CShape>()) {
+    xf->applyInterpolatedTo(shape->getTransformable(), alpha);
+  }
+  if (auto tex = getComponent<Texture>()) {
+    tex->setPosition(xf->getInterpolatedPosition(alpha));
+    tex->setRotation(xf->getInterpolatedRotation(alpha));
+    tex->setScale(xf->getScale());
+  }
+}
 
-        // Dibujar pista primero
-        pista.render(window.getInternal());
+void Actor::render(const EngineUtilities::TSharedPointer<Window>& window) {
+  // Con textura se dibuja el sprite; la shape queda como representación por defecto.
+  if (auto tex = getComponent<Texture>()) {
+    tex->render(window);
+    return;
+  }
+  for (auto& comp : components) {
+    comp->render(window);
+  }
+}
 
-        // Dibujar corredores
-        for (auto* r : racers)
-            r->render(window.getInternal());
+bool Actor::submit(SpriteBatch& batch, int layer) {
+  auto tex = getComponent<Texture>();
+  const sf::Sprite* sprite = tex ? tex->getSprite() : nullptr;
+  if (sprite) {
+    batch.draw(*sprite, layer);
+    return true;
+  }
+  // Sin textura la forma es la representación (como en render()) y va al mismo lote.
+  auto shape = tex ? EngineUtilities::TSharedPointer<CShape>() : getComponent<CShape>();
+  if (!shape) {
+    return false;
+  }
+  batch.draw(*shape, layer);
+  return true;
+}
 
-        window.display();
+void Actor::setTexture(const EngineUtilities::TSharedPointer<Texture>& texture) {
+  for (auto it = components.begin(); it != components.end(); ++it) {
+    if (it->template dynamic_pointer_cast<Texture>()) {
+      components.erase(it);
+      break;
     }
-
-    return 0;
+  }
+  if (texture) {
+    addComponent(texture);
+  }
+  Actor::update(0.f);
 }
@@ -0,0 +1,37 @@
+#include "ECS/DirectionalSprite.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  constexpr float kTwoPi = 6.28318531f;
+}
+
+int DirectionalSprite::columnsFor(int directions) {
+  return std::clamp(directions, 1, kMaxColumns);
+}
+
+DirectionalSprite::DirectionalSprite(const TextureAtlas::Region& sheet, int directions, float worldWidth)
+  : Component(ComponentType::DIRECTIONS)
+  , m_sheet(sheet)
+  , m_directions(std::max(directions, 1))
+  , m_columns(columnsFor(directions))
+  , m_worldWidth(worldWidth)
+{
+  const int rows = (m_directions + m_columns - 1) / m_columns;
+  if (m_sheet.rect.size.x % m_columns == 0 && m_sheet.rect.size.y % rows == 0) {
+    m_frameSize = { m_sheet.rect.size.x / m_columns, m_sheet.rect.size.y / rows };
+  }
+}
+
+int DirectionalSprite::frameFor(float heading, float cameraAngle) const {
+  const float step = kTwoPi / static_cast<float>(m_directions);
+  const int frame = static_cast<int>(std::floor((heading - cameraAngle) / step + 0.5f)) % m_directions;
+  return frame < 0 ? frame + m_directions : frame;
+}
+
+sf::IntRect DirectionalSprite::getFrameRect(int frame) const {
+  const int column = frame % m_columns;
+  const int row = frame / m_columns;
+  return sf::IntRect(m_sheet.rect.position + sf::Vector2i(column * m_frameSize.x, row * m_frameSize.y), m_frameSize);
+}
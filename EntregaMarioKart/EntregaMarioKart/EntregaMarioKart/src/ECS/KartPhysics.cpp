@@ -0,0 +1,190 @@
+#include "ECS/KartPhysics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  constexpr float kRadToDeg = 57.2957795f;
+  constexpr float kPi = 3.14159265f;
+  constexpr float kDriftSteer = 0.3f;   ///< Volante mínimo para empezar a derrapar.
+
+  float dot(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return a.x * b.x + a.y * b.y;
+  }
+}
+
+void KartPhysics::reset(float heading) {
+  m_velocity = { 0.f, 0.f };
+  m_heading = heading;
+  m_input = Input{};
+  m_drifting = false;
+  m_driftDir = 0.f;
+  m_driftTime = 0.f;
+  m_boostTime = 0.f;
+}
+
+KartPhysics::State KartPhysics::getState() const {
+  State state;
+  state.input = m_input;
+  state.velocity = m_velocity;
+  state.heading = m_heading;
+  state.driftDir = m_driftDir;
+  state.driftTime = m_driftTime;
+  state.boostTime = m_boostTime;
+  state.terrainScale = m_terrainScale;
+  state.drifting = m_drifting;
+  return state;
+}
+
+void KartPhysics::setState(const State& state) {
+  m_input = state.input;
+  m_velocity = state.velocity;
+  m_heading = state.heading;
+  m_driftDir = state.driftDir;
+  m_driftTime = state.driftTime;
+  m_boostTime = state.boostTime;
+  m_terrainScale = state.terrainScale;
+  m_drifting = state.drifting;
+}
+
+sf::Vector2f KartPhysics::getForward() const {
+  return { std::cos(m_heading), std::sin(m_heading) };
+}
+
+float KartPhysics::getForwardSpeed() const {
+  return dot(m_velocity, getForward());
+}
+
+int KartPhysics::integrate(Transform& xf, float deltaTime, const TrackSurface* surface,
+                           float spriteAngleOffset) {
+  if (deltaTime <= 0.f) {
+    return 0;
+  }
+  // Un pico de dt se parte en sub-pasos; más allá del tope se pierde tiempo
+  // simulado en vez de dar un salto que atraviese muros.
+  const int maxSteps = std::max(1, m_params.maxSubSteps);
+  const int steps = std::clamp(static_cast<int>(std::ceil(deltaTime / m_params.maxSubStep - 1e-4f)), 1, maxSteps);
+  const float h = std::min(deltaTime / static_cast<float>(steps), m_params.maxSubStep);
+  for (int i = 0; i < steps; ++i) {
+    subStep(xf, h, surface);
+  }
+  xf.setRotation(m_heading * kRadToDeg + spriteAngleOffset);
+  return steps;
+}
+
+void KartPhysics::updateDrift(float speed, float h) {
+  const bool canDrift = m_input.drift && speed > m_params.driftMinSpeed * m_params.maxSpeed;
+  if (!m_drifting) {
+    if (canDrift && std::abs(m_input.steer) > kDriftSteer) {
+      m_drifting = true;
+      m_driftDir = (m_input.steer > 0.f) ? 1.f : -1.f;
+      m_driftTime = 0.f;
+    }
+    return;
+  }
+  if (canDrift) {
+    m_driftTime += h;
+    return;
+  }
+  // Al soltar: turbo si el derrape duró lo suficiente.
+  if (m_driftTime >= m_params.miniTurboTime) {
+    m_boostTime = m_params.boostTime;
+  }
+  m_drifting = false;
+  m_driftTime = 0.f;
+}
+
+void KartPhysics::subStep(Transform& xf, float h, const TrackSurface* surface) {
+  const float throttle = std::clamp(m_input.throttle, -1.f, 1.f);
+  const float steer = std::clamp(m_input.steer, -1.f, 1.f);
+  updateDrift(getForwardSpeed(), h);
+
+  // Giro: a velocidad alta gira más; parado apenas gira. Derrapando siempre se
+  // gira hacia el lado del derrape y el volante sólo lo abre o lo cierra.
+  const float turnScale = std::clamp(std::abs(getForwardSpeed()) / m_params.maxSpeed, m_params.minTurnScale, 1.f);
+  float turn = steer;
+  if (m_drifting) {
+    turn = m_driftDir * (0.6f + 0.4f * steer * m_driftDir) * m_params.driftTurnScale;
+  }
+  m_heading += turn * m_params.turnRate * turnScale * h;
+  if (m_heading > kPi) {
+    m_heading -= 2.f * kPi;
+  }
+  else if (m_heading < -kPi) {
+    m_heading += 2.f * kPi;
+  }
+
+  // La velocidad se descompone en el rumbo nuevo: el agarre decide cuánto del giro
+  // se lleva la velocidad y cuánto queda como deslizamiento lateral.
+  const sf::Vector2f forward = getForward();
+  const sf::Vector2f right{ -forward.y, forward.x };
+  float speed = dot(m_velocity, forward);
+  float lateral = dot(m_velocity, right);
+
+  float top = m_params.maxSpeed;
+  if (m_boostTime > 0.f) {
+    top *= m_params.boostScale;
+    m_boostTime = std::max(0.f, m_boostTime - h);
+  }
+  const sf::Vector2f pos = xf.getPosition();
+  float terrain = m_terrainScale;
+  if (surface) {
+    terrain = (surface->getSurface(pos) != TrackSurface::Surface::Road) ? m_offroadSpeedScale : 1.f;
+  }
+  const float limit = top * terrain;
+
+  // Motor / freno (sólo empuja hasta el límite del terreno) y rozamiento sin gas.
+  if (throttle != 0.f) {
+    const bool braking = (throttle > 0.f) != (speed > 0.f) && speed != 0.f;
+    const float push = throttle * (braking ? m_params.brake : m_params.accel) * h;
+    if (push < 0.f || speed < limit) {
+      speed = std::min(speed + push, std::max(limit, speed));
+    }
+  }
+  else {
+    speed *= std::exp(-m_params.drag * h);
+  }
+  if (m_boostTime > 0.f && throttle >= 0.f && speed < limit) {
+    speed = std::min(speed + m_params.accel * h, limit);
+  }
+  // Fuera de pista el exceso se pierde poco a poco, no de golpe.
+  speed = std::min(speed, top);
+  if (speed > limit) {
+    speed = limit + (speed - limit) * std::exp(-m_params.offroadDrag * h);
+  }
+  speed = std::max(speed, -m_params.reverseScale * limit);
+  lateral *= std::exp(-(m_drifting ? m_params.driftGrip : m_params.grip) * h);
+  m_velocity = forward * speed + right * lateral;
+
+  // Semi-implícito: la posición avanza con la velocidad ya actualizada. Contra un
+  // muro se quita la componente que entra y se desliza a lo largo de él.
+  sf::Vector2f next = pos + m_velocity * h;
+  if (surface && surface->getSurface(next) == TrackSurface::Surface::Wall) {
+    const sf::Vector2f outward = surface->getGradient(next);
+    const float into = dot(m_velocity, outward);
+    if (into > 0.f) {
+      m_velocity -= outward * into;
+    }
+    next = pos + m_velocity * h;
+    if (surface->getSurface(next) == TrackSurface::Surface::Wall) {
+      next = pos;
+    }
+  }
+  xf.setPosition(next);
+}
+
+KartPhysics::Input KartPhysics::steerTowards(const sf::Vector2f& position, const sf::Vector2f& target,
+                                             float desiredSpeed) const {
+  Input input;
+  const sf::Vector2f toTarget = target - position;
+  float error = 0.f;
+  if (dot(toTarget, toTarget) > 1e-6f) {
+    error = std::atan2(toTarget.y, toTarget.x) - m_heading;
+    error = std::remainder(error, 2.f * kPi);
+  }
+  // Volante a fondo a partir de ~30 grados de error; frena si apunta muy lejos.
+  input.steer = std::clamp(error * 2.f, -1.f, 1.f);
+  const float wanted = desiredSpeed * std::max(0.3f, std::cos(error));
+  input.throttle = std::clamp((wanted - getForwardSpeed()) / (m_params.accel * 0.1f), -1.f, 1.f);
+  return input;
+}
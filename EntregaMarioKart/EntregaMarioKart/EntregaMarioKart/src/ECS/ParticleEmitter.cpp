@@ -0,0 +1,65 @@
+#include "ECS/ParticleEmitter.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace {
+  constexpr float kDegToRad = 0.0174532925f;
+}
+
+ParticleEmitter::ParticleEmitter(ParticleSystem& system, const EngineUtilities::TSharedPointer<Transform>& transform,
+                                 const Params& params)
+  : Component(ComponentType::PARTICLES)
+  , m_system(&system)
+  , m_transform(transform)
+  , m_params(params)
+{
+  // Semilla distinta por emisor: dos karts iguales no echan el mismo humo.
+  m_rng ^= static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(this) >> 4);
+  if (m_rng == 0) {
+    m_rng = 0x2545F491u;
+  }
+}
+
+void ParticleEmitter::update(float deltaTime) {
+  if (!m_system || !m_transform || deltaTime <= 0.f || m_rateScale <= 0.f) {
+    return;
+  }
+  m_pending += m_params.rate * m_rateScale * deltaTime;
+  const int count = static_cast<int>(m_pending);
+  if (count <= 0) {
+    return;
+  }
+  m_pending -= static_cast<float>(count);
+
+  const Transform& xf = *m_transform;
+  const float angle = xf.getRotation() * kDegToRad;
+  const float c = std::cos(angle);
+  const float s = std::sin(angle);
+  const sf::Vector2f offset{ m_params.offset.x * c - m_params.offset.y * s,
+                             m_params.offset.x * s + m_params.offset.y * c };
+  const sf::Vector2f from = xf.getPreviousPosition();
+  const sf::Vector2f moved = xf.getPosition() - from;
+  const sf::Vector2f inherited = moved * (m_params.inherit / deltaTime);
+
+  ParticleSystem::Spawn spawn;
+  spawn.size = m_params.size;
+  spawn.growth = m_params.growth;
+  spawn.color = m_params.color;
+  for (int i = 0; i < count; ++i) {
+    const float along = (static_cast<float>(i) + random01()) / static_cast<float>(count);
+    const float dir = (m_params.direction + (2.f * random01() - 1.f) * m_params.spread) * kDegToRad + angle;
+    const float speed = m_params.speedMin + (m_params.speedMax - m_params.speedMin) * random01();
+    spawn.position = from + moved * along + offset;
+    spawn.velocity = sf::Vector2f{ std::cos(dir), std::sin(dir) } * speed + inherited;
+    spawn.life = m_params.lifeMin + (m_params.lifeMax - m_params.lifeMin) * random01();
+    m_system->emit(m_params.batch, spawn);
+  }
+}
+
+float ParticleEmitter::random01() {
+  m_rng ^= m_rng << 13;
+  m_rng ^= m_rng >> 17;
+  m_rng ^= m_rng << 5;
+  return static_cast<float>(m_rng >> 8) * (1.f / 16777216.f);
+}
@@ -1,48 +1,182 @@
-// ==================== EngineGUI para ChrisEngine ====================
-class EngineGUI {
-    Theme m_currentTheme = Theme::Dark;
-    bool m_paused = false;
-    bool m_requestQuit = false;
-    bool m_requestReset = false;
-    float m_speedMultiplier = 1.0f;
-    std::vector<TSharedPointer<A_Racer>> m_racers;
-
-public:
-    // Inicializacin de ImGui-SFML
-    void init(const TSharedPointer<Window>& window) {
-        ImGui::SFML::Init(window->getInternal());
-        setTheme(m_currentTheme);
-    }
-
-    // Actualizacin de UI por frame
-    void update(const TSharedPointer<Window>& window, sf::Time deltaTime, float raceTimer) {
-        ImGui::SFML::Update(window->getInternal(), deltaTime);
-
-        renderMenuBar();
-        renderControlPanel();
-
-        // Stats de carrera
-        ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDecoration);
-        ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
-        ImGui::Text("Timer: %.2f s", raceTimer);
-        ImGui::End();
-
-        // Ventana de corredores/podio
-        ImGui::Begin("Racers / Podio", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
-
-        auto sorted = m_racers; // copia local
-        std::sort(sorted.begin(), sorted.end(),
-            [](auto& a, auto& b) { return a->getProgress() > b->getProgress(); });
-
-        int idx = 1;
-        for (auto& r : sorted) {
-            std::string label = std::to_string(idx) + ". " + r->getName() +
-                " (P" + std::to_string(r->getPlace() ? r->getPlace() : idx) + ")";
-            char buf[32];
-            std::snprintf(buf, 32, "%.1f%%", r->getProgress() * 100.f);
-            ImGui::Text("%s %s", label.c_str(), buf);
-
-            if (ImGui::SmallButton(("Reset##" + std::to_string(idx)).c_str()))
-                r->reset();
-            idx++;
-        }
+#include "EngineGUI.h"
+#include "A_Racer.h"
+#include "ItemSystem.h"
+#include "LapTimer.h"
+#include "ParticleSystem.h"
+#include "RaceRanking.h"
+#include "SpriteBatch.h"
+#include "TrackStreamer.h"
+#include "Window.h"
+
+#include <cstdio>
+#include <string>
+
+void EngineGUI::init(const EngineUtilities::TSharedPointer<Window>& window) {
+  if (!ImGui::SFML::Init(window->getInternal())) {
+    ERROR("EngineGUI", "init", "ImGui::SFML::Init");
+  }
+  setTheme(m_currentTheme);
+}
+
+void EngineGUI::update(const EngineUtilities::TSharedPointer<Window>& window,
+  sf::Time deltaTime,
+  float raceTimer) {
+  ImGui::SFML::Update(window->getInternal(), deltaTime);
+
+  renderMenuBar();
+  renderControlPanel();
+
+  // Stats de carrera
+  ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDecoration);
+  ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+  ImGui::Text("Timer: %.2f s", raceTimer);
+  if (m_particles) {
+    const ParticleSystem::Stats& stats = m_particles->getStats();
+    ImGui::Text("Particulas: %zu (%zu draw calls, %zu fuera de vista, %.2f + %.2f ms)", stats.quads,
+      stats.drawCalls, stats.culled, stats.updateSeconds * 1000.0, stats.buildSeconds * 1000.0);
+  }
+  if (m_spriteBatch) {
+    const SpriteBatch::Stats& stats = m_spriteBatch->getStats();
+    ImGui::Text("Sprites: %zu + %zu formas (%zu draw calls, %zu fuera de vista)", stats.quads, stats.shapes,
+      stats.drawCalls, stats.culled);
+  }
+  if (m_trackStreamer) {
+    const TrackStreamer::Stats& stats = m_trackStreamer->getStats();
+    ImGui::Text("Pista: %zu chunks (%.1f MB)%s, %zu pendientes, %zu cargas, %zu descargas", stats.resident,
+      stats.residentBytes / (1024.0 * 1024.0), stats.overBudget ? " SOBRE PRESUPUESTO" : "", stats.pending,
+      stats.loads, stats.evictions);
+  }
+  ImGui::End();
+
+  // Ventana de corredores/podio: el orden lo mantiene RaceRanking, aquí sólo se lee.
+  ImGui::Begin("Racers / Podio", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+  const std::size_t count = m_racers.size();
+  const bool ranked = m_ranking && m_ranking->size() == count;
+  for (std::size_t pos = 0; pos < count; ++pos) {
+    const std::size_t id = ranked ? m_ranking->getOrder()[pos] : pos;
+    auto& r = m_racers[id];
+    ImGui::Text("%zu. %-10s V%d/%d %5.1f%%%s", pos + 1, r->getName().c_str(),
+      r->getCurrentLap(), r->getTotalLaps(), r->getProgress() * 100.f,
+      r->getPlace() ? " (meta)" : "");
+    if (m_lapTimer && id < m_lapTimer->size()) {
+      const LapTimer::LapRecord& rec = m_lapTimer->getRecord(id);
+      ImGui::SameLine();
+      ImGui::Text(" S%d  ult %6.3f  mejor %6.3f", r->getSector() + 1, rec.lastLap, rec.bestLap);
+    }
+    if (m_items) {
+      static const char* const kItemNames[] = { "-", "platano", "verde", "rojo", "champi" };
+      const auto item = static_cast<std::size_t>(m_items->getHeld(id));
+      ImGui::SameLine();
+      ImGui::Text(" [%s]", item < 5 ? kItemNames[item] : "?");
+    }
+    ImGui::SameLine();
+    if (ImGui::SmallButton(("Reset##" + std::to_string(id)).c_str())) {
+      r->reset();
+    }
+  }
+  ImGui::End();
+}
+
+void EngineGUI::render(const EngineUtilities::TSharedPointer<Window>& window) {
+  ImGui::SFML::Render(window->getInternal());
+}
+
+void EngineGUI::destroy() {
+  ImGui::SFML::Shutdown();
+}
+
+void EngineGUI::processEvent(const EngineUtilities::TSharedPointer<Window>& window,
+  const sf::Event& event) {
+  ImGui::SFML::ProcessEvent(window->getInternal(), event);
+}
+
+void EngineGUI::setTheme(Theme theme) {
+  m_currentTheme = theme;
+  switch (theme) {
+  case Theme::Grey:             setupGreyGUIStyle(); break;
+  case Theme::Dark:             setupDarkGUIStyle(); break;
+  case Theme::VectonautaEngine: setupVectonautaEngineStyle(); break;
+  }
+}
+
+void EngineGUI::renderMenuBar() {
+  if (!ImGui::BeginMainMenuBar()) {
+    return;
+  }
+  if (ImGui::BeginMenu("File")) {
+    if (ImGui::MenuItem("Exit")) {
+      m_requestQuit = true;
+    }
+    ImGui::EndMenu();
+  }
+  if (ImGui::BeginMenu("Game")) {
+    if (ImGui::MenuItem(m_paused ? "Resume" : "Pause")) {
+      m_paused = !m_paused;
+    }
+    if (ImGui::MenuItem("Reset race")) {
+      m_requestReset = true;
+    }
+    ImGui::EndMenu();
+  }
+  if (ImGui::BeginMenu("Theme")) {
+    if (ImGui::MenuItem("Grey", nullptr, m_currentTheme == Theme::Grey)) {
+      setTheme(Theme::Grey);
+    }
+    if (ImGui::MenuItem("Dark", nullptr, m_currentTheme == Theme::Dark)) {
+      setTheme(Theme::Dark);
+    }
+    if (ImGui::MenuItem("VectonautaEngine", nullptr, m_currentTheme == Theme::VectonautaEngine)) {
+      setTheme(Theme::VectonautaEngine);
+    }
+    ImGui::EndMenu();
+  }
+  ImGui::EndMainMenuBar();
+}
+
+void EngineGUI::renderControlPanel() {
+  ImGui::Begin("Control", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+  if (ImGui::Button(m_paused ? "Resume" : "Pause")) {
+    m_paused = !m_paused;
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Reset")) {
+    m_requestReset = true;
+  }
+  ImGui::SliderFloat("Speed", &m_speedMultiplier, 0.1f, 3.0f, "%.1fx");
+  if (ImGui::Button("Exit")) {
+    m_requestQuit = true;
+  }
+  ImGui::End();
+}
+
+void EngineGUI::setupGreyGUIStyle() {
+  ImGui::StyleColorsLight();
+  ImGuiStyle& style = ImGui::GetStyle();
+  style.WindowRounding = 4.f;
+  style.FrameRounding = 3.f;
+  style.Colors[ImGuiCol_WindowBg] = ImVec4(0.86f, 0.86f, 0.86f, 0.95f);
+  style.Colors[ImGuiCol_Button] = ImVec4(0.70f, 0.70f, 0.70f, 1.f);
+  style.Colors[ImGuiCol_ButtonHovered] = ImVec4(0.60f, 0.60f, 0.60f, 1.f);
+}
+
+void EngineGUI::setupDarkGUIStyle() {
+  ImGui::StyleColorsDark();
+  ImGuiStyle& style = ImGui::GetStyle();
+  style.WindowRounding = 4.f;
+  style.FrameRounding = 3.f;
+}
+
+void EngineGUI::setupVectonautaEngineStyle() {
+  ImGui::StyleColorsDark();
+  ImGuiStyle& style = ImGui::GetStyle();
+  style.WindowRounding = 6.f;
+  style.FrameRounding = 4.f;
+  style.GrabRounding = 4.f;
+  style.Colors[ImGuiCol_WindowBg] = ImVec4(0.08f, 0.09f, 0.12f, 0.92f);
+  style.Colors[ImGuiCol_TitleBgActive] = ImVec4(0.55f, 0.10f, 0.10f, 1.f);
+  style.Colors[ImGuiCol_Button] = ImVec4(0.62f, 0.14f, 0.14f, 1.f);
+  style.Colors[ImGuiCol_ButtonHovered] = ImVec4(0.78f, 0.20f, 0.20f, 1.f);
+  style.Colors[ImGuiCol_ButtonActive] = ImVec4(0.90f, 0.26f, 0.26f, 1.f);
+  style.Colors[ImGuiCol_SliderGrab] = ImVec4(0.90f, 0.26f, 0.26f, 1.f);
+  style.Colors[ImGuiCol_FrameBg] = ImVec4(0.18f, 0.19f, 0.24f, 1.f);
+}
@@ -0,0 +1,185 @@
+#include "GhostLap.h"
+#include "BinaryIO.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+  using BinaryIO::getVarint;
+  using BinaryIO::putVarint;
+  using BinaryIO::readValue;
+  using BinaryIO::remainingBytes;
+  using BinaryIO::unzigzag;
+  using BinaryIO::writeValue;
+  using BinaryIO::zigzag;
+
+  constexpr std::uint32_t kGhostMagic = 0x31534847; // "GHS1"
+  constexpr std::uint32_t kGhostVersion = 1;
+  constexpr float kPositionScale = 4.f;              ///< Cuartos de píxel (±8191 px).
+  constexpr float kHeadingScale = 65536.f / 360.f;
+
+  /// Diferencia angular más corta de @p a a @p b (grados, -180..180).
+  float angleDelta(float a, float b) {
+    float d = std::fmod(b - a, 360.f);
+    if (d > 180.f) {
+      d -= 360.f;
+    }
+    else if (d < -180.f) {
+      d += 360.f;
+    }
+    return d;
+  }
+}
+
+void GhostLap::begin(const std::string& racerName) {
+  m_racerName = racerName;
+  m_samples.clear();
+  m_duration = 0.f;
+  m_hasLast = false;
+}
+
+void GhostLap::push(const sf::Vector2f& position, float rotation) {
+  Sample s;
+  s.x = static_cast<std::int16_t>(std::clamp(std::lround(position.x * kPositionScale), -32767l, 32767l));
+  s.y = static_cast<std::int16_t>(std::clamp(std::lround(position.y * kPositionScale), -32767l, 32767l));
+  s.heading = static_cast<std::uint16_t>(std::lround(rotation * kHeadingScale) & 0xFFFF);
+  m_samples.push_back(s);
+}
+
+void GhostLap::record(float time, const sf::Vector2f& position, float rotation) {
+  float next = static_cast<float>(m_samples.size()) * kSampleInterval;
+  while (next <= time) {
+    if (m_hasLast && time > m_lastTime && next >= m_lastTime) {
+      const float f = (next - m_lastTime) / (time - m_lastTime);
+      push(m_lastPosition + (position - m_lastPosition) * f, m_lastRotation + angleDelta(m_lastRotation, rotation) * f);
+    }
+    else {
+      push(position, rotation);
+    }
+    next = static_cast<float>(m_samples.size()) * kSampleInterval;
+  }
+  m_lastTime = time;
+  m_lastPosition = position;
+  m_lastRotation = rotation;
+  m_hasLast = true;
+}
+
+void GhostLap::finish(float duration) {
+  m_duration = std::min(duration, static_cast<float>(m_samples.size()) * kSampleInterval);
+  m_hasLast = false;
+}
+
+bool GhostLap::sample(float time, sf::Vector2f& position, float& rotation) const {
+  if (m_samples.empty() || time < 0.f || time > m_duration) {
+    return false;
+  }
+  const float u = time / kSampleInterval;
+  const std::size_t i = std::min(static_cast<std::size_t>(u), m_samples.size() - 1);
+  const std::size_t j = std::min(i + 1, m_samples.size() - 1);
+  const float f = std::min(u - static_cast<float>(i), 1.f);
+  const Sample& a = m_samples[i];
+  const Sample& b = m_samples[j];
+  position.x = (a.x + (b.x - a.x) * f) / kPositionScale;
+  position.y = (a.y + (b.y - a.y) * f) / kPositionScale;
+  const auto turn = static_cast<std::int16_t>(b.heading - a.heading); // vuelta más corta
+  rotation = (a.heading + turn * f) / kHeadingScale;
+  return true;
+}
+
+bool GhostLap::save(const std::string& path) const {
+  // Segunda diferencia de la posición y diferencia del rumbo: casi siempre caben en 1 byte.
+  std::vector<std::uint8_t> bytes;
+  bytes.reserve(m_samples.size() * 3);
+  Sample prev;
+  int dxPrev = 0, dyPrev = 0;
+  for (const Sample& s : m_samples) {
+    const int dx = s.x - prev.x;
+    const int dy = s.y - prev.y;
+    putVarint(bytes, zigzag(dx - dxPrev));
+    putVarint(bytes, zigzag(dy - dyPrev));
+    putVarint(bytes, zigzag(static_cast<std::int16_t>(s.heading - prev.heading)));
+    dxPrev = dx;
+    dyPrev = dy;
+    prev = s;
+  }
+
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  const auto nameLength = static_cast<std::uint8_t>(std::min<std::size_t>(m_racerName.size(), 255));
+  const auto count = static_cast<std::uint32_t>(m_samples.size());
+  const auto byteCount = static_cast<std::uint32_t>(bytes.size());
+  writeValue(out, kGhostMagic);
+  writeValue(out, kGhostVersion);
+  writeValue(out, kSampleInterval);
+  writeValue(out, m_duration);
+  writeValue(out, count);
+  writeValue(out, byteCount);
+  writeValue(out, nameLength);
+  out.write(m_racerName.data(), nameLength);
+  out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  return static_cast<bool>(out);
+}
+
+bool GhostLap::load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::uint32_t magic = 0, version = 0, count = 0, byteCount = 0;
+  float interval = 0.f, duration = 0.f;
+  std::uint8_t nameLength = 0;
+  readValue(in, magic);
+  readValue(in, version);
+  readValue(in, interval);
+  readValue(in, duration);
+  readValue(in, count);
+  readValue(in, byteCount);
+  readValue(in, nameLength);
+  if (!in || magic != kGhostMagic || version != kGhostVersion || interval != kSampleInterval ||
+      !std::isfinite(duration) || duration < 0.f) {
+    return false;
+  }
+  // Cada muestra son tres varints (3 bytes como mínimo) y record() toma una cada kSampleInterval.
+  const double maxCount = std::floor(static_cast<double>(duration) / kSampleInterval) + 2.0;
+  if (static_cast<std::uint64_t>(nameLength) + byteCount > remainingBytes(in) || count > byteCount / 3 ||
+      static_cast<double>(count) > maxCount) {
+    std::cerr << "GhostLap::load : cabecera no válida en " << path << "\n";
+    return false;
+  }
+  std::string name(nameLength, '\0');
+  std::vector<std::uint8_t> bytes(byteCount);
+  in.read(name.data(), nameLength);
+  in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(byteCount));
+  if (!in) {
+    return false;
+  }
+
+  std::vector<Sample> samples;
+  samples.reserve(count);
+  std::size_t pos = 0;
+  Sample prev;
+  int dxPrev = 0, dyPrev = 0;
+  for (std::uint32_t k = 0; k < count; ++k) {
+    std::uint32_t ddx = 0, ddy = 0, dh = 0;
+    if (!getVarint(bytes, pos, ddx) || !getVarint(bytes, pos, ddy) || !getVarint(bytes, pos, dh)) {
+      return false;
+    }
+    dxPrev += unzigzag(ddx);
+    dyPrev += unzigzag(ddy);
+    Sample s;
+    s.x = static_cast<std::int16_t>(prev.x + dxPrev);
+    s.y = static_cast<std::int16_t>(prev.y + dyPrev);
+    s.heading = static_cast<std::uint16_t>(prev.heading + unzigzag(dh));
+    samples.push_back(s);
+    prev = s;
+  }
+
+  m_racerName = std::move(name);
+  m_samples = std::move(samples);
+  m_duration = duration;
+  m_hasLast = false;
+  return true;
+}
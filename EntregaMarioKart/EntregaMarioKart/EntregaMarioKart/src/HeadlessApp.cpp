@@ -0,0 +1,183 @@
+#include "HeadlessApp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+bool HeadlessApp::parseArgs(int argc, char* argv[], Options& out) {
+  bool headless = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (std::strcmp(arg, "--headless") == 0) {
+      headless = true;
+    }
+    else if (std::strcmp(arg, "--races") == 0 && hasValue) {
+      out.races = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--laps") == 0 && hasValue) {
+      out.laps = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--hz") == 0 && hasValue) {
+      out.hz = std::max(1.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--max-time") == 0 && hasValue) {
+      out.maxRaceSeconds = std::max(1.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--quiet") == 0) {
+      out.quiet = true;
+    }
+    else if (std::strcmp(arg, "--karts") == 0 && hasValue) {
+      out.karts = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--no-collisions") == 0) {
+      out.collisions = false;
+    }
+    else if (std::strcmp(arg, "--racing-line") == 0) {
+      out.racingLine = true;
+    }
+    else if (std::strcmp(arg, "--kart-physics") == 0) {
+      out.kartPhysics = true;
+    }
+    else if (std::strcmp(arg, "--items") == 0) {
+      out.items = true;
+    }
+    else if (std::strcmp(arg, "--record") == 0 && hasValue) {
+      out.recordPath = argv[++i];
+    }
+    else if (std::strcmp(arg, "--replay") == 0 && hasValue) {
+      out.replayPath = argv[++i];
+      headless = true;
+    }
+  }
+  return headless;
+}
+
+int HeadlessApp::run(const Options& options) {
+  if (!options.replayPath.empty()) {
+    return runReplay(options);
+  }
+  m_sim.setupDefaultRace(static_cast<std::size_t>(options.karts));
+  m_sim.setCollisionsEnabled(options.collisions);
+  m_sim.setTotalLaps(options.laps);
+  m_sim.setKartPhysicsAI(options.kartPhysics);
+  m_sim.setItemsEnabled(options.items);
+  if (options.racingLine && !m_sim.loadDefaultRacingLine()) {
+    std::cerr << "HeadlessApp::run : no hay trazada para esta pista (EntregaMarioKart --optimize-line --generated)\n";
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  std::uint64_t totalTicks = 0;
+  double simulatedSeconds = 0.0;
+  int unfinished = 0;
+
+  for (int race = 0; race < options.races; ++race) {
+    totalTicks += simulateRace(options);
+    simulatedSeconds += m_sim.getRaceTime();
+    if (!m_sim.isRaceOver()) {
+      ++unfinished;
+    }
+    if (!options.quiet) {
+      printResults(race);
+    }
+  }
+
+  const double wall = std::chrono::duration<double>(Clock::now() - start).count();
+  const double safeWall = (wall > 0.0) ? wall : 1e-9;
+  std::printf("\n=== Headless: %d carrera(s), %d vuelta(s), %.0f Hz, %d karts%s%s ===\n",
+    options.races, options.laps, options.hz, options.karts, options.collisions ? "" : " (sin choques)",
+    m_sim.getRacingLine() ? " (trazada optimizada)" : "");
+  std::printf("Tiempo real:      %.3f s\n", wall);
+  std::printf("Tiempo simulado:  %.1f s (x%.0f tiempo real)\n", simulatedSeconds, simulatedSeconds / safeWall);
+  std::printf("Ticks:            %llu (%.0f ticks/s)\n",
+    static_cast<unsigned long long>(totalTicks), totalTicks / safeWall);
+  std::printf("Coste por tick:   %.3f ms\n", totalTicks ? wall * 1000.0 / totalTicks : 0.0);
+  std::printf("Carreras/minuto:  %.0f\n", options.races * 60.0 / safeWall);
+  if (unfinished > 0) {
+    std::printf("Sin terminar:     %d (límite %.0f s)\n", unfinished, options.maxRaceSeconds);
+  }
+  if (options.items) {
+    const ItemSystem& items = m_sim.getItems();
+    std::printf("Objetos:          %u lanzados, %u impactos, %zu vivos como máximo (pool de %zu, %u perdidos)\n",
+      items.getSpawned(), items.getHits(), items.getPeakLive(), items.getCapacity(), items.getDropped());
+  }
+  if (!options.recordPath.empty()) {
+    if (!m_replay.save(options.recordPath)) {
+      std::cerr << "HeadlessApp::run : no se pudo escribir " << options.recordPath << "\n";
+      return 1;
+    }
+    std::printf("Grabación:        %s (%u ticks, %zu bytes)\n", options.recordPath.c_str(),
+      m_replay.getTickCount(), m_replay.getByteSize());
+  }
+  return 0;
+}
+
+int HeadlessApp::runReplay(const Options& options) {
+  if (!m_replay.load(options.replayPath)) {
+    std::cerr << "HeadlessApp::runReplay : no se pudo leer " << options.replayPath << "\n";
+    return 1;
+  }
+  if (!m_replay.apply(m_sim)) {
+    std::cerr << "HeadlessApp::runReplay : falta la superficie o la trazada de la grabación; la reproducción divergirá\n";
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  const float dt = 1.f / m_replay.getSetup().hz;
+  while (m_replay.playStep(m_sim, dt)) {
+  }
+  const double wall = std::chrono::duration<double>(Clock::now() - start).count();
+
+  if (!options.quiet) {
+    printResults(0);
+  }
+  std::printf("\n=== Replay: %s ===\n", options.replayPath.c_str());
+  std::printf("Ticks:            %u (%.0f Hz, %.3f s reales)\n", m_replay.getPlayedTicks(), m_replay.getSetup().hz, wall);
+  std::printf("Tamaño:           %zu bytes\n", m_replay.getByteSize());
+  if (m_replay.getDesyncTick() != 0) {
+    std::printf("Resultado:        DIVERGE en el tick %u\n", m_replay.getDesyncTick());
+    return 1;
+  }
+  std::printf("Resultado:        OK (%zu huellas coinciden)\n", m_replay.getChecksumCount());
+  return 0;
+}
+
+std::uint64_t HeadlessApp::simulateRace(const Options& options) {
+  m_sim.reset();
+  const bool recording = !options.recordPath.empty();
+  if (recording) {
+    m_replay.begin(RaceReplay::capture(m_sim, options.hz, false));
+  }
+  const float dt = 1.f / options.hz;
+  std::uint64_t ticks = 0;
+  while (!m_sim.isRaceOver() && m_sim.getRaceTime() < options.maxRaceSeconds) {
+    if (recording) {
+      m_replay.recordStep(m_sim, dt);
+    }
+    else {
+      m_sim.step(dt);
+    }
+    ++ticks;
+  }
+  return ticks;
+}
+
+void HeadlessApp::printResults(int raceIdx) const {
+  std::printf("Carrera %d (%.2f s)\n", raceIdx + 1, m_sim.getRaceTime());
+  const auto& racers = m_sim.getRacers();
+  const LapTimer& timer = m_sim.getLapTimer();
+  for (std::uint32_t id : m_sim.getRanking().getFinishOrder()) {
+    const auto& racer = racers[id];
+    std::printf("  %d. %-10s %8.3f s  (mejor vuelta %.3f s)\n", racer->getPlace(), racer->getName().c_str(),
+      m_sim.getFinishTime(id), timer.getRecord(id).bestLap);
+  }
+  for (const auto& racer : racers) {
+    if (racer->getPlace() == 0) {
+      std::printf("  -  %-10s DNF (vuelta %d/%d)\n", racer->getName().c_str(),
+        racer->getCurrentLap(), racer->getTotalLaps());
+    }
+  }
+}
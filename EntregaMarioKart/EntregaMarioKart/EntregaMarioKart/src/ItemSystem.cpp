@@ -0,0 +1,373 @@
+#include "ItemSystem.h"
+#include "RaceSimulation.h"
+#include "TrackSurface.h"
+#include "ECS/Transform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  constexpr float kRadToDeg = 57.2957795f;
+  constexpr float kMinHoldTime = 0.3f;     ///< s en mano antes de poder usarlo (no se usa al recogerlo).
+  constexpr float kGreenRange = 300.f;     ///< La IA lanza el verde si hay alguien delante a esta distancia.
+  constexpr float kGreenLane = 40.f;       ///< ... y a menos de esta distancia lateral.
+  constexpr float kBananaRange = 150.f;    ///< La IA suelta el plátano si la siguen de cerca.
+  constexpr float kMaxHoldTime = 8.f;      ///< Pasado este tiempo la IA usa el objeto igualmente.
+
+  float dot(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return a.x * b.x + a.y * b.y;
+  }
+
+  /** @brief Dirección en la que mira el kart (sin el giro del sprite). */
+  sf::Vector2f forwardOf(const A_Racer& racer, const Transform& xf) {
+    const float heading = (xf.getRotation() - racer.getSpriteAngleOffset()) / kRadToDeg;
+    return { std::cos(heading), std::sin(heading) };
+  }
+}
+
+ItemSystem::ItemSystem(std::size_t capacity)
+  : m_capacity(capacity)
+{
+  m_x.assign(capacity, 0.f);
+  m_y.assign(capacity, 0.f);
+  m_vx.assign(capacity, 0.f);
+  m_vy.assign(capacity, 0.f);
+  m_age.assign(capacity, 0.f);
+  m_type.assign(capacity, 0);
+  m_bounces.assign(capacity, 0);
+  m_owner.assign(capacity, 0);
+  m_target.assign(capacity, -1);
+}
+
+void ItemSystem::reset(const RaceSimulation& sim) {
+  m_live = 0;
+  m_rng = 0x9E3779B9u;
+  m_spawned = 0;
+  m_dropped = 0;
+  m_hits = 0;
+  m_peakLive = 0;
+
+  // Filas de cajas repartidas por la vuelta, lejos de la salida, cruzando la calzada.
+  m_boxX.clear();
+  m_boxY.clear();
+  const auto& spline = sim.getSpline();
+  if (spline && !spline->empty()) {
+    const int rows = std::max(0, m_params.boxRows);
+    const int perRow = std::max(0, m_params.boxesPerRow);
+    for (int r = 0; r < rows; ++r) {
+      const RacingSpline::Sample s = spline->sample(spline->getLength() * (r + 0.5f) / rows);
+      const sf::Vector2f normal{ -s.tangent.y, s.tangent.x };
+      for (int b = 0; b < perRow; ++b) {
+        const sf::Vector2f pos = s.position + normal * ((b - 0.5f * (perRow - 1)) * m_params.boxSpacing);
+        m_boxX.push_back(pos.x);
+        m_boxY.push_back(pos.y);
+      }
+    }
+  }
+  m_boxTimer.assign(m_boxX.size(), 0.f);
+
+  const std::size_t racers = sim.getRacers().size();
+  m_held.assign(racers, static_cast<std::uint8_t>(Item::None));
+  m_holdTime.assign(racers, 0.f);
+  m_neighbors.reserve(racers);
+}
+
+void ItemSystem::update(const RaceSimulation& sim, float dt) {
+  const auto& racers = sim.getRacers();
+  const SpatialGrid& grid = sim.getGrid();
+  const float radius = m_params.projectileRadius;
+
+  // Objetos en mano: la IA decide; los jugadores los usan con useItem().
+  for (std::size_t i = 0; i < m_held.size() && i < racers.size(); ++i) {
+    if (m_held[i] == static_cast<std::uint8_t>(Item::None)) {
+      continue;
+    }
+    m_holdTime[i] += dt;
+    if (!racers[i]->isManualControl() && !racers[i]->isFinished() &&
+        m_holdTime[i] >= m_params.aiUseDelay && wantsToUse(sim, i)) {
+      useItem(sim, i);
+    }
+  }
+
+  // Rojos: la velocidad gira hacia el objetivo, como mucho homingRate rad/s.
+  const float maxTurn = m_params.homingRate * dt;
+  for (std::size_t p = 0; p < m_live; ++p) {
+    if (m_target[p] < 0) {
+      continue;
+    }
+    const std::uint32_t target = static_cast<std::uint32_t>(m_target[p]);
+    if (!grid.contains(target)) {
+      m_target[p] = -1; // ya ha terminado: sigue recto
+      continue;
+    }
+    const sf::Vector2f& goal = grid.getPosition(target);
+    const float current = std::atan2(m_vy[p], m_vx[p]);
+    const float wanted = std::atan2(goal.y - m_y[p], goal.x - m_x[p]);
+    float turn = std::remainder(wanted - current, 6.2831853f);
+    turn = std::clamp(turn, -maxTurn, maxTurn);
+    const float c = std::cos(turn);
+    const float s = std::sin(turn);
+    const float vx = m_vx[p];
+    m_vx[p] = vx * c - m_vy[p] * s;
+    m_vy[p] = vx * s + m_vy[p] * c;
+  }
+
+  // Integración de todos los proyectiles en una pasada por los arrays.
+  float* x = m_x.data();
+  float* y = m_y.data();
+  const float* vx = m_vx.data();
+  const float* vy = m_vy.data();
+  float* age = m_age.data();
+  for (std::size_t p = 0; p < m_live; ++p) {
+    x[p] += vx[p] * dt;
+    y[p] += vy[p] * dt;
+    age[p] += dt;
+  }
+
+  // Muros, caducidad e impactos. kill() trae el último al hueco: no se avanza p.
+  const TrackSurface* surface = sim.getSurface().get();
+  for (std::size_t p = 0; p < m_live;) {
+    const Item type = static_cast<Item>(m_type[p]);
+    bool dead = m_age[p] > (type == Item::Banana ? m_params.bananaLife : m_params.shellLife);
+    sf::Vector2f pos{ m_x[p], m_y[p] };
+
+    if (!dead && type != Item::Banana && surface && surface->getSurface(pos) == TrackSurface::Surface::Wall) {
+      // Reflexión sobre la normal del campo de distancia y fuera del muro.
+      const sf::Vector2f outward = surface->getGradient(pos);
+      const float into = m_vx[p] * outward.x + m_vy[p] * outward.y;
+      if (into > 0.f) {
+        m_vx[p] -= 2.f * into * outward.x;
+        m_vy[p] -= 2.f * into * outward.y;
+      }
+      pos -= outward * (std::max(surface->getDistance(pos) - surface->getWallDistance(), 0.f) + 1.f);
+      m_x[p] = pos.x;
+      m_y[p] = pos.y;
+      m_target[p] = -1; // un rojo que choca pierde el objetivo
+      dead = ++m_bounces[p] > m_params.shellBounces;
+    }
+
+    if (!dead) {
+      grid.queryRadius(pos, radius, m_neighbors);
+      for (std::uint32_t id : m_neighbors) {
+        if (id == m_owner[p] && m_age[p] < m_params.armTime) {
+          continue;
+        }
+        racers[id]->spinOut(m_params.spinTime);
+        ++m_hits;
+        dead = true;
+        break;
+      }
+    }
+
+    if (dead) {
+      kill(p);
+    }
+    else {
+      ++p;
+    }
+  }
+
+  // Cajas: la primera que toca un corredor sin objeto se la lleva.
+  const RaceRanking& ranking = sim.getRanking();
+  for (std::size_t b = 0; b < m_boxX.size(); ++b) {
+    if (m_boxTimer[b] > 0.f) {
+      m_boxTimer[b] -= dt;
+      continue;
+    }
+    grid.queryRadius({ m_boxX[b], m_boxY[b] }, m_params.boxRadius, m_neighbors);
+    for (std::uint32_t id : m_neighbors) {
+      if (id >= m_held.size() || m_held[id] != static_cast<std::uint8_t>(Item::None)) {
+        continue;
+      }
+      m_held[id] = static_cast<std::uint8_t>(rollItem(ranking.getPosition(id), racers.size()));
+      m_holdTime[id] = 0.f;
+      m_boxTimer[b] = m_params.boxRespawn;
+      break;
+    }
+  }
+}
+
+bool ItemSystem::useItem(const RaceSimulation& sim, std::size_t racer) {
+  const auto& racers = sim.getRacers();
+  if (racer >= m_held.size() || racer >= racers.size() ||
+      m_held[racer] == static_cast<std::uint8_t>(Item::None) || m_holdTime[racer] < kMinHoldTime) {
+    return false;
+  }
+  const A_Racer& kart = *racers[racer];
+  auto xf = kart.getComponent<Transform>();
+  if (!xf || kart.isFinished()) {
+    return false;
+  }
+  const Item item = static_cast<Item>(m_held[racer]);
+  m_held[racer] = static_cast<std::uint8_t>(Item::None);
+  m_holdTime[racer] = 0.f;
+
+  const sf::Vector2f forward = forwardOf(kart, *xf);
+  const sf::Vector2f pos = xf->getPosition();
+  const float gap = sim.getRacerRadius() + m_params.projectileRadius + 4.f;
+  const std::uint16_t owner = static_cast<std::uint16_t>(racer);
+
+  switch (item) {
+  case Item::Mushroom:
+    racers[racer]->startBoost(m_params.boostTime);
+    return true;
+  case Item::Banana:
+    return spawn(Item::Banana, pos - forward * gap, { 0.f, 0.f }, owner, -1);
+  case Item::GreenShell:
+    return spawn(Item::GreenShell, pos + forward * gap, forward * m_params.shellSpeed, owner, -1);
+  case Item::RedShell: {
+    // Objetivo: el de una posición por delante (el líder lo lanza recto).
+    const RaceRanking& ranking = sim.getRanking();
+    const int place = ranking.getPosition(racer);
+    std::int16_t target = -1;
+    if (place > 1 && static_cast<std::size_t>(place - 2) < ranking.getOrder().size()) {
+      target = static_cast<std::int16_t>(ranking.getOrder()[place - 2]);
+    }
+    return spawn(Item::RedShell, pos + forward * gap, forward * m_params.shellSpeed, owner, target);
+  }
+  default:
+    return false;
+  }
+}
+
+bool ItemSystem::spawn(Item type, const sf::Vector2f& position, const sf::Vector2f& velocity,
+                       std::uint16_t owner, std::int16_t target) {
+  if (m_live >= m_capacity) {
+    ++m_dropped;
+    return false;
+  }
+  const std::size_t p = m_live++;
+  m_x[p] = position.x;
+  m_y[p] = position.y;
+  m_vx[p] = velocity.x;
+  m_vy[p] = velocity.y;
+  m_age[p] = 0.f;
+  m_type[p] = static_cast<std::uint8_t>(type);
+  m_bounces[p] = 0;
+  m_owner[p] = owner;
+  m_target[p] = target;
+  ++m_spawned;
+  m_peakLive = std::max(m_peakLive, m_live);
+  return true;
+}
+
+void ItemSystem::kill(std::size_t i) {
+  const std::size_t last = --m_live;
+  if (i == last) {
+    return;
+  }
+  m_x[i] = m_x[last];
+  m_y[i] = m_y[last];
+  m_vx[i] = m_vx[last];
+  m_vy[i] = m_vy[last];
+  m_age[i] = m_age[last];
+  m_type[i] = m_type[last];
+  m_bounces[i] = m_bounces[last];
+  m_owner[i] = m_owner[last];
+  m_target[i] = m_target[last];
+}
+
+ItemSystem::Item ItemSystem::rollItem(int position, std::size_t racers) {
+  // 0 = líder, 1 = último. Cuanto más atrás, más rojos y champiñones.
+  const float behind = (racers > 1 && position > 0)
+    ? static_cast<float>(position - 1) / static_cast<float>(racers - 1) : 0.f;
+  const std::uint32_t roll = random() % 100u;
+  if (behind < 0.34f) {
+    return roll < 50 ? Item::Banana : roll < 90 ? Item::GreenShell : Item::Mushroom;
+  }
+  if (behind < 0.67f) {
+    return roll < 25 ? Item::Banana : roll < 55 ? Item::GreenShell : roll < 85 ? Item::RedShell : Item::Mushroom;
+  }
+  return roll < 15 ? Item::GreenShell : roll < 55 ? Item::RedShell : Item::Mushroom;
+}
+
+bool ItemSystem::wantsToUse(const RaceSimulation& sim, std::size_t racer) {
+  if (m_holdTime[racer] >= kMaxHoldTime) {
+    return true;
+  }
+  const Item item = static_cast<Item>(m_held[racer]);
+  if (item == Item::Mushroom) {
+    return true;
+  }
+  if (item == Item::RedShell) {
+    return sim.getRanking().getPosition(racer) > 1;
+  }
+  const A_Racer& kart = *sim.getRacers()[racer];
+  auto xf = kart.getComponent<Transform>();
+  if (!xf) {
+    return false;
+  }
+  const sf::Vector2f pos = xf->getPosition();
+  const sf::Vector2f forward = forwardOf(kart, *xf);
+  const float range = (item == Item::GreenShell) ? kGreenRange : kBananaRange;
+  sim.getGrid().queryRadius(pos, range, m_neighbors, static_cast<std::uint32_t>(racer));
+  for (std::uint32_t id : m_neighbors) {
+    const sf::Vector2f rel = sim.getGrid().getPosition(id) - pos;
+    const float along = dot(rel, forward);
+    if (item == Item::GreenShell && along > 0.f && std::abs(rel.x * forward.y - rel.y * forward.x) < kGreenLane) {
+      return true;
+    }
+    if (item == Item::Banana && along < 0.f) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::uint32_t ItemSystem::random() {
+  // xorshift32: barato y reproducible en cualquier plataforma.
+  m_rng ^= m_rng << 13;
+  m_rng ^= m_rng >> 17;
+  m_rng ^= m_rng << 5;
+  return m_rng;
+}
+
+void ItemSystem::saveState(StateWriter& out) const {
+  out.put(static_cast<std::uint32_t>(m_live));
+  out.putArray(m_x.data(), m_live);
+  out.putArray(m_y.data(), m_live);
+  out.putArray(m_vx.data(), m_live);
+  out.putArray(m_vy.data(), m_live);
+  out.putArray(m_age.data(), m_live);
+  out.putArray(m_type.data(), m_live);
+  out.putArray(m_bounces.data(), m_live);
+  out.putArray(m_owner.data(), m_live);
+  out.putArray(m_target.data(), m_live);
+  out.putVector(m_boxTimer);
+  out.putVector(m_held);
+  out.putVector(m_holdTime);
+  out.put(m_rng);
+  out.put(m_spawned);
+  out.put(m_dropped);
+  out.put(m_hits);
+  out.put(static_cast<std::uint32_t>(m_peakLive));
+}
+
+void ItemSystem::loadState(StateReader& in) {
+  std::uint32_t live = 0;
+  in.get(live);
+  if (!in.ok() || live > m_capacity) {
+    in.fail();
+    return;
+  }
+  m_live = live;
+  in.getArray(m_x.data(), m_live);
+  in.getArray(m_y.data(), m_live);
+  in.getArray(m_vx.data(), m_live);
+  in.getArray(m_vy.data(), m_live);
+  in.getArray(m_age.data(), m_live);
+  in.getArray(m_type.data(), m_live);
+  in.getArray(m_bounces.data(), m_live);
+  in.getArray(m_owner.data(), m_live);
+  in.getArray(m_target.data(), m_live);
+  in.getVector(m_boxTimer);
+  in.getVector(m_held);
+  in.getVector(m_holdTime);
+  in.get(m_rng);
+  in.get(m_spawned);
+  in.get(m_dropped);
+  in.get(m_hits);
+  std::uint32_t peak = 0;
+  in.get(peak);
+  m_peakLive = peak;
+}
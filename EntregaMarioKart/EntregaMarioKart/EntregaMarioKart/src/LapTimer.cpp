@@ -0,0 +1,146 @@
+#include "LapTimer.h"
+#include "ECS/Transform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  float cross(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return a.x * b.y - a.y * b.x;
+  }
+}
+
+void LapTimer::build(const RacingSpline& spline, int sectors, float halfWidth) {
+  m_gates.clear();
+  if (spline.empty()) {
+    return;
+  }
+  sectors = std::clamp(sectors, 2, kMaxSectors);
+  const float length = spline.getLength();
+  for (int k = 0; k < sectors; ++k) {
+    const float s = length * static_cast<float>(k) / static_cast<float>(sectors);
+    const RacingSpline::Sample sample = spline.sample(s);
+    const sf::Vector2f normal{ -sample.tangent.y, sample.tangent.x };
+    Gate gate;
+    gate.a = sample.position - normal * halfWidth;
+    gate.b = sample.position + normal * halfWidth;
+    gate.forward = sample.tangent;
+    gate.distance = s;
+    m_gates.push_back(gate);
+  }
+}
+
+void LapTimer::reset(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers) {
+  m_bestLap = -1.f;
+  m_records.assign(racers.size(), LapRecord{});
+  const int n = getSectorCount();
+  for (std::size_t i = 0; i < racers.size(); ++i) {
+    LapRecord& rec = m_records[i];
+    rec.splits.fill(-1.f);
+    rec.bestSplits.fill(-1.f);
+
+    // Primera fila (sobre la meta o por delante): la vuelta 1 empieza con la salida.
+    // Filas traseras: primero tienen que cruzar la meta.
+    const float start = racers[i]->getStartDistance();
+    rec.started = (start >= 0.f) ? 1 : 0;
+    rec.nextGate = 0;
+    if (rec.started && n > 0) {
+      rec.nextGate = static_cast<std::uint8_t>(1 % n);
+      for (int g = 1; g < n && start >= m_gates[g].distance; ++g) {
+        rec.nextGate = static_cast<std::uint8_t>((g + 1) % n);
+      }
+    }
+    racers[i]->setLapState(0, (rec.nextGate + n - 1) % std::max(n, 1), n, rec.started != 0);
+  }
+}
+
+void LapTimer::saveState(StateWriter& out) const {
+  out.putVector(m_records);
+  out.put(m_bestLap);
+}
+
+void LapTimer::loadState(StateReader& in) {
+  in.getVector(m_records);
+  in.get(m_bestLap);
+}
+
+bool LapTimer::crosses(const Gate& gate, const sf::Vector2f& p0, const sf::Vector2f& p1, float& t) {
+  const sf::Vector2f d = p1 - p0;
+  if (d.x * gate.forward.x + d.y * gate.forward.y <= 0.f) {
+    return false; // sólo hacia delante
+  }
+  const sf::Vector2f e = gate.b - gate.a;
+  const float denom = cross(d, e);
+  if (std::abs(denom) < 1e-8f) {
+    return false;
+  }
+  const sf::Vector2f w = gate.a - p0;
+  t = cross(w, e) / denom;
+  const float u = cross(w, d) / denom;
+  return t >= 0.f && t < 1.f && u >= 0.f && u <= 1.f;
+}
+
+bool LapTimer::passGate(LapRecord& rec, int gate, float time) {
+  const int n = getSectorCount();
+  if (!rec.started) {
+    // Cruce de salida desde detrás de la meta: la vuelta 1 cuenta desde el semáforo.
+    rec.started = 1;
+    rec.nextGate = static_cast<std::uint8_t>(1 % n);
+    return false;
+  }
+
+  const int sector = (gate + n - 1) % n;
+  const float split = time - rec.sectorStart;
+  rec.splits[sector] = split;
+  if (rec.bestSplits[sector] < 0.f || split < rec.bestSplits[sector]) {
+    rec.bestSplits[sector] = split;
+  }
+  rec.sectorStart = time;
+  rec.nextGate = static_cast<std::uint8_t>((gate + 1) % n);
+  if (gate != 0) {
+    return false;
+  }
+
+  const float lapTime = time - rec.lapStart;
+  rec.lastLap = lapTime;
+  if (rec.bestLap < 0.f || lapTime < rec.bestLap) {
+    rec.bestLap = lapTime;
+  }
+  if (m_bestLap < 0.f || lapTime < m_bestLap) {
+    m_bestLap = lapTime;
+  }
+  ++rec.lap;
+  rec.lapStart = time;
+  rec.splits.fill(-1.f);
+  return true;
+}
+
+int LapTimer::update(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers, float tickStart, float dt) {
+  const int n = getSectorCount();
+  if (n == 0 || m_records.size() != racers.size()) {
+    return 0;
+  }
+  int laps = 0;
+  for (std::size_t i = 0; i < racers.size(); ++i) {
+    auto& racer = racers[i];
+    auto xf = racer->getComponent<Transform>();
+    if (!xf || racer->isFinished()) {
+      continue;
+    }
+    const sf::Vector2f p0 = xf->getPreviousPosition();
+    const sf::Vector2f p1 = xf->getPosition();
+    LapRecord& rec = m_records[i];
+
+    // Normalmente 0 o 1 puerta por tick; el bucle cubre puertas muy juntas.
+    bool changed = false;
+    float t = 0.f;
+    for (int guard = 0; guard < n && crosses(m_gates[rec.nextGate], p0, p1, t); ++guard) {
+      laps += passGate(rec, rec.nextGate, tickStart + t * dt) ? 1 : 0;
+      changed = true;
+    }
+    if (changed) {
+      racer->setLapState(rec.lap, (rec.nextGate + n - 1) % n, n, rec.started != 0);
+    }
+  }
+  return laps;
+}
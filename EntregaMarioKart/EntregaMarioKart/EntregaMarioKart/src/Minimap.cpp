@@ -0,0 +1,103 @@
+#include "Minimap.h"
+#include "RacingSpline.h"
+#include "Window.h"
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  /**
+   * Franja de @p width px alrededor de la línea, como triángulos (para pintarla una vez).
+   */
+  sf::VertexArray lineStrip(const RacingSpline& line, float width, float scale, const sf::Color& color) {
+    sf::VertexArray strip(sf::PrimitiveType::TriangleStrip);
+    const float step = std::max(line.getStep(), 1.f) * 2.f;
+    const int count = static_cast<int>(std::ceil(line.getLength() / step));
+    for (int i = 0; i <= count; ++i) {
+      const RacingSpline::Sample s = line.sample(std::min(static_cast<float>(i) * step, line.getLength()));
+      const sf::Vector2f normal(-s.tangent.y, s.tangent.x);
+      strip.append(sf::Vertex{ (s.position + normal * (0.5f * width)) * scale, color });
+      strip.append(sf::Vertex{ (s.position - normal * (0.5f * width)) * scale, color });
+    }
+    return strip;
+  }
+}
+
+bool Minimap::build(const sf::Vector2f& worldSize, const sf::Texture* track, const RacingSpline* line,
+                    const Params& params) {
+  m_params = params;
+  m_ready = false;
+  if (worldSize.x <= 0.f || worldSize.y <= 0.f) {
+    return false;
+  }
+  m_scale = static_cast<float>(m_params.maxSide) / std::max(worldSize.x, worldSize.y);
+  const sf::Vector2u pixels(static_cast<unsigned>(std::ceil(worldSize.x * m_scale)),
+                            static_cast<unsigned>(std::ceil(worldSize.y * m_scale)));
+  if (!m_texture.resize(pixels)) {
+    std::cerr << "Minimap::build : no se pudo crear la textura de " << pixels.x << "x" << pixels.y << "\n";
+    return false;
+  }
+  m_texture.setSmooth(true);
+  m_size = sf::Vector2f(pixels);
+
+  // --- Fondo: se pinta aquí una vez y luego sólo se reutiliza ---
+  m_texture.clear(m_params.background);
+  if (track) {
+    sf::Sprite sprite(*track);
+    sprite.setScale({ m_scale, m_scale });
+    m_texture.draw(sprite);
+  }
+  else if (line && !line->empty()) {
+    m_texture.draw(lineStrip(*line, m_params.lineWidth, m_scale, m_params.lineColor));
+  }
+  m_texture.display();
+
+  const sf::Vector2f corners[] = { { 0.f, 0.f }, { m_size.x, 0.f }, { m_size.x, m_size.y }, { 0.f, m_size.y } };
+  const int order[] = { 0, 1, 2, 0, 2, 3 };
+  for (std::size_t i = 0; i < 6; ++i) {
+    m_background[i].position = corners[order[i]];
+    m_background[i].texCoords = corners[order[i]];
+    m_background[i].color = sf::Color::White;
+  }
+  m_ready = true;
+  MESSAGE("Minimap", "build", std::to_string(pixels.x) + "x" + std::to_string(pixels.y));
+  return true;
+}
+
+void Minimap::setDotCount(std::size_t count) {
+  if (m_dots.getVertexCount() != count * kVerticesPerDot) {
+    m_dots.resize(count * kVerticesPerDot); // vértices en (0,0): triángulos degenerados, invisibles
+  }
+}
+
+void Minimap::setDot(std::size_t index, const sf::Vector2f& world, const sf::Color& color, float size) {
+  if ((index + 1) * kVerticesPerDot > m_dots.getVertexCount()) {
+    return;
+  }
+  const sf::Vector2f center = worldToMap(world);
+  const float r = m_params.dotRadius * size;
+  const sf::Vector2f tips[] = { center + sf::Vector2f(0.f, -r), center + sf::Vector2f(r, 0.f),
+                                center + sf::Vector2f(0.f, r), center + sf::Vector2f(-r, 0.f) };
+  const int order[] = { 0, 1, 2, 0, 2, 3 };
+  sf::Vertex* v = &m_dots[index * kVerticesPerDot];
+  for (std::size_t i = 0; i < kVerticesPerDot; ++i) {
+    v[i].position = tips[order[i]];
+    v[i].color = color;
+  }
+}
+
+void Minimap::render(const EngineUtilities::TSharedPointer<Window>& window) {
+  if (!m_ready || !window) {
+    return;
+  }
+  const sf::Vector2f windowSize(window->getSize());
+  sf::RenderStates states;
+  states.transform.translate({ windowSize.x - m_size.x - m_params.margin, m_params.margin });
+  states.texture = &m_texture.getTexture();
+  window->draw(m_background, states);
+  if (m_dots.getVertexCount() > 0) {
+    states.texture = nullptr;
+    window->draw(m_dots, states);
+  }
+}
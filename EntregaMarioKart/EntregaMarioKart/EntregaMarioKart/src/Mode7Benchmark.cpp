@@ -0,0 +1,112 @@
+#include "Mode7Benchmark.h"
+#include "Mode7Renderer.h"
+#include "RaceSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+  constexpr unsigned kCheckerSize = 2048;  ///< Lado del damero sin imagen de pista (px).
+  constexpr unsigned kCheckerCell = 32;
+  constexpr float kCameraSpeed = 300.f;    ///< px/s a lo largo de la línea de carrera.
+  constexpr float kCameraBehind = 60.f;    ///< px por detrás del punto seguido.
+  constexpr float kFrameSeconds = 1.f / 60.f;
+
+  sf::Image checkerboard() {
+    sf::Image image({ kCheckerSize, kCheckerSize }, sf::Color(90, 90, 90));
+    for (unsigned y = 0; y < kCheckerSize; ++y) {
+      for (unsigned x = 0; x < kCheckerSize; ++x) {
+        if (((x / kCheckerCell) + (y / kCheckerCell)) % 2 == 0) {
+          image.setPixel({ x, y }, sf::Color(200, 200, 200));
+        }
+      }
+    }
+    return image;
+  }
+}
+
+bool Mode7Benchmark::parseArgs(int argc, char* argv[], Config& out) {
+  bool requested = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (std::strcmp(arg, "--mode7-bench") == 0) {
+      requested = true;
+    }
+    else if (std::strcmp(arg, "--width") == 0 && hasValue) {
+      out.width = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--height") == 0 && hasValue) {
+      out.height = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+      out.frames = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--track") == 0 && hasValue) {
+      out.trackPath = argv[++i];
+    }
+  }
+  return requested;
+}
+
+int Mode7Benchmark::run(const Config& config) {
+  sf::Image track;
+  const bool fromImage = track.loadFromFile(config.trackPath);
+  if (!fromImage) {
+    std::printf("Mode7Benchmark : sin %s; se usa un damero de %ux%u\n", config.trackPath.c_str(),
+      kCheckerSize, kCheckerSize);
+    track = checkerboard();
+  }
+
+  RaceSimulation sim;
+  sim.setupDefaultRace();
+  const auto& spline = sim.getSpline();
+
+  Mode7Renderer renderer;
+  renderer.setTrack(track);
+  renderer.setSkyColor(sf::Color(110, 170, 240));
+  renderer.setSize(config.width, config.height);
+
+  Mode7Renderer::View view;
+  view.focal = 0.5f * static_cast<float>(config.width); // 90 grados de campo horizontal
+  std::vector<double> times;
+  times.reserve(static_cast<std::size_t>(config.frames));
+  std::size_t groundPixels = 0;
+  for (int frame = 0; frame < config.frames; ++frame) {
+    const float s = kCameraSpeed * kFrameSeconds * static_cast<float>(frame);
+    const RacingSpline::Sample sample = spline->sample(s);
+    view.position = sample.position - sample.tangent * kCameraBehind;
+    view.angle = std::atan2(sample.tangent.y, sample.tangent.x);
+    renderer.render(view);
+    times.push_back(renderer.getStats().fillSeconds);
+    groundPixels += renderer.getStats().groundRows * config.width;
+  }
+
+  // Mismo frame otra vez: sin cambios de cámara no se recalcula ni se rellena nada.
+  renderer.render(view);
+  const bool cached = renderer.getStats().skipped == 1;
+
+  std::vector<double> sorted = times;
+  std::sort(sorted.begin(), sorted.end());
+  double total = 0.0;
+  for (double t : times) {
+    total += t;
+  }
+  const double mean = total / static_cast<double>(times.size());
+  const double p95 = sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)];
+
+  std::printf("\n=== Mode 7: %ux%u, %d frames, pista %ux%u%s ===\n", config.width, config.height,
+    config.frames, track.getSize().x, track.getSize().y, fromImage ? "" : " (damero)");
+  std::printf("Relleno medio:    %.3f ms (p95 %.3f ms, min %.3f ms, max %.3f ms)\n",
+    mean * 1000.0, p95 * 1000.0, sorted.front() * 1000.0, sorted.back() * 1000.0);
+  std::printf("Suelo:            %.1f Mpx/s (%.0f%% de la pantalla)\n",
+    total > 0.0 ? static_cast<double>(groundPixels) / total / 1e6 : 0.0,
+    100.0 * static_cast<double>(groundPixels) / (static_cast<double>(config.width) * config.height * config.frames));
+  std::printf("Tablas de profundidad: %u; cámara quieta en caché: %s\n",
+    renderer.getStats().depthRebuilds, cached ? "sí" : "no");
+  return 0;
+}
@@ -0,0 +1,173 @@
+#include "Mode7Renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  std::uint32_t pack(const sf::Color& color) {
+    const std::uint8_t bytes[4] = { color.r, color.g, color.b, color.a };
+    std::uint32_t packed = 0;
+    std::memcpy(&packed, bytes, sizeof(packed)); // mismo orden de bytes que sf::Image
+    return packed;
+  }
+}
+
+void Mode7Renderer::setTrack(const sf::Image& image, const sf::Color& outside) {
+  m_trackWidth = image.getSize().x;
+  m_trackHeight = image.getSize().y;
+  const std::size_t count = static_cast<std::size_t>(m_trackWidth) * m_trackHeight;
+  m_texels.resize(count + 1);
+  if (count > 0) {
+    std::memcpy(m_texels.data(), image.getPixelsPtr(), count * sizeof(std::uint32_t));
+  }
+  m_texels[count] = pack(outside);
+  m_frameDirty = true;
+}
+
+void Mode7Renderer::setSkyColor(const sf::Color& color) {
+  m_sky = pack(color);
+  m_frameDirty = true;
+}
+
+void Mode7Renderer::setSize(unsigned width, unsigned height) {
+  if (width == m_width && height == m_height) {
+    return;
+  }
+  m_width = width;
+  m_height = height;
+  m_pixels.assign(static_cast<std::size_t>(width) * height, m_sky);
+  m_indices.assign(width, 0);
+  m_depthDirty = true;
+  m_frameDirty = true;
+}
+
+bool Mode7Renderer::render(const View& view) {
+  if (!m_frameDirty && view == m_view) {
+    ++m_stats.skipped;
+    return false;
+  }
+  const Clock::time_point start = Clock::now();
+  if (view.height != m_view.height || view.focal != m_view.focal || view.horizon != m_view.horizon
+      || view.farDistance != m_view.farDistance) {
+    m_depthDirty = true;
+  }
+  m_view = view;
+  if (m_depthDirty) {
+    rebuildDepthTable();
+  }
+  rebuildRowTable();
+
+  const std::uint32_t outside = m_texels.empty() ? m_sky : m_texels.back();
+  m_stats.groundRows = 0;
+  for (unsigned y = 0; y < m_height; ++y) {
+    std::uint32_t* row = m_pixels.data() + static_cast<std::size_t>(y) * m_width;
+    const float depth = m_rowDepth[y];
+    if (depth <= 0.f) {
+      std::fill(row, row + m_width, m_sky);
+    }
+    else if (depth > m_view.farDistance || m_texels.size() < 2) {
+      std::fill(row, row + m_width, outside);
+    }
+    else {
+      fillRow(y);
+      ++m_stats.groundRows;
+    }
+  }
+  m_frameDirty = false;
+  m_stats.fillSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return true;
+}
+
+void Mode7Renderer::rebuildDepthTable() {
+  m_rowDepth.assign(m_height, 0.f);
+  m_rowU.assign(m_height, 0.f);
+  m_rowV.assign(m_height, 0.f);
+  m_rowDu.assign(m_height, 0.f);
+  m_rowDv.assign(m_height, 0.f);
+  const float horizonRow = m_view.horizon * static_cast<float>(m_height);
+  for (unsigned y = 0; y < m_height; ++y) {
+    // Centro del píxel: la fila justo bajo el horizonte no llega a distancia infinita.
+    const float dy = static_cast<float>(y) + 0.5f - horizonRow;
+    m_rowDepth[y] = (dy > 0.f) ? m_view.height * m_view.focal / dy : 0.f;
+  }
+  m_depthDirty = false;
+  ++m_stats.depthRebuilds;
+}
+
+void Mode7Renderer::rebuildRowTable() {
+  const sf::Vector2f forward{ std::cos(m_view.angle), std::sin(m_view.angle) };
+  const sf::Vector2f right{ -forward.y, forward.x }; // y hacia abajo: derecha de la pantalla
+  const float firstColumn = 0.5f - 0.5f * static_cast<float>(m_width);
+  for (unsigned y = 0; y < m_height; ++y) {
+    const float depth = m_rowDepth[y];
+    if (depth <= 0.f) {
+      continue;
+    }
+    const float worldPerPixel = depth / m_view.focal;
+    const sf::Vector2f center = m_view.position + forward * depth;
+    m_rowU[y] = center.x + right.x * firstColumn * worldPerPixel;
+    m_rowV[y] = center.y + right.y * firstColumn * worldPerPixel;
+    m_rowDu[y] = right.x * worldPerPixel;
+    m_rowDv[y] = right.y * worldPerPixel;
+  }
+}
+
+void Mode7Renderer::fillRow(unsigned y) {
+  const float u0 = m_rowU[y];
+  const float v0 = m_rowV[y];
+  const float du = m_rowDu[y];
+  const float dv = m_rowDv[y];
+  const float width = static_cast<float>(m_trackWidth);
+  const float height = static_cast<float>(m_trackHeight);
+  const std::int32_t stride = static_cast<std::int32_t>(m_trackWidth);
+  const std::int32_t outsideIndex = static_cast<std::int32_t>(m_texels.size() - 1);
+  const unsigned count = m_width;
+
+  // Pasada 1: índice de texel por píxel. Sólo aritmética y selecciones: se vectoriza.
+  std::int32_t* indices = m_indices.data();
+  for (unsigned x = 0; x < count; ++x) {
+    const float u = u0 + du * static_cast<float>(x);
+    const float v = v0 + dv * static_cast<float>(x);
+    const bool inside = (u >= 0.f) & (u < width) & (v >= 0.f) & (v < height);
+    const std::int32_t index = static_cast<std::int32_t>(inside ? v : 0.f) * stride
+                             + static_cast<std::int32_t>(inside ? u : 0.f);
+    indices[x] = inside ? index : outsideIndex;
+  }
+
+  // Pasada 2: copia de texels.
+  const std::uint32_t* texels = m_texels.data();
+  std::uint32_t* row = m_pixels.data() + static_cast<std::size_t>(y) * m_width;
+  for (unsigned x = 0; x < count; ++x) {
+    row[x] = texels[indices[x]];
+  }
+}
+
+bool Mode7Renderer::project(const sf::Vector2f& world, sf::Vector2f& screen, float& scale) const {
+  const sf::Vector2f forward{ std::cos(m_view.angle), std::sin(m_view.angle) };
+  const sf::Vector2f right{ -forward.y, forward.x };
+  const sf::Vector2f d = world - m_view.position;
+  const float depth = d.x * forward.x + d.y * forward.y;
+  if (depth <= 1.f || depth > m_view.farDistance) {
+    return false;
+  }
+  const float lateral = d.x * right.x + d.y * right.y;
+  scale = m_view.focal / depth;
+  screen.x = 0.5f * static_cast<float>(m_width) + lateral * scale;
+  screen.y = m_view.horizon * static_cast<float>(m_height) + m_view.height * scale;
+  return true;
+}
+
+bool Mode7Renderer::upload(sf::Texture& texture) const {
+  if (m_pixels.empty()) {
+    return false;
+  }
+  if (texture.getSize() != getSize() && !texture.resize(getSize())) {
+    return false;
+  }
+  texture.update(getPixels());
+  return true;
+}
@@ -0,0 +1,117 @@
+#include "NetClient.h"
+#include "NetServer.h"
+
+#include <algorithm>
+
+void NetClient::connect(NetTransport& transport, int serverPeer) {
+  m_transport = &transport;
+  m_server = serverPeer;
+  m_connected = false;
+  m_racer = -1;
+  m_inputTick = 0;
+  m_lastEcho = 0;
+  m_latest = NetSnapshot{};
+  m_history.assign(NetServer::kHistorySize, NetSnapshot{});
+  m_stats = Stats{};
+}
+
+void NetClient::update(float now, const RaceSimulation::PlayerInput& input) {
+  if (!m_transport) {
+    return;
+  }
+  int peer = -1;
+  std::vector<std::uint8_t> packet;
+  while (m_transport->receive(peer, packet)) {
+    if (peer == m_server && !packet.empty()) {
+      m_stats.bytesIn += packet.size();
+      handlePacket(packet, now);
+    }
+  }
+
+  m_packet.clear();
+  NetWriter out(m_packet);
+  if (!m_connected) {
+    out.putByte(static_cast<std::uint8_t>(NetMessage::Hello));
+  }
+  else {
+    ++m_inputTick;
+    m_inputSentAt[m_inputTick % m_inputSentAt.size()] = now;
+    out.putByte(static_cast<std::uint8_t>(NetMessage::Input));
+    out.putVarint(m_inputTick);
+    out.putVarint(m_latest.tick);
+    out.putInput(input);
+  }
+  send();
+}
+
+void NetClient::send() {
+  m_transport->send(m_server, m_packet);
+  m_stats.bytesOut += m_packet.size();
+}
+
+void NetClient::handlePacket(const std::vector<std::uint8_t>& packet, float now) {
+  NetReader in(packet);
+  const auto type = static_cast<NetMessage>(in.getByte());
+  if (type == NetMessage::Welcome) {
+    const int racer = in.getSigned();
+    const std::uint32_t karts = in.getVarint();
+    const std::uint32_t laps = in.getVarint();
+    const float hz = in.getFloat();
+    const std::uint32_t interval = in.getVarint();
+    if (!in.ok() || m_connected) {
+      return;
+    }
+    m_racer = racer;
+    m_karts = static_cast<int>(karts);
+    m_laps = static_cast<int>(laps);
+    m_hz = (hz > 0.f) ? hz : 60.f;
+    m_interval = std::max<std::uint32_t>(1, interval);
+    m_connected = true;
+    return;
+  }
+  if (type != NetMessage::Snapshot || !m_connected) {
+    return;
+  }
+
+  const std::uint32_t tick = in.getVarint();
+  const std::uint32_t baseTick = in.getVarint();
+  const std::uint32_t echo = in.getVarint();
+  if (!in.ok() || tick == 0) {
+    ++m_stats.undecodable;
+    return;
+  }
+  if (tick <= m_latest.tick) {
+    ++m_stats.stale;
+    return;
+  }
+  const NetSnapshot* base = nullptr;
+  if (baseTick != 0) {
+    const NetSnapshot& candidate = m_history[(baseTick / m_interval) % m_history.size()];
+    if (candidate.tick != baseTick) {
+      ++m_stats.undecodable;  // base ya sobrescrita: el servidor mandará otra al ver el ack
+      return;
+    }
+    base = &candidate;
+  }
+  NetSnapshot snapshot;
+  snapshot.tick = tick;
+  if (!snapshot.decode(in, base)) {
+    ++m_stats.undecodable;
+    return;
+  }
+
+  if (m_latest.tick != 0) {
+    m_stats.missing += (tick - m_latest.tick) / m_interval - 1;
+  }
+  m_latest = snapshot;
+  m_history[(tick / m_interval) % m_history.size()] = std::move(snapshot);
+  ++m_stats.snapshots;
+
+  if (echo > m_lastEcho && echo + m_inputSentAt.size() > m_inputTick) {
+    m_lastEcho = echo;
+    const float rtt = now - m_inputSentAt[echo % m_inputSentAt.size()];
+    m_stats.rttSum += rtt;
+    m_stats.rttMax = std::max(m_stats.rttMax, rtt);
+    ++m_stats.rttSamples;
+  }
+}
@@ -0,0 +1,233 @@
+#include "NetProtocol.h"
+#include "ECS/Transform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+  constexpr float kPositionScale = 8.f;           ///< Octavos de píxel.
+  constexpr float kTwoPi = 6.28318531f;
+  constexpr float kRadToDeg = 57.2957795f;
+  constexpr std::uint32_t kMaxRacers = 4096;       ///< Límite de cordura al decodificar.
+
+  constexpr std::uint8_t kXBit = 1 << 0;
+  constexpr std::uint8_t kYBit = 1 << 1;
+  constexpr std::uint8_t kAngleBit = 1 << 2;
+  constexpr std::uint8_t kSpeedBit = 1 << 3;
+  constexpr std::uint8_t kProgressBit = 1 << 4;   ///< Vuelta, sector y puesto (3 bytes).
+
+  /**
+   * Suma y resta de deltas en aritmética modular de 32 bits: un paquete corrupto da un valor
+   * erróneo, nunca un desbordamiento con signo, y encode/decode siguen siendo exactos.
+   */
+  std::int32_t addDelta(std::int32_t base, std::int32_t delta) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(base) + static_cast<std::uint32_t>(delta));
+  }
+
+  std::int32_t subDelta(std::int32_t now, std::int32_t base) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(now) - static_cast<std::uint32_t>(base));
+  }
+}
+
+// --- NetWriter / NetReader ---
+
+void NetWriter::putVarint(std::uint32_t v) {
+  while (v >= 0x80) {
+    m_out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  m_out.push_back(static_cast<std::uint8_t>(v));
+}
+
+void NetWriter::putSigned(std::int32_t v) {
+  putVarint((static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31));
+}
+
+void NetWriter::putFloat(float v) {
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  for (int i = 0; i < 4; ++i) {
+    m_out.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+  }
+}
+
+void NetWriter::putInput(const RaceSimulation::PlayerInput& input) {
+  putByte(static_cast<std::uint8_t>(std::lround(std::clamp(input.throttle, -1.f, 1.f) * 127.f)));
+  putByte(static_cast<std::uint8_t>(std::lround(std::clamp(input.steer, -1.f, 1.f) * 127.f)));
+  putByte(static_cast<std::uint8_t>((input.drift ? 1 : 0) | (input.useItem ? 2 : 0)));
+}
+
+std::uint8_t NetReader::getByte() {
+  if (m_pos >= m_in.size()) {
+    m_ok = false;
+    return 0;
+  }
+  return m_in[m_pos++];
+}
+
+std::uint32_t NetReader::getVarint() {
+  std::uint32_t v = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    const std::uint8_t byte = getByte();
+    v |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80) || !m_ok) {
+      return v;
+    }
+  }
+  m_ok = false;
+  return 0;
+}
+
+std::int32_t NetReader::getSigned() {
+  const std::uint32_t v = getVarint();
+  return static_cast<std::int32_t>(v >> 1) ^ -static_cast<std::int32_t>(v & 1);
+}
+
+float NetReader::getFloat() {
+  std::uint32_t bits = 0;
+  for (int i = 0; i < 4; ++i) {
+    bits |= static_cast<std::uint32_t>(getByte()) << (8 * i);
+  }
+  float v = 0.f;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+RaceSimulation::PlayerInput NetReader::getInput() {
+  RaceSimulation::PlayerInput input;
+  input.throttle = static_cast<std::int8_t>(getByte()) / 127.f;
+  input.steer = static_cast<std::int8_t>(getByte()) / 127.f;
+  const std::uint8_t buttons = getByte();
+  input.drift = (buttons & 1) != 0;
+  input.useItem = (buttons & 2) != 0;
+  return input;
+}
+
+RaceSimulation::PlayerInput quantizeInput(const RaceSimulation::PlayerInput& input) {
+  std::vector<std::uint8_t> bytes;
+  bytes.reserve(3);
+  NetWriter out(bytes);
+  out.putInput(input);
+  NetReader in(bytes);
+  return in.getInput();
+}
+
+// --- NetRacerState ---
+
+sf::Vector2f NetRacerState::getPosition() const {
+  return { static_cast<float>(x) / kPositionScale, static_cast<float>(y) / kPositionScale };
+}
+
+float NetRacerState::getHeading() const {
+  return static_cast<float>(angle) * (kTwoPi / 65536.f);
+}
+
+bool NetRacerState::operator==(const NetRacerState& other) const {
+  return x == other.x && y == other.y && angle == other.angle && speed == other.speed
+    && lap == other.lap && sector == other.sector && place == other.place;
+}
+
+// --- NetSnapshot ---
+
+void NetSnapshot::capture(const RaceSimulation& sim, std::uint32_t snapshotTick, float dt) {
+  tick = snapshotTick;
+  flags = sim.isRaceOver() ? kRaceOver : 0;
+  const auto& all = sim.getRacers();
+  racers.resize(all.size());
+  for (std::size_t i = 0; i < all.size(); ++i) {
+    const A_Racer& racer = *all[i];
+    NetRacerState& state = racers[i];
+    float heading = 0.f;
+    float speed = 0.f;
+    if (auto xf = racer.getComponent<Transform>()) {
+      const sf::Vector2f pos = xf->getPosition();
+      state.x = static_cast<std::int32_t>(std::lround(pos.x * kPositionScale));
+      state.y = static_cast<std::int32_t>(std::lround(pos.y * kPositionScale));
+      heading = (xf->getRotation() - racer.getSpriteAngleOffset()) / kRadToDeg;
+      const sf::Vector2f moved = pos - xf->getPreviousPosition();
+      speed = (dt > 0.f) ? std::sqrt(moved.x * moved.x + moved.y * moved.y) / dt : 0.f;
+    }
+    if (racer.isPhysicsDriven()) {
+      speed = racer.getPhysics()->getForwardSpeed();
+    }
+    const float turns = heading / kTwoPi;
+    state.angle = static_cast<std::uint16_t>(static_cast<std::int64_t>(std::lround((turns - std::floor(turns)) * 65536.f)));
+    state.speed = static_cast<std::int16_t>(std::clamp(std::lround(speed), -32767l, 32767l));
+    state.lap = static_cast<std::uint8_t>(std::clamp(racer.getCurrentLap(), 0, 255));
+    state.sector = static_cast<std::uint8_t>(std::clamp(racer.getSector(), 0, 255));
+    state.place = static_cast<std::uint8_t>(std::clamp(racer.getPlace(), 0, 255));
+  }
+}
+
+void NetSnapshot::encode(NetWriter& out, const NetSnapshot* base) const {
+  out.putByte(flags);
+  out.putVarint(static_cast<std::uint32_t>(racers.size()));
+  const NetRacerState zero;
+  for (std::size_t i = 0; i < racers.size(); ++i) {
+    const NetRacerState& now = racers[i];
+    const NetRacerState& old = (base && i < base->racers.size()) ? base->racers[i] : zero;
+    std::uint8_t mask = 0;
+    mask |= (now.x != old.x) ? kXBit : 0;
+    mask |= (now.y != old.y) ? kYBit : 0;
+    mask |= (now.angle != old.angle) ? kAngleBit : 0;
+    mask |= (now.speed != old.speed) ? kSpeedBit : 0;
+    mask |= (now.lap != old.lap || now.sector != old.sector || now.place != old.place) ? kProgressBit : 0;
+    out.putByte(mask);
+    if (mask & kXBit) {
+      out.putSigned(subDelta(now.x, old.x));
+    }
+    if (mask & kYBit) {
+      out.putSigned(subDelta(now.y, old.y));
+    }
+    if (mask & kAngleBit) {
+      out.putSigned(static_cast<std::int16_t>(now.angle - old.angle)); // por el arco corto
+    }
+    if (mask & kSpeedBit) {
+      out.putSigned(now.speed - old.speed);
+    }
+    if (mask & kProgressBit) {
+      out.putByte(now.lap);
+      out.putByte(now.sector);
+      out.putByte(now.place);
+    }
+  }
+}
+
+bool NetSnapshot::decode(NetReader& in, const NetSnapshot* base) {
+  flags = in.getByte();
+  const std::uint32_t count = in.getVarint();
+  if (!in.ok() || count > kMaxRacers) {
+    return false;
+  }
+  std::vector<NetRacerState> decoded(count);
+  const NetRacerState zero;
+  for (std::uint32_t i = 0; i < count && in.ok(); ++i) {
+    const NetRacerState& old = (base && i < base->racers.size()) ? base->racers[i] : zero;
+    NetRacerState& now = decoded[i];
+    now = old;
+    const std::uint8_t mask = in.getByte();
+    if (mask & kXBit) {
+      now.x = addDelta(old.x, in.getSigned());
+    }
+    if (mask & kYBit) {
+      now.y = addDelta(old.y, in.getSigned());
+    }
+    if (mask & kAngleBit) {
+      now.angle = static_cast<std::uint16_t>(addDelta(old.angle, in.getSigned()));
+    }
+    if (mask & kSpeedBit) {
+      now.speed = static_cast<std::int16_t>(addDelta(old.speed, in.getSigned()));
+    }
+    if (mask & kProgressBit) {
+      now.lap = in.getByte();
+      now.sector = in.getByte();
+      now.place = in.getByte();
+    }
+  }
+  if (!in.ok()) {
+    return false;
+  }
+  racers = std::move(decoded);
+  return true;
+}
@@ -0,0 +1,529 @@
+#include "NetRaceRunner.h"
+#include "ECS/Transform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+  constexpr float kTwoPi = 6.28318531f;
+  constexpr float kLingerSeconds = 1.f;     ///< Tras la meta: tiempo para que lleguen los últimos snapshots.
+  constexpr float kConnectTimeout = 10.f;   ///< Cliente: espera máxima del Welcome (s).
+  constexpr float kSilenceTimeout = 5.f;    ///< Cliente: sin snapshots durante este tiempo = servidor caído.
+  constexpr float kWaitTimeout = 120.f;     ///< Servidor: espera máxima de los clientes (s).
+
+  /**
+   * Mandos para seguir la línea de carrera: apunta 90 px por delante de @p pos.
+   * @p distance es la proyección anterior sobre la línea (se actualiza).
+   */
+  RaceSimulation::PlayerInput steerAlongLine(const RacingSpline& spline, const sf::Vector2f& pos,
+                                             float heading, float speed, float& distance) {
+    RaceSimulation::PlayerInput input;
+    distance = spline.project(pos, distance, 200.f);
+    const sf::Vector2f target = spline.sample(distance + 90.f).position;
+    const float error = std::remainder(std::atan2(target.y - pos.y, target.x - pos.x) - heading, kTwoPi);
+    input.steer = std::clamp(error * 2.5f, -1.f, 1.f);
+    const float wanted = 300.f * std::max(0.4f, std::cos(error));
+    input.throttle = std::clamp((wanted - speed) / 48.f, -1.f, 1.f);
+    return input;
+  }
+
+  /**
+   * Conductor automático de un cliente: sigue la línea de carrera desde la posición
+   * del último snapshot.
+   */
+  struct NetBot {
+    RaceSimulation track;   ///< Sólo para tener la misma línea de carrera que el servidor.
+    float          distance = 0.f;
+    bool           ready = false;
+
+    RaceSimulation::PlayerInput drive(const NetClient& client) {
+      RaceSimulation::PlayerInput input;
+      const int racer = client.getRacer();
+      const NetSnapshot& latest = client.getLatest();
+      if (racer < 0 || latest.tick == 0 || racer >= static_cast<int>(latest.racers.size())) {
+        return input;
+      }
+      if (!ready) {
+        track.setupDefaultRace(static_cast<std::size_t>(client.getKartCount()));
+        distance = track.getSpline()->project(latest.racers[racer].getPosition());
+        ready = true;
+      }
+      const NetRacerState& me = latest.racers[racer];
+      return steerAlongLine(*track.getSpline(), me.getPosition(), me.getHeading(),
+        static_cast<float>(me.speed), distance);
+    }
+  };
+
+  /**
+   * Conductor automático de un par con rollback: conduce sobre el estado que predice su
+   * propia simulación, como haría un jugador mirando su pantalla.
+   */
+  struct RollbackBot {
+    float distance = 0.f;
+
+    RaceSimulation::PlayerInput drive(const RaceSimulation& sim, int racer) {
+      const auto& me = sim.getRacers()[racer];
+      auto xf = me->getComponent<Transform>();
+      if (!xf || me->isFinished()) {
+        return RaceSimulation::PlayerInput{};
+      }
+      const KartPhysics& kart = *me->getPhysics();
+      RaceSimulation::PlayerInput input = steerAlongLine(*sim.getSpline(), xf->getPosition(), kart.getHeading(),
+        kart.getForwardSpeed(), distance);
+      input.useItem = sim.getItems().getHeld(static_cast<std::size_t>(racer)) != ItemSystem::Item::None;
+      return input;
+    }
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  float secondsSince(const Clock::time_point& start) {
+    return std::chrono::duration<float>(Clock::now() - start).count();
+  }
+
+  float kbits(std::uint64_t bytes, float seconds) {
+    return (seconds > 0.f) ? static_cast<float>(bytes) * 8.f / 1000.f / seconds : 0.f;
+  }
+
+  void printResults(const RaceSimulation& sim) {
+    const auto& racers = sim.getRacers();
+    for (std::uint32_t id : sim.getRanking().getFinishOrder()) {
+      std::printf("  %d. %-10s %8.3f s\n", racers[id]->getPlace(), racers[id]->getName().c_str(), sim.getFinishTime(id));
+    }
+    for (const auto& racer : racers) {
+      if (racer->getPlace() == 0) {
+        std::printf("  -  %-10s DNF (vuelta %d/%d)\n", racer->getName().c_str(),
+          racer->getCurrentLap(), racer->getTotalLaps());
+      }
+    }
+  }
+}
+
+bool NetRaceRunner::parseArgs(int argc, char* argv[], Config& out) {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (std::strcmp(arg, "--net-server") == 0) {
+      out.mode = Mode::Server;
+    }
+    else if (std::strcmp(arg, "--net-client") == 0 && hasValue) {
+      out.mode = Mode::Client;
+      out.host = argv[++i];
+    }
+    else if (std::strcmp(arg, "--net-test") == 0) {
+      out.mode = Mode::Loopback;
+    }
+    else if (std::strcmp(arg, "--rollback-test") == 0) {
+      out.mode = Mode::Rollback;
+    }
+    else if (std::strcmp(arg, "--input-delay") == 0 && hasValue) {
+      out.inputDelay = std::clamp(std::atoi(argv[++i]), 0, 30);
+    }
+    else if (std::strcmp(arg, "--max-rollback") == 0 && hasValue) {
+      out.maxRollback = std::clamp(std::atoi(argv[++i]), 1, 60);
+    }
+    else if (std::strcmp(arg, "--items") == 0) {
+      out.items = true;
+    }
+    else if (std::strcmp(arg, "--port") == 0 && hasValue) {
+      out.port = static_cast<unsigned short>(std::clamp(std::atoi(argv[++i]), 1, 65535));
+    }
+    else if (std::strcmp(arg, "--clients") == 0 && hasValue) {
+      out.clients = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--karts") == 0 && hasValue) {
+      out.karts = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--laps") == 0 && hasValue) {
+      out.laps = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--snapshot-interval") == 0 && hasValue) {
+      out.snapshotInterval = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--latency") == 0 && hasValue) {
+      out.latencyMs = std::max(0.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--jitter") == 0 && hasValue) {
+      out.jitterMs = std::max(0.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--loss") == 0 && hasValue) {
+      out.lossPercent = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.f, 100.f);
+    }
+  }
+  return out.mode != Mode::None;
+}
+
+int NetRaceRunner::run(const Config& config) {
+  switch (config.mode) {
+  case Mode::Server:   return runServer(config);
+  case Mode::Client:   return runClient(config);
+  case Mode::Loopback: return runLoopback(config);
+  case Mode::Rollback: return runRollback(config);
+  default:             return 1;
+  }
+}
+
+void NetRaceRunner::printServerStats(const NetServer& server, float seconds) {
+  const auto& racers = server.getSimulation().getRacers();
+  for (std::size_t i = 0; i < server.getClientCount(); ++i) {
+    const NetServer::ClientStats& stats = server.getClientStats(i);
+    const char* name = (stats.racer >= 0) ? racers[stats.racer]->getName().c_str() : "espectador";
+    std::printf("Cliente %zu (%s): %u snapshots (%.0f %% delta), %.1f B/snapshot, "
+                "bajada %.1f kbit/s, subida %.1f kbit/s, RTT %.0f ms (máx %.0f ms)\n",
+      i + 1, name, stats.snapshots, stats.snapshots ? 100.f * stats.deltas / stats.snapshots : 0.f,
+      stats.snapshots ? static_cast<float>(stats.bytesOut) / stats.snapshots : 0.f,
+      kbits(stats.bytesOut, seconds), kbits(stats.bytesIn, seconds),
+      stats.getRttAverage() * 1000.f, stats.rttMax * 1000.f);
+  }
+}
+
+void NetRaceRunner::printClientStats(const NetClient& client, float seconds, const char* label) {
+  const NetClient::Stats& stats = client.getStats();
+  std::printf("%s (kart %d): %u snapshots, %u perdidos, %u desordenados, %u sin base; "
+              "bajada %.1f kbit/s, subida %.1f kbit/s, RTT %.0f ms (máx %.0f ms)\n",
+    label, client.getRacer(), stats.snapshots, stats.missing, stats.stale, stats.undecodable,
+    kbits(stats.bytesIn, seconds), kbits(stats.bytesOut, seconds),
+    stats.getRttAverage() * 1000.f, stats.rttMax * 1000.f);
+}
+
+int NetRaceRunner::runLoopback(const Config& config) {
+  LoopbackNetwork network(7);
+  LoopbackNetwork::Conditions conditions;
+  conditions.latency = config.latencyMs / 1000.f;
+  conditions.jitter = config.jitterMs / 1000.f;
+  conditions.loss = config.lossPercent / 100.f;
+  network.setConditions(conditions);
+
+  NetServer::Config serverConfig;
+  serverConfig.karts = std::max(config.karts, config.clients);
+  serverConfig.laps = config.laps;
+  serverConfig.hz = config.hz;
+  serverConfig.snapshotInterval = config.snapshotInterval;
+  auto serverEnd = network.createEndpoint();
+  NetServer server;
+  server.start(*serverEnd, serverConfig);
+
+  std::vector<EngineUtilities::TSharedPointer<LoopbackTransport>> ends;
+  std::vector<EngineUtilities::TSharedPointer<NetClient>> clients;
+  std::vector<EngineUtilities::TSharedPointer<NetBot>> bots;
+  std::vector<std::uint32_t> checkedTick(config.clients, 0);
+  for (int i = 0; i < config.clients; ++i) {
+    ends.push_back(network.createEndpoint());
+    clients.push_back(EngineUtilities::MakeShared<NetClient>());
+    bots.push_back(EngineUtilities::MakeShared<NetBot>());
+    clients.back()->connect(*ends.back(), serverEnd->getId());
+  }
+
+  const Clock::time_point start = Clock::now();
+  const float dt = 1.f / config.hz;
+  float time = 0.f;
+  float raceStart = -1.f;
+  float raceOverAt = -1.f;
+  std::uint64_t checked = 0;
+  std::uint64_t mismatched = 0;
+  while (time < config.maxSeconds) {
+    time += dt;
+    network.advance(dt);
+    for (int i = 0; i < config.clients; ++i) {
+      NetClient& client = *clients[i];
+      client.update(time, bots[i]->drive(client));
+      // Lo decodificado debe ser exactamente lo que capturó el servidor.
+      const NetSnapshot& latest = client.getLatest();
+      if (latest.tick != checkedTick[i]) {
+        checkedTick[i] = latest.tick;
+        if (const NetSnapshot* original = server.findSnapshot(latest.tick)) {
+          ++checked;
+          if (original->racers != latest.racers || original->flags != latest.flags) {
+            ++mismatched;
+          }
+        }
+      }
+    }
+    server.poll(time);
+    if (raceStart < 0.f && server.getClientCount() >= static_cast<std::size_t>(config.clients)) {
+      raceStart = time;
+    }
+    if (raceStart >= 0.f) {
+      server.step(time);
+    }
+    if (raceOverAt < 0.f && server.getSimulation().isRaceOver()) {
+      raceOverAt = time;
+    }
+    if (raceOverAt >= 0.f && time - raceOverAt > kLingerSeconds) {
+      break;
+    }
+  }
+  const float wall = secondsSince(start);
+  const float seconds = time - std::max(raceStart, 0.f);
+
+  std::printf("\n=== Red simulada: %d cliente(s), %d karts, %.0f ms +- %.0f ms, %.1f %% pérdida, snapshot cada %d tick(s) ===\n",
+    config.clients, serverConfig.karts, config.latencyMs, config.jitterMs, config.lossPercent, config.snapshotInterval);
+  printResults(server.getSimulation());
+  std::printf("Carrera:          %.1f s simulados en %.3f s reales (conexión en %.2f s)\n",
+    seconds, wall, std::max(raceStart, 0.f));
+  std::printf("Datagramas:       %llu perdidos a propósito\n", static_cast<unsigned long long>(network.getDropped()));
+  std::printf("-- Servidor --\n");
+  printServerStats(server, seconds);
+  std::printf("-- Clientes --\n");
+  for (int i = 0; i < config.clients; ++i) {
+    char label[32];
+    std::snprintf(label, sizeof(label), "Cliente %d", i + 1);
+    printClientStats(*clients[i], seconds, label);
+  }
+  std::printf("Coherencia:       %llu snapshots comparados, %llu distintos\n",
+    static_cast<unsigned long long>(checked), static_cast<unsigned long long>(mismatched));
+  return (mismatched == 0 && checked > 0) ? 0 : 1;
+}
+
+int NetRaceRunner::runRollback(const Config& config) {
+  LoopbackNetwork network(11);
+  LoopbackNetwork::Conditions conditions;
+  conditions.latency = config.latencyMs / 1000.f;
+  conditions.jitter = config.jitterMs / 1000.f;
+  conditions.loss = config.lossPercent / 100.f;
+  network.setConditions(conditions);
+
+  const int peers = std::max(2, config.clients);
+  const std::size_t karts = static_cast<std::size_t>(std::max(config.karts, peers));
+  RollbackSession::Config sessionConfig;
+  sessionConfig.hz = config.hz;
+  sessionConfig.inputDelay = config.inputDelay;
+  sessionConfig.maxRollback = config.maxRollback;
+
+  // Cada par: su simulación, su extremo de red (par = kart) y los mandos que ha aplicado.
+  struct Peer {
+    RaceSimulation sim;
+    EngineUtilities::TSharedPointer<LoopbackTransport> end;
+    RollbackSession session;
+    RollbackBot bot;
+    std::vector<RaceSimulation::PlayerInput> inputs;   ///< Por tick en que se aplican.
+  };
+  auto setupRace = [&](RaceSimulation& sim) {
+    sim.setupDefaultRace(karts);
+    sim.setTotalLaps(config.laps);
+    sim.setItemsEnabled(config.items);
+    sim.reset();
+  };
+  std::vector<EngineUtilities::TSharedPointer<Peer>> group;
+  for (int p = 0; p < peers; ++p) {
+    group.push_back(EngineUtilities::MakeShared<Peer>());
+    group.back()->end = network.createEndpoint();
+    setupRace(group.back()->sim);
+  }
+  for (int p = 0; p < peers; ++p) {
+    std::vector<RollbackSession::Remote> remotes;
+    for (int q = 0; q < peers; ++q) {
+      if (q != p) {
+        RollbackSession::Remote remote;
+        remote.peer = group[q]->end->getId();
+        remote.racer = q;
+        remotes.push_back(remote);
+      }
+    }
+    group[p]->session.start(group[p]->sim, *group[p]->end, p, remotes, sessionConfig);
+  }
+
+  // Tras la llegada (vista por el par 0) se corre un segundo más y se cierra en ese tick.
+  const Clock::time_point start = Clock::now();
+  const float dt = 1.f / config.hz;
+  const std::uint32_t delay = static_cast<std::uint32_t>(config.inputDelay);
+  std::uint32_t endTick = static_cast<std::uint32_t>(config.maxSeconds * config.hz);
+  bool endSet = false;
+  float time = 0.f;
+  for (;;) {
+    time += dt;
+    network.advance(dt);
+    bool done = true;
+    for (int p = 0; p < peers; ++p) {
+      Peer& peer = *group[p];
+      RollbackSession& session = peer.session;
+      if (session.getTick() < endTick) {
+        const std::uint32_t applied = session.getTick() + delay;
+        const RaceSimulation::PlayerInput input = peer.bot.drive(peer.sim, p);
+        if (session.advance(input)) {
+          peer.inputs.resize(std::max<std::size_t>(peer.inputs.size(), applied + 1));
+          peer.inputs[applied] = quantizeInput(input);
+        }
+      }
+      else {
+        session.poll();
+      }
+      done = done && session.getTick() >= endTick && session.getConfirmedTick() >= endTick;
+    }
+    if (!endSet && group[0]->sim.isRaceOver()) {
+      endTick = std::min(endTick, group[0]->session.getTick() + static_cast<std::uint32_t>(config.hz));
+      endSet = true;
+    }
+    if (done || time > config.maxSeconds + 10.f) {
+      break;
+    }
+  }
+  const float wall = secondsSince(start);
+
+  // Referencia: los mismos mandos aplicados directamente, sin red ni predicción.
+  RaceSimulation reference;
+  setupRace(reference);
+  for (int p = 0; p < peers; ++p) {
+    reference.setRemoteControl(p, true);
+  }
+  for (std::uint32_t t = 0; t < endTick; ++t) {
+    for (int p = 0; p < peers; ++p) {
+      const auto& inputs = group[p]->inputs;
+      reference.setRacerInput(p, (t < inputs.size()) ? inputs[t] : RaceSimulation::PlayerInput{});
+    }
+    reference.step(dt);
+  }
+  const std::uint32_t expected = reference.checksum();
+
+  std::printf("\n=== Rollback: %d pares, %zu karts, %.0f ms +- %.0f ms, %.1f %% pérdida, "
+              "retardo de entrada %d tick(s), rollback máx %d ===\n",
+    peers, karts, config.latencyMs, config.jitterMs, config.lossPercent, config.inputDelay, config.maxRollback);
+  printResults(group[0]->sim);
+  std::printf("Carrera:          %u ticks (%.1f s) en %.3f s reales, estado de %zu bytes\n",
+    endTick, static_cast<float>(endTick) * dt, wall, group[0]->session.getStateSize());
+  std::printf("Datagramas:       %llu perdidos a propósito\n", static_cast<unsigned long long>(network.getDropped()));
+  if (config.items) {
+    const ItemSystem& items = group[0]->sim.getItems();
+    std::printf("Objetos:          %u lanzados, %u impactos, %zu vivos como máximo\n",
+      items.getSpawned(), items.getHits(), items.getPeakLive());
+  }
+  int matching = 0;
+  for (int p = 0; p < peers; ++p) {
+    const RollbackSession::Stats& stats = group[p]->session.getStats();
+    const double saveUs = stats.saves ? 1e6 * stats.saveSeconds / stats.saves : 0.0;
+    const double loadUs = stats.loads ? 1e6 * stats.loadSeconds / stats.loads : 0.0;
+    const double resimUs = stats.resimulated ? 1e6 * stats.resimSeconds / stats.resimulated : 0.0;
+    const bool same = group[p]->sim.checksum() == expected && group[p]->session.getTick() == endTick;
+    matching += same ? 1 : 0;
+    std::printf("Par %d (%s): %u ticks, %u esperas, %u predicciones fallidas, %u rollbacks "
+                "(media %.1f ticks, máx %u); guardar %.2f us, restaurar %.2f us, re-simular %.1f us/tick; "
+                "subida %.1f kbit/s; %s\n",
+      p + 1, group[p]->sim.getRacers()[p]->getName().c_str(), stats.ticks, stats.stalls, stats.mispredictions,
+      stats.rollbacks, stats.rollbacks ? static_cast<float>(stats.resimulated) / stats.rollbacks : 0.f,
+      stats.maxDepth, saveUs, loadUs, resimUs, kbits(stats.bytesOut, time),
+      same ? "igual a la referencia" : "DISTINTO de la referencia");
+  }
+  std::printf("Coherencia:       %d/%d pares iguales a la referencia en el tick %u (huella %08x)\n",
+    matching, peers, endTick, expected);
+  return (matching == peers) ? 0 : 1;
+}
+
+int NetRaceRunner::runServer(const Config& config) {
+  UdpTransport transport;
+  if (!transport.bind(config.port)) {
+    std::cerr << "NetRaceRunner::runServer : no se pudo abrir el puerto " << config.port << "\n";
+    return 1;
+  }
+  NetServer::Config serverConfig;
+  serverConfig.karts = std::max(config.karts, config.clients);
+  serverConfig.laps = config.laps;
+  serverConfig.hz = config.hz;
+  serverConfig.snapshotInterval = config.snapshotInterval;
+  NetServer server;
+  server.start(transport, serverConfig);
+  std::printf("Servidor en el puerto %u: esperando %d cliente(s)...\n", config.port, config.clients);
+
+  const Clock::time_point start = Clock::now();
+  const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.hz));
+  Clock::time_point next = start;
+  float raceStart = -1.f;
+  float raceOverAt = -1.f;
+  for (;;) {
+    const float now = secondsSince(start);
+    server.poll(now);
+    if (raceStart < 0.f) {
+      if (server.getClientCount() >= static_cast<std::size_t>(config.clients)) {
+        raceStart = now;
+        std::printf("Salida (%.1f s)\n", now);
+      }
+      else if (now > kWaitTimeout) {
+        std::cerr << "NetRaceRunner::runServer : no se conectaron todos los clientes\n";
+        return 1;
+      }
+    }
+    if (raceStart >= 0.f) {
+      server.step(now);
+      if (raceOverAt < 0.f && server.getSimulation().isRaceOver()) {
+        raceOverAt = now;
+      }
+      if ((raceOverAt >= 0.f && now - raceOverAt > kLingerSeconds) || now - raceStart > config.maxSeconds) {
+        break;
+      }
+    }
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+
+  const float seconds = secondsSince(start) - raceStart;
+  std::printf("\n=== Servidor: %zu cliente(s), %.1f s de carrera ===\n", server.getClientCount(), seconds);
+  printResults(server.getSimulation());
+  printServerStats(server, seconds);
+  return 0;
+}
+
+int NetRaceRunner::runClient(const Config& config) {
+  const std::optional<sf::IpAddress> address = sf::IpAddress::resolve(config.host);
+  if (!address) {
+    std::cerr << "NetRaceRunner::runClient : no se pudo resolver " << config.host << "\n";
+    return 1;
+  }
+  UdpTransport transport;
+  if (!transport.bind(0)) {
+    std::cerr << "NetRaceRunner::runClient : no se pudo abrir un puerto local\n";
+    return 1;
+  }
+  const int serverPeer = transport.addPeer(*address, config.port);
+  NetClient client;
+  client.connect(transport, serverPeer);
+  NetBot bot;
+
+  const Clock::time_point start = Clock::now();
+  Clock::time_point next = start;
+  auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.hz));
+  float connectedAt = -1.f;
+  float lastSnapshotAt = 0.f;
+  std::uint32_t lastTick = 0;
+  for (;;) {
+    const float now = secondsSince(start);
+    client.update(now, bot.drive(client));
+    if (connectedAt < 0.f && client.isConnected()) {
+      connectedAt = now;
+      lastSnapshotAt = now;
+      period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / client.getHz()));
+      std::printf("Conectado a %s:%u, kart %d de %d\n", config.host.c_str(), config.port,
+        client.getRacer(), client.getKartCount());
+    }
+    if (connectedAt < 0.f && now > kConnectTimeout) {
+      std::cerr << "NetRaceRunner::runClient : el servidor no contesta\n";
+      return 1;
+    }
+    if (client.getLatest().tick != lastTick) {
+      lastTick = client.getLatest().tick;
+      lastSnapshotAt = now;
+    }
+    if (client.isRaceOver()) {
+      break;
+    }
+    if (connectedAt >= 0.f && lastTick != 0 && now - lastSnapshotAt > kSilenceTimeout) {
+      std::cerr << "NetRaceRunner::runClient : el servidor dejó de enviar snapshots\n";
+      break;
+    }
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+
+  const float seconds = secondsSince(start) - std::max(connectedAt, 0.f);
+  std::printf("\n=== Cliente: %.1f s conectado ===\n", seconds);
+  const NetSnapshot& latest = client.getLatest();
+  if (client.getRacer() >= 0 && client.getRacer() < static_cast<int>(latest.racers.size())) {
+    const NetRacerState& me = latest.racers[client.getRacer()];
+    std::printf("Kart %d: puesto %d, vuelta %d\n", client.getRacer(), me.place, me.lap);
+  }
+  printClientStats(client, seconds, "Cliente");
+  return 0;
+}
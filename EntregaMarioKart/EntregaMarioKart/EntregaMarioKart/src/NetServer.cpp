@@ -0,0 +1,152 @@
+#include "NetServer.h"
+
+#include <algorithm>
+
+void NetServer::start(NetTransport& transport, const Config& config) {
+  m_transport = &transport;
+  m_config = config;
+  m_config.snapshotInterval = std::max(1, m_config.snapshotInterval);
+  m_clients.clear();
+  m_history.assign(kHistorySize, HistoryEntry{});
+  m_tick = 0;
+
+  m_sim.setupDefaultRace(static_cast<std::size_t>(std::max(1, config.karts)));
+  m_sim.setTotalLaps(config.laps);
+  m_sim.setCollisionsEnabled(config.collisions);
+  m_sim.reset();
+}
+
+NetServer::Client* NetServer::findClient(int peer) {
+  for (Client& client : m_clients) {
+    if (client.peer == peer) {
+      return &client;
+    }
+  }
+  return nullptr;
+}
+
+void NetServer::poll(float now) {
+  if (!m_transport) {
+    return;
+  }
+  int peer = -1;
+  std::vector<std::uint8_t> packet;
+  while (m_transport->receive(peer, packet)) {
+    if (packet.empty()) {
+      continue;
+    }
+    NetReader in(packet);
+    const auto type = static_cast<NetMessage>(in.getByte());
+    if (type == NetMessage::Hello) {
+      handleHello(peer, packet.size());
+    }
+    else if (type == NetMessage::Input) {
+      if (Client* client = findClient(peer)) {
+        client->stats.bytesIn += packet.size();
+        ++client->stats.packetsIn;
+        handleInput(*client, in, now);
+      }
+    }
+  }
+}
+
+void NetServer::handleHello(int peer, std::size_t bytes) {
+  Client* client = findClient(peer);
+  if (!client) {
+    // Primer kart que aún conduce la IA; sin plaza, el cliente mira (racer = -1).
+    int racer = -1;
+    for (int i = 0; i < static_cast<int>(m_sim.getRacers().size()); ++i) {
+      const bool taken = std::any_of(m_clients.begin(), m_clients.end(),
+        [i](const Client& other) { return other.stats.racer == i; });
+      if (!taken) {
+        racer = i;
+        break;
+      }
+    }
+    Client added;
+    added.peer = peer;
+    added.stats.racer = racer;
+    m_clients.push_back(added);
+    client = &m_clients.back();
+    m_sim.setRemoteControl(racer, true);
+  }
+  client->stats.bytesIn += bytes;
+  ++client->stats.packetsIn;
+
+  // El Hello se repite hasta que llega el Welcome: se contesta siempre.
+  m_packet.clear();
+  NetWriter out(m_packet);
+  out.putByte(static_cast<std::uint8_t>(NetMessage::Welcome));
+  out.putSigned(client->stats.racer);
+  out.putVarint(static_cast<std::uint32_t>(m_sim.getRacers().size()));
+  out.putVarint(static_cast<std::uint32_t>(m_config.laps));
+  out.putFloat(m_config.hz);
+  out.putVarint(static_cast<std::uint32_t>(m_config.snapshotInterval));
+  m_transport->send(peer, m_packet);
+  client->stats.bytesOut += m_packet.size();
+}
+
+void NetServer::handleInput(Client& client, NetReader& in, float now) {
+  const std::uint32_t inputTick = in.getVarint();
+  const std::uint32_t ack = in.getVarint();
+  const RaceSimulation::PlayerInput input = in.getInput();
+  if (!in.ok()) {
+    return;
+  }
+  if (inputTick > client.lastInputTick) {
+    client.lastInputTick = inputTick;
+    m_sim.setRacerInput(client.stats.racer, input);
+  }
+  if (ack > client.ackedSnapshot) {
+    client.ackedSnapshot = ack;
+    const HistoryEntry& entry = m_history[(ack / m_config.snapshotInterval) % kHistorySize];
+    if (entry.snapshot.tick == ack) {
+      const float rtt = now - entry.sentAt;
+      client.stats.rttSum += rtt;
+      client.stats.rttMax = std::max(client.stats.rttMax, rtt);
+      ++client.stats.rttSamples;
+    }
+  }
+}
+
+void NetServer::step(float now) {
+  if (!m_sim.isRaceOver()) {
+    m_sim.step(1.f / m_config.hz);
+  }
+  ++m_tick;
+  if (m_tick % static_cast<std::uint32_t>(m_config.snapshotInterval) == 0) {
+    sendSnapshots(now);
+  }
+}
+
+const NetSnapshot* NetServer::findSnapshot(std::uint32_t tick) const {
+  if (tick == 0) {
+    return nullptr;
+  }
+  const HistoryEntry& entry = m_history[(tick / m_config.snapshotInterval) % kHistorySize];
+  return (entry.snapshot.tick == tick) ? &entry.snapshot : nullptr;
+}
+
+void NetServer::sendSnapshots(float now) {
+  HistoryEntry& entry = m_history[(m_tick / m_config.snapshotInterval) % kHistorySize];
+  entry.snapshot.capture(m_sim, m_tick, 1.f / m_config.hz);
+  entry.sentAt = now;
+
+  for (Client& client : m_clients) {
+    const NetSnapshot* base = findSnapshot(client.ackedSnapshot);
+    m_packet.clear();
+    NetWriter out(m_packet);
+    out.putByte(static_cast<std::uint8_t>(NetMessage::Snapshot));
+    out.putVarint(m_tick);
+    out.putVarint(base ? base->tick : 0);
+    out.putVarint(client.lastInputTick);  // eco: RTT medido en el cliente
+    entry.snapshot.encode(out, base);
+    m_transport->send(client.peer, m_packet);
+
+    client.stats.bytesOut += m_packet.size();
+    ++client.stats.snapshots;
+    if (base) {
+      ++client.stats.deltas;
+    }
+  }
+}
@@ -0,0 +1,90 @@
+#include "NetTransport.h"
+
+#include <algorithm>
+
+EngineUtilities::TSharedPointer<LoopbackTransport> LoopbackNetwork::createEndpoint() {
+  return EngineUtilities::MakeShared<LoopbackTransport>(*this, m_endpoints++);
+}
+
+float LoopbackNetwork::random01() {
+  // xorshift32: barato y reproducible entre plataformas.
+  m_rng ^= m_rng << 13;
+  m_rng ^= m_rng >> 17;
+  m_rng ^= m_rng << 5;
+  return static_cast<float>(m_rng >> 8) / 16777216.f;
+}
+
+void LoopbackNetwork::post(int from, int to, const std::vector<std::uint8_t>& data) {
+  if (m_conditions.loss > 0.f && random01() < m_conditions.loss) {
+    ++m_dropped;
+    return;
+  }
+  Datagram datagram;
+  datagram.deliverAt = m_time + m_conditions.latency + m_conditions.jitter * random01();
+  datagram.order = m_sent++;
+  datagram.from = from;
+  datagram.to = to;
+  datagram.data = data;
+  m_inFlight.push_back(std::move(datagram));
+}
+
+bool LoopbackNetwork::take(int to, int& from, std::vector<std::uint8_t>& data) {
+  // Pocos datagramas en vuelo: búsqueda lineal del primero que ya ha llegado.
+  auto best = m_inFlight.end();
+  for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ++it) {
+    if (it->to != to || it->deliverAt > m_time) {
+      continue;
+    }
+    if (best == m_inFlight.end() || it->deliverAt < best->deliverAt
+        || (it->deliverAt == best->deliverAt && it->order < best->order)) {
+      best = it;
+    }
+  }
+  if (best == m_inFlight.end()) {
+    return false;
+  }
+  from = best->from;
+  data = std::move(best->data);
+  *best = std::move(m_inFlight.back());
+  m_inFlight.pop_back();
+  return true;
+}
+
+bool UdpTransport::bind(unsigned short port) {
+  m_socket.setBlocking(false);
+  return m_socket.bind(port) == sf::Socket::Status::Done;
+}
+
+int UdpTransport::addPeer(const sf::IpAddress& address, unsigned short port) {
+  for (std::size_t i = 0; i < m_peers.size(); ++i) {
+    if (m_peers[i].address == address && m_peers[i].port == port) {
+      return static_cast<int>(i);
+    }
+  }
+  Peer peer;
+  peer.address = address;
+  peer.port = port;
+  m_peers.push_back(peer);
+  return static_cast<int>(m_peers.size()) - 1;
+}
+
+void UdpTransport::send(int peer, const std::vector<std::uint8_t>& packet) {
+  if (peer < 0 || peer >= static_cast<int>(m_peers.size())) {
+    return;
+  }
+  // No fiable por definición: un envío fallido es un datagrama perdido.
+  (void)m_socket.send(packet.data(), packet.size(), m_peers[peer].address, m_peers[peer].port);
+}
+
+bool UdpTransport::receive(int& peer, std::vector<std::uint8_t>& packet) {
+  std::size_t received = 0;
+  std::optional<sf::IpAddress> address;
+  unsigned short port = 0;
+  if (m_socket.receive(m_buffer.data(), m_buffer.size(), received, address, port) != sf::Socket::Status::Done
+      || !address) {
+    return false;
+  }
+  peer = addPeer(*address, port);
+  packet.assign(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(received));
+  return true;
+}
@@ -0,0 +1,311 @@
+#include "RaceBatchRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+  std::vector<float> parseList(const char* text) {
+    std::vector<float> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (!item.empty()) {
+        values.push_back(static_cast<float>(std::atof(item.c_str())));
+      }
+    }
+    return values;
+  }
+
+  /**
+   * Media, desviación típica, mínimo y percentiles de una muestra (se ordena in situ).
+   */
+  struct Stats {
+    double mean = 0.0, stddev = 0.0, min = 0.0, p50 = 0.0, p90 = 0.0;
+  };
+
+  Stats computeStats(std::vector<float>& v) {
+    Stats s;
+    if (v.empty()) {
+      return s;
+    }
+    std::sort(v.begin(), v.end());
+    const double n = static_cast<double>(v.size());
+    s.mean = std::accumulate(v.begin(), v.end(), 0.0) / n;
+    double var = 0.0;
+    for (float x : v) {
+      var += (x - s.mean) * (x - s.mean);
+    }
+    s.stddev = std::sqrt(var / n);
+    s.min = v.front();
+    s.p50 = v[static_cast<std::size_t>(0.5 * (n - 1))];
+    s.p90 = v[static_cast<std::size_t>(0.9 * (n - 1))];
+    return s;
+  }
+
+} // namespace
+
+bool RaceBatchRunner::parseArgs(int argc, char* argv[], Config& out) {
+  bool batch = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (std::strcmp(arg, "--batch") == 0) {
+      batch = true;
+    }
+    else if (std::strcmp(arg, "--races") == 0 && hasValue) {
+      out.racesPerCombo = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--laps") == 0 && hasValue) {
+      out.laps = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+      out.threads = std::max(0, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+      out.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(arg, "--jitter") == 0 && hasValue) {
+      out.speedJitter = std::max(0.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--no-shuffle") == 0) {
+      out.shuffleGrid = false;
+    }
+    else if (std::strcmp(arg, "--tune") == 0 && hasValue) {
+      out.tunedRacer = argv[++i];
+    }
+    else if (std::strcmp(arg, "--speeds") == 0 && hasValue) {
+      out.speeds = parseList(argv[++i]);
+    }
+    else if (std::strcmp(arg, "--lookaheads") == 0 && hasValue) {
+      out.lookaheads = parseList(argv[++i]);
+    }
+    else if (std::strcmp(arg, "--arrive") == 0 && hasValue) {
+      out.arriveRadii = parseList(argv[++i]);
+    }
+    else if (std::strcmp(arg, "--csv") == 0 && hasValue) {
+      out.csvPath = argv[++i];
+    }
+  }
+  return batch;
+}
+
+int RaceBatchRunner::run(const Config& config) {
+  m_config = config;
+
+  // --- Valores por defecto de la parrilla (los mismos que usa el juego) ---
+  RaceSimulation reference;
+  reference.setupDefaultRace();
+  m_names.clear();
+  m_baseSpeeds.clear();
+  m_baseLookaheads.clear();
+  m_baseArriveRadii.clear();
+  m_tunedIdx = -1;
+  for (const auto& racer : reference.getRacers()) {
+    if (racer->getName() == m_config.tunedRacer) {
+      m_tunedIdx = static_cast<int>(m_names.size());
+    }
+    m_names.push_back(racer->getName());
+    m_baseSpeeds.push_back(racer->getMaxSpeed());
+    m_baseLookaheads.push_back(racer->getLookaheadDistance());
+    m_baseArriveRadii.push_back(racer->getArriveRadius());
+  }
+  if (m_tunedIdx < 0) {
+    std::cerr << "RaceBatchRunner::run : no hay ningún corredor \"" << m_config.tunedRacer << "\" (--tune). Corredores:";
+    for (const std::string& name : m_names) {
+      std::cerr << " " << name;
+    }
+    std::cerr << "\n";
+    return 1;
+  }
+
+  // --- Producto cartesiano del barrido ---
+  auto orDefault = [](const std::vector<float>& v, float def) {
+    return v.empty() ? std::vector<float>{ def } : v;
+  };
+  std::vector<Combo> combos;
+  for (float speed : orDefault(m_config.speeds, m_baseSpeeds[m_tunedIdx])) {
+    for (float look : orDefault(m_config.lookaheads, m_baseLookaheads[m_tunedIdx])) {
+      for (float arrive : orDefault(m_config.arriveRadii, m_baseArriveRadii[m_tunedIdx])) {
+        combos.push_back({ speed, look, arrive });
+      }
+    }
+  }
+
+  const std::size_t totalRaces = combos.size() * static_cast<std::size_t>(m_config.racesPerCombo);
+  std::vector<RaceResult> results(totalRaces);
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned threadCount = static_cast<unsigned>(std::min<std::size_t>(
+    m_config.threads > 0 ? static_cast<unsigned>(m_config.threads) : hw, totalRaces));
+
+  std::printf("Lote: %zu combinaciones x %d carreras = %zu carreras, %u hilo(s), ajustando '%s'\n",
+    combos.size(), m_config.racesPerCombo, totalRaces, threadCount, m_names[m_tunedIdx].c_str());
+
+  // --- Reparto dinámico: cada hilo toma la siguiente carrera libre ---
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  std::atomic<std::size_t> next{ 0 };
+  auto workerMain = [&]() {
+    Worker worker;
+    worker.sim.setupDefaultRace();
+    worker.roster = worker.sim.getRacers();
+    for (std::size_t i = next.fetch_add(1); i < totalRaces; i = next.fetch_add(1)) {
+      const Combo& combo = combos[i / m_config.racesPerCombo];
+      simulate(worker, combo, m_config.seed + static_cast<std::uint32_t>(i), results[i]);
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threadCount; ++t) {
+    pool.emplace_back(workerMain);
+  }
+  workerMain();
+  for (auto& th : pool) {
+    th.join();
+  }
+  const double wall = std::max(1e-9, std::chrono::duration<double>(Clock::now() - start).count());
+
+  // --- Resumen por combinación del corredor ajustado ---
+  for (std::size_t c = 0; c < combos.size(); ++c) {
+    int wins = 0;
+    double finishSum = 0.0;
+    int finished = 0;
+    for (int r = 0; r < m_config.racesPerCombo; ++r) {
+      const RaceResult& res = results[c * m_config.racesPerCombo + r];
+      wins += (res.places[m_tunedIdx] == 1) ? 1 : 0;
+      if (res.places[m_tunedIdx] != 0) {
+        finishSum += res.finishTimes[m_tunedIdx];
+        ++finished;
+      }
+    }
+    std::printf("  maxSpeed %6.1f  lookahead %5.1f  arrive %5.1f  -> victorias %5.1f %%  llegada media %7.2f s\n",
+      combos[c].maxSpeed, combos[c].lookahead, combos[c].arriveRadius,
+      100.0 * wins / m_config.racesPerCombo, finished ? finishSum / finished : 0.0);
+  }
+  std::printf("Tiempo real: %.3f s (%.0f carreras/minuto)\n", wall, totalRaces * 60.0 / wall);
+
+  if (!writeCsv(combos, results)) {
+    std::fprintf(stderr, "ERROR: RaceBatchRunner::run : no se pudo escribir %s\n", m_config.csvPath.c_str());
+    return 1;
+  }
+  std::printf("CSV: %s\n", m_config.csvPath.c_str());
+  return 0;
+}
+
+void RaceBatchRunner::simulate(Worker& worker, const Combo& combo, std::uint32_t seed, RaceResult& out) const {
+  const std::size_t n = worker.roster.size();
+  const int laps = m_config.laps;
+  std::mt19937 rng(seed);
+
+  // Parrilla sorteada: el orden de addRacer() decide el carril de salida.
+  std::vector<std::size_t> grid(n);
+  std::iota(grid.begin(), grid.end(), std::size_t{ 0 });
+  if (m_config.shuffleGrid) {
+    std::shuffle(grid.begin(), grid.end(), rng);
+  }
+
+  std::uniform_real_distribution<float> jitter(-m_config.speedJitter, m_config.speedJitter);
+  RaceSimulation& sim = worker.sim;
+  sim.clearRacers();
+  for (std::size_t idx : grid) {
+    auto& racer = worker.roster[idx];
+    const bool tuned = (static_cast<int>(idx) == m_tunedIdx);
+    racer->setMaxSpeed((tuned ? combo.maxSpeed : m_baseSpeeds[idx]) * (1.f + jitter(rng)));
+    racer->setLookaheadDistance(tuned ? combo.lookahead : m_baseLookaheads[idx]);
+    racer->setArriveRadius(tuned ? combo.arriveRadius : m_baseArriveRadii[idx]);
+    sim.addRacer(racer);
+  }
+  sim.setTotalLaps(laps);
+  sim.reset();
+
+  out.places.assign(n, 0);
+  out.finishTimes.assign(n, -1.f);
+  out.lapTimes.assign(n * laps, -1.f);
+  std::vector<int> lastLap(n, 0);
+
+  // Tiempos de vuelta de LapTimer (interpolados dentro del tick), por índice de parrilla.
+  const LapTimer& timer = sim.getLapTimer();
+  const float dt = 1.f / m_config.hz;
+  while (!sim.isRaceOver() && sim.getRaceTime() < m_config.maxRaceSeconds) {
+    sim.step(dt);
+    for (std::size_t g = 0; g < n; ++g) {
+      const LapTimer::LapRecord& rec = timer.getRecord(g);
+      if (rec.lap > lastLap[g] && rec.lap <= laps) {
+        out.lapTimes[grid[g] * laps + (rec.lap - 1)] = rec.lastLap;
+        lastLap[g] = rec.lap;
+      }
+    }
+  }
+
+  for (std::size_t g = 0; g < n; ++g) {
+    const std::size_t idx = grid[g];
+    out.places[idx] = static_cast<std::uint8_t>(worker.roster[idx]->getPlace());
+    out.finishTimes[idx] = sim.getFinishTime(g);
+  }
+}
+
+bool RaceBatchRunner::writeCsv(const std::vector<Combo>& combos, const std::vector<RaceResult>& results) const {
+  std::ofstream csv(m_config.csvPath);
+  if (!csv) {
+    return false;
+  }
+  const std::size_t n = m_names.size();
+  const int laps = m_config.laps;
+
+  csv << "combo,max_speed,lookahead,arrive_radius,racer,tuned,races,wins,win_rate,avg_place";
+  for (std::size_t p = 1; p <= n; ++p) {
+    csv << ",place_" << p;
+  }
+  csv << ",dnf,finish_mean,finish_std,finish_min,finish_p50,finish_p90,lap_mean,lap_std,lap_min,lap_p50,lap_p90\n";
+
+  std::vector<float> finishTimes;
+  std::vector<float> lapTimes;
+  for (std::size_t c = 0; c < combos.size(); ++c) {
+    for (std::size_t i = 0; i < n; ++i) {
+      std::vector<int> placeCount(n + 1, 0);
+      finishTimes.clear();
+      lapTimes.clear();
+      double placeSum = 0.0;
+      for (int r = 0; r < m_config.racesPerCombo; ++r) {
+        const RaceResult& res = results[c * m_config.racesPerCombo + r];
+        const int place = res.places[i];
+        ++placeCount[std::min<std::size_t>(place, n)];
+        if (place != 0) {
+          placeSum += place;
+          finishTimes.push_back(res.finishTimes[i]);
+        }
+        for (int l = 0; l < laps; ++l) {
+          const float t = res.lapTimes[i * laps + l];
+          if (t >= 0.f) {
+            lapTimes.push_back(t);
+          }
+        }
+      }
+      const int races = m_config.racesPerCombo;
+      const int finished = races - placeCount[0];
+      const Stats fs = computeStats(finishTimes);
+      const Stats ls = computeStats(lapTimes);
+
+      csv << c << ',' << combos[c].maxSpeed << ',' << combos[c].lookahead << ',' << combos[c].arriveRadius
+        << ',' << m_names[i] << ',' << (static_cast<int>(i) == m_tunedIdx ? 1 : 0)
+        << ',' << races << ',' << placeCount[1] << ',' << static_cast<double>(placeCount[1]) / races
+        << ',' << (finished ? placeSum / finished : 0.0);
+      for (std::size_t p = 1; p <= n; ++p) {
+        csv << ',' << placeCount[p];
+      }
+      csv << ',' << placeCount[0]
+        << ',' << fs.mean << ',' << fs.stddev << ',' << fs.min << ',' << fs.p50 << ',' << fs.p90
+        << ',' << ls.mean << ',' << ls.stddev << ',' << ls.min << ',' << ls.p50 << ',' << ls.p90 << '\n';
+    }
+  }
+  return static_cast<bool>(csv);
+}
@@ -0,0 +1,82 @@
+#include "RaceRanking.h"
+
+#include <numeric>
+
+namespace {
+  /// Por encima de cualquier progreso posible: los que han terminado van siempre delante.
+  constexpr float kFinishedKey = 1.0e6f;
+}
+
+void RaceRanking::reset(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers) {
+  m_racers = racers;
+  const std::size_t n = racers.size();
+  m_order.resize(n);
+  std::iota(m_order.begin(), m_order.end(), 0u);
+  m_finishOrder.clear();
+  m_finishOrder.reserve(n);
+  m_positions.resize(n);
+  m_keys.assign(n, 0.f);
+  m_finished.assign(n, 0);
+  m_newFinishers = 0;
+  m_lastSwaps = 0;
+  update();
+}
+
+void RaceRanking::saveState(StateWriter& out) const {
+  out.putVector(m_order);
+  out.putVector(m_finishOrder);
+  out.putVector(m_positions);
+  out.putVector(m_keys);
+  out.putVector(m_finished);
+  out.put(m_newFinishers);
+  out.put(m_lastSwaps);
+}
+
+void RaceRanking::loadState(StateReader& in) {
+  in.getVector(m_order);
+  in.getVector(m_finishOrder);
+  in.getVector(m_positions);
+  in.getVector(m_keys);
+  in.getVector(m_finished);
+  in.get(m_newFinishers);
+  in.get(m_lastSwaps);
+}
+
+std::size_t RaceRanking::update() {
+  // Llegadas: se recorre el orden anterior para que, en el mismo tick, gane el que iba delante.
+  const std::size_t before = m_finishOrder.size();
+  for (std::uint32_t id : m_order) {
+    if (!m_finished[id] && m_racers[id]->isFinished()) {
+      m_finished[id] = 1;
+      m_finishOrder.push_back(id);
+      m_keys[id] = kFinishedKey - static_cast<float>(m_finishOrder.size());
+    }
+  }
+  m_newFinishers = m_finishOrder.size() - before;
+
+  for (std::size_t id = 0; id < m_racers.size(); ++id) {
+    if (!m_finished[id]) {
+      m_keys[id] = m_racers[id]->getRaceProgress();
+    }
+  }
+
+  // Inserción sobre el orden anterior: casi ordenado, O(n + adelantamientos).
+  m_lastSwaps = 0;
+  for (std::size_t i = 1; i < m_order.size(); ++i) {
+    const std::uint32_t id = m_order[i];
+    const float key = m_keys[id];
+    std::size_t j = i;
+    while (j > 0 && m_keys[m_order[j - 1]] < key) {
+      m_order[j] = m_order[j - 1];
+      --j;
+      ++m_lastSwaps;
+    }
+    m_order[j] = id;
+  }
+
+  for (std::size_t pos = 0; pos < m_order.size(); ++pos) {
+    m_positions[m_order[pos]] = static_cast<int>(pos) + 1;
+    m_racers[m_order[pos]]->setStanding(static_cast<int>(pos) + 1);
+  }
+  return m_newFinishers;
+}
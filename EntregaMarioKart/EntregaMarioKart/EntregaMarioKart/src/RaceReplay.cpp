@@ -0,0 +1,275 @@
+#include "RaceReplay.h"
+#include "BinaryIO.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+  using BinaryIO::getVarint;
+  using BinaryIO::putVarint;
+  using BinaryIO::readValue;
+  using BinaryIO::remainingBytes;
+  using BinaryIO::unzigzag;
+  using BinaryIO::writeValue;
+  using BinaryIO::zigzag;
+
+  constexpr std::uint32_t kReplayMagic = 0x314C5052; // "RPL1"
+  constexpr std::uint32_t kReplayVersion = 4;
+
+  /** Más karts de los que caben en cualquier parrilla: una cabecera así está corrupta. */
+  constexpr std::uint16_t kMaxKarts = 256;
+
+  constexpr std::uint8_t kPlayerBit = 1 << 0;
+  constexpr std::uint8_t kThrottleBit = 1 << 1;
+  constexpr std::uint8_t kSteerBit = 1 << 2;
+  constexpr std::uint8_t kDriftBit = 1 << 3;
+  constexpr std::uint8_t kItemBit = 1 << 4;
+
+  std::int8_t quantize(float v) {
+    return static_cast<std::int8_t>(std::lround(std::clamp(v, -1.f, 1.f) * 127.f));
+  }
+}
+
+RaceReplay::Setup RaceReplay::capture(const RaceSimulation& sim, float hz, bool imageSurface) {
+  Setup setup;
+  setup.karts = static_cast<std::uint16_t>(sim.getRacers().size());
+  setup.laps = static_cast<std::uint8_t>(sim.getTotalLaps());
+  setup.sectors = static_cast<std::uint8_t>(sim.getSectorCount());
+  setup.collisions = sim.areCollisionsEnabled() ? 1 : 0;
+  setup.imageSurface = imageSurface ? 1 : 0;
+  setup.racingLine = sim.getRacingLine() ? 1 : 0;
+  setup.kartPhysics = sim.isKartPhysicsAI() ? 1 : 0;
+  setup.items = sim.areItemsEnabled() ? 1 : 0;
+  setup.hz = hz;
+  return setup;
+}
+
+bool RaceReplay::apply(RaceSimulation& sim) const {
+  sim.setTotalLaps(m_setup.laps);
+  sim.setSectorCount(m_setup.sectors);
+  sim.setCollisionsEnabled(m_setup.collisions != 0);
+  sim.setKartPhysicsAI(m_setup.kartPhysics != 0);
+  sim.setItemsEnabled(m_setup.items != 0);
+  sim.setupDefaultRace(m_setup.karts);
+  bool ok = true;
+  if (m_setup.imageSurface) {
+    ok = sim.loadDefaultTrackSurface();
+  }
+  if (m_setup.racingLine) {
+    ok = sim.loadDefaultRacingLine() && ok;
+  }
+  sim.reset();
+  return ok;
+}
+
+void RaceReplay::begin(const Setup& setup) {
+  m_setup = setup;
+  m_stream.clear();
+  m_checksums.clear();
+  m_tickCount = 0;
+  m_written = Frame{};
+  m_pending = Frame{};
+  m_run = 0;
+  rewind();
+}
+
+void RaceReplay::recordStep(RaceSimulation& sim, float dt) {
+  Frame frame;
+  frame.player = static_cast<std::int8_t>(sim.getPlayer());
+  frame.throttle = quantize(sim.getPlayerInput().throttle);
+  frame.steer = quantize(sim.getPlayerInput().steer);
+  frame.drift = sim.getPlayerInput().drift ? 1 : 0;
+  frame.item = sim.getPlayerInput().useItem ? 1 : 0;
+  if (m_run > 0 && frame == m_pending) {
+    ++m_run;
+  }
+  else {
+    flush();
+    m_pending = frame;
+    m_run = 1;
+  }
+
+  if (frame.player >= 0) {
+    RaceSimulation::PlayerInput input;
+    input.throttle = frame.throttle / 127.f;
+    input.steer = frame.steer / 127.f;
+    input.drift = frame.drift != 0;
+    input.useItem = frame.item != 0;
+    sim.setPlayerInput(input);
+  }
+  sim.step(dt);
+  if (++m_tickCount % kChecksumInterval == 0) {
+    m_checksums.push_back(sim.checksum());
+  }
+}
+
+void RaceReplay::flush() {
+  if (m_run == 0) {
+    return;
+  }
+  std::uint8_t flags = 0;
+  flags |= (m_pending.player != m_written.player) ? kPlayerBit : 0;
+  flags |= (m_pending.throttle != m_written.throttle) ? kThrottleBit : 0;
+  flags |= (m_pending.steer != m_written.steer) ? kSteerBit : 0;
+  flags |= (m_pending.drift != m_written.drift) ? kDriftBit : 0; // 0/1: basta el bit de cambio
+  flags |= (m_pending.item != m_written.item) ? kItemBit : 0;
+  m_stream.push_back(flags);
+  if (flags & kPlayerBit) {
+    putVarint(m_stream, zigzag(m_pending.player - m_written.player));
+  }
+  if (flags & kThrottleBit) {
+    putVarint(m_stream, zigzag(m_pending.throttle - m_written.throttle));
+  }
+  if (flags & kSteerBit) {
+    putVarint(m_stream, zigzag(m_pending.steer - m_written.steer));
+  }
+  putVarint(m_stream, m_run - 1);
+  m_written = m_pending;
+  m_run = 0;
+}
+
+void RaceReplay::rewind() {
+  m_cursor = 0;
+  m_decoded = Frame{};
+  m_left = 0;
+  m_played = 0;
+  m_desyncTick = 0;
+}
+
+bool RaceReplay::decode() {
+  if (m_cursor >= m_stream.size()) {
+    return false;
+  }
+  const std::uint8_t flags = m_stream[m_cursor++];
+  std::uint32_t v = 0;
+  if ((flags & kPlayerBit) && getVarint(m_stream, m_cursor, v)) {
+    m_decoded.player = static_cast<std::int8_t>(m_decoded.player + unzigzag(v));
+  }
+  if ((flags & kThrottleBit) && getVarint(m_stream, m_cursor, v)) {
+    m_decoded.throttle = static_cast<std::int8_t>(m_decoded.throttle + unzigzag(v));
+  }
+  if ((flags & kSteerBit) && getVarint(m_stream, m_cursor, v)) {
+    m_decoded.steer = static_cast<std::int8_t>(m_decoded.steer + unzigzag(v));
+  }
+  if (flags & kDriftBit) {
+    m_decoded.drift = static_cast<std::int8_t>(1 - m_decoded.drift);
+  }
+  if (flags & kItemBit) {
+    m_decoded.item = static_cast<std::int8_t>(1 - m_decoded.item);
+  }
+  if (!getVarint(m_stream, m_cursor, v)) {
+    return false;
+  }
+  m_left = v + 1;
+  return true;
+}
+
+bool RaceReplay::playStep(RaceSimulation& sim, float dt) {
+  if (m_played >= m_tickCount || (m_left == 0 && !decode())) {
+    return false;
+  }
+  --m_left;
+
+  if (m_decoded.player != sim.getPlayer()) {
+    sim.setPlayer(m_decoded.player);
+  }
+  if (m_decoded.player >= 0) {
+    RaceSimulation::PlayerInput input;
+    input.throttle = m_decoded.throttle / 127.f;
+    input.steer = m_decoded.steer / 127.f;
+    input.drift = m_decoded.drift != 0;
+    input.useItem = m_decoded.item != 0;
+    sim.setPlayerInput(input);
+  }
+  sim.step(dt);
+
+  ++m_played;
+  if (m_played % kChecksumInterval == 0 && m_desyncTick == 0) {
+    const std::size_t k = m_played / kChecksumInterval - 1;
+    if (k < m_checksums.size() && m_checksums[k] != sim.checksum()) {
+      m_desyncTick = m_played;
+    }
+  }
+  return true;
+}
+
+bool RaceReplay::save(const std::string& path) {
+  flush();
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  writeValue(out, kReplayMagic);
+  writeValue(out, kReplayVersion);
+  writeValue(out, m_setup.karts);
+  writeValue(out, m_setup.laps);
+  writeValue(out, m_setup.sectors);
+  writeValue(out, m_setup.collisions);
+  writeValue(out, m_setup.imageSurface);
+  writeValue(out, m_setup.racingLine);
+  writeValue(out, m_setup.kartPhysics);
+  writeValue(out, m_setup.items);
+  writeValue(out, m_setup.hz);
+  writeValue(out, m_tickCount);
+  const auto streamSize = static_cast<std::uint32_t>(m_stream.size());
+  const auto checksumCount = static_cast<std::uint32_t>(m_checksums.size());
+  writeValue(out, streamSize);
+  writeValue(out, checksumCount);
+  out.write(reinterpret_cast<const char*>(m_stream.data()), static_cast<std::streamsize>(m_stream.size()));
+  out.write(reinterpret_cast<const char*>(m_checksums.data()),
+    static_cast<std::streamsize>(m_checksums.size() * sizeof(std::uint32_t)));
+  return static_cast<bool>(out);
+}
+
+bool RaceReplay::load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::uint32_t magic = 0, version = 0, streamSize = 0, checksumCount = 0;
+  Setup setup;
+  std::uint32_t ticks = 0;
+  readValue(in, magic);
+  readValue(in, version);
+  readValue(in, setup.karts);
+  readValue(in, setup.laps);
+  readValue(in, setup.sectors);
+  readValue(in, setup.collisions);
+  readValue(in, setup.imageSurface);
+  readValue(in, setup.racingLine);
+  readValue(in, setup.kartPhysics);
+  readValue(in, setup.items);
+  readValue(in, setup.hz);
+  readValue(in, ticks);
+  readValue(in, streamSize);
+  readValue(in, checksumCount);
+  if (!in || magic != kReplayMagic || version != kReplayVersion || !(setup.hz > 0.f)) {
+    return false;
+  }
+  // Hay una huella cada kChecksumInterval ticks, y apply() monta la parrilla con setup.karts.
+  const std::uint64_t payload = static_cast<std::uint64_t>(streamSize) +
+    static_cast<std::uint64_t>(checksumCount) * sizeof(std::uint32_t);
+  if (setup.karts > kMaxKarts || checksumCount > ticks / kChecksumInterval || payload > remainingBytes(in)) {
+    std::cerr << "RaceReplay::load : cabecera no válida en " << path << "\n";
+    return false;
+  }
+  std::vector<std::uint8_t> stream(streamSize);
+  std::vector<std::uint32_t> checksums(checksumCount);
+  in.read(reinterpret_cast<char*>(stream.data()), static_cast<std::streamsize>(streamSize));
+  in.read(reinterpret_cast<char*>(checksums.data()),
+    static_cast<std::streamsize>(checksumCount * sizeof(std::uint32_t)));
+  if (!in) {
+    return false;
+  }
+
+  m_setup = setup;
+  m_stream = std::move(stream);
+  m_checksums = std::move(checksums);
+  m_tickCount = ticks;
+  m_written = Frame{};
+  m_pending = Frame{};
+  m_run = 0;
+  rewind();
+  return true;
+}
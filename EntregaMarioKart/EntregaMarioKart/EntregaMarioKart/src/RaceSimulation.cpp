@@ -0,0 +1,566 @@
+#include "RaceSimulation.h"
+#include "ECS/Transform.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  constexpr float kRadToDeg = 57.2957795f;
+
+  float dot(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return a.x * b.x + a.y * b.y;
+  }
+
+  using Hash::fnv1a;
+}
+
+const std::vector<std::string>& RaceSimulation::defaultCharacters() {
+  static const std::vector<std::string> names = { "princesa", "sonic", "virdo", "wario" };
+  return names;
+}
+
+void RaceSimulation::setupDefaultRace(std::size_t racerCount) {
+  clearRacers();
+  const float speeds[] = { 160.f, 155.f, 165.f, 150.f };
+  const auto& names = defaultCharacters();
+  for (std::size_t i = 0; i < racerCount; ++i) {
+    const std::size_t c = i % names.size();
+    const std::string name = (i < names.size()) ? names[c] : names[c] + "_" + std::to_string(i / names.size());
+    auto racer = EngineUtilities::MakeShared<A_Racer>(name);
+    racer->setMaxSpeed(speeds[c % 4]);
+    addRacer(racer);
+  }
+
+  setTrack({
+    { 512.f, 660.f }, { 780.f, 650.f }, { 900.f, 560.f }, { 920.f, 380.f },
+    { 880.f, 200.f }, { 720.f, 110.f }, { 512.f, 100.f }, { 300.f, 110.f },
+    { 140.f, 200.f }, { 100.f, 380.f }, { 130.f, 560.f }, { 250.f, 650.f } });
+  reset();
+}
+
+void RaceSimulation::addRacer(const EngineUtilities::TSharedPointer<A_Racer>& racer) {
+  m_racers.push_back(racer);
+  m_finishTimes.push_back(-1.f);
+}
+
+void RaceSimulation::clearRacers() {
+  setPlayer(-1);
+  m_remoteKarts.clear();
+  m_racers.clear();
+  m_ranking.reset(m_racers);
+  m_finishTimes.clear();
+  m_grid.clear();
+}
+
+void RaceSimulation::setTrack(const std::vector<sf::Vector2f>& path) {
+  m_path = path;
+  m_spline.reset();
+  m_racingLine.reset(); // calculada para la línea anterior
+  if (m_surfaceFromSpline) {
+    m_surface.reset();
+  }
+}
+
+void RaceSimulation::setSurface(const EngineUtilities::TSharedPointer<TrackSurface>& surface) {
+  m_surface = surface;
+  m_surfaceFromSpline = false;
+}
+
+bool RaceSimulation::loadDefaultTrackSurface() {
+  if (!m_spline || m_spline->empty()) {
+    return false;
+  }
+  auto surface = EngineUtilities::MakeShared<TrackSurface>();
+  if (!surface->loadOrBuild("bin/pista de carreras.png", "bin/pista de carreras.surface")
+      || surface->roadCoverage(*m_spline) <= 0.9f) {
+    return false;
+  }
+  setSurface(surface);
+  return true;
+}
+
+bool RaceSimulation::loadDefaultRacingLine() {
+  if (!m_spline || m_spline->empty()) {
+    return false;
+  }
+  auto line = EngineUtilities::MakeShared<RacingLine>();
+  if (!line->load("bin/pista de carreras.line", *m_spline)) {
+    return false;
+  }
+  m_racingLine = line;
+  return true;
+}
+
+void RaceSimulation::reset() {
+  // Una sola LUT compartida; cada corredor sólo guarda su carril.
+  if (!m_spline) {
+    m_spline = EngineUtilities::MakeShared<RacingSpline>();
+    m_spline->build(m_path, true);
+  }
+  if (!m_surface && !m_spline->empty()) {
+    // Sin imagen (headless): calzada de ancho fijo alrededor de la línea.
+    sf::Vector2f lo = m_spline->getSamples().front().position;
+    sf::Vector2f hi = lo;
+    for (const auto& sample : m_spline->getSamples()) {
+      lo = { std::min(lo.x, sample.position.x), std::min(lo.y, sample.position.y) };
+      hi = { std::max(hi.x, sample.position.x), std::max(hi.y, sample.position.y) };
+    }
+    auto surface = EngineUtilities::MakeShared<TrackSurface>();
+    const float margin = m_roadHalfWidth + surface->getWallDistance() + 32.f;
+    surface->buildFromSpline(*m_spline, m_roadHalfWidth,
+      sf::FloatRect(lo - sf::Vector2f{ margin, margin }, (hi - lo) + sf::Vector2f{ 2.f * margin, 2.f * margin }));
+    m_surface = surface;
+    m_surfaceFromSpline = true;
+  }
+
+  // Parrilla en filas de m_gridColumns detrás de la salida. Con muchos karts se
+  // ensancha hasta m_maxGridColumns (más carriles no pasarían por la meta) y
+  // después se juntan las filas para que la última no dé la vuelta al circuito.
+  const std::size_t n = m_racers.size();
+  const float usable = 0.8f * m_spline->getLength();
+  const std::size_t maxRows = std::max<std::size_t>(1, static_cast<std::size_t>(usable / m_rowSpacing));
+  const std::size_t columns = std::clamp((n + maxRows - 1) / maxRows, m_gridColumns, m_maxGridColumns);
+  const std::size_t rows = (n + columns - 1) / columns;
+  const float rowSpacing = std::min(m_rowSpacing, usable / static_cast<float>(std::max<std::size_t>(rows, 1)));
+  const std::size_t lanes = std::min(columns, std::max<std::size_t>(n, 1));
+  const float center = 0.5f * static_cast<float>(lanes - 1);
+  for (std::size_t i = 0; i < n; ++i) {
+    auto& racer = m_racers[i];
+    const float lane = (static_cast<float>(i % columns) - center) * m_laneSpacing;
+    const float row = static_cast<float>(i / columns);
+    racer->setTotalLaps(m_totalLaps);
+    racer->setPath(m_path);
+    racer->setSpline(m_spline, lane, -row * rowSpacing);
+    racer->setRacingLine(m_racingLine);
+    racer->setPhysicsDriven(m_kartPhysicsAI);
+  }
+  m_avoidCursor = 0;
+  m_contactCount = 0;
+
+  // Puertas de lado a lado de lo transitable: cubren el asfalto y el arcén hasta el muro.
+  m_lapTimer.build(*m_spline, m_sectorCount, m_roadHalfWidth + (m_surface ? m_surface->getWallDistance() : 0.f));
+  m_lapTimer.reset(m_racers);
+
+  std::fill(m_finishTimes.begin(), m_finishTimes.end(), -1.f);
+  m_raceTime = 0.f;
+  setPlayer(m_playerIdx);
+  m_ranking.reset(m_racers);
+
+  m_grid.clear();
+  updateGrid();
+  m_items.reset(*this);
+}
+
+void RaceSimulation::setPlayer(int idx) {
+  if (m_playerIdx >= 0 && m_playerIdx < static_cast<int>(m_racers.size())) {
+    m_racers[m_playerIdx]->setManualControl(false);
+  }
+  m_playerIdx = (idx >= 0 && idx < static_cast<int>(m_racers.size())) ? idx : -1;
+  m_playerInput = PlayerInput{};
+  if (m_playerIdx < 0) {
+    return;
+  }
+  m_remoteKarts.erase(std::remove_if(m_remoteKarts.begin(), m_remoteKarts.end(),
+    [&](const RemoteKart& remote) { return remote.idx == m_playerIdx; }), m_remoteKarts.end());
+
+  // Un kart de la IA con física conserva su inercia al pasar al jugador.
+  auto& racer = m_racers[m_playerIdx];
+  auto xf = racer->getComponent<Transform>();
+  if (xf && !racer->isPhysicsDriven()) {
+    racer->getPhysics()->reset((xf->getRotation() - racer->getSpriteAngleOffset()) / kRadToDeg);
+  }
+  racer->setManualControl(true);
+}
+
+void RaceSimulation::step(float dt) {
+  for (auto& racer : m_racers) {
+    if (auto xf = racer->getComponent<Transform>()) {
+      xf->storePrevious();
+    }
+  }
+
+  if (m_collisionsEnabled) {
+    updateAvoidance();
+  }
+  applySurface();
+  updatePlayer(dt);
+  for (auto& racer : m_racers) {
+    racer->update(dt);
+  }
+  updateGrid();
+  if (m_collisionsEnabled) {
+    resolveCollisions(dt);
+  }
+  enforceWalls(dt);
+  if (m_itemsEnabled) {
+    m_items.update(*this, dt);
+  }
+
+  if (isRaceOver()) {
+    return;
+  }
+  if (m_ranking.size() != m_racers.size()) {
+    m_ranking.reset(m_racers); // corredores añadidos sin reset()
+    m_lapTimer.reset(m_racers);
+  }
+  // Cruces del tick [m_raceTime, m_raceTime + dt] con el movimiento ya resuelto.
+  m_lapTimer.update(m_racers, m_raceTime, dt);
+  m_raceTime += dt;
+  if (m_ranking.update() > 0) {
+    const auto& finish = m_ranking.getFinishOrder();
+    for (std::size_t k = finish.size() - m_ranking.getNewFinishers(); k < finish.size(); ++k) {
+      m_racers[finish[k]]->setPlace(static_cast<int>(k) + 1);
+      m_finishTimes[finish[k]] = m_lapTimer.getRecord(finish[k]).lapStart;
+    }
+  }
+}
+
+void RaceSimulation::updateGrid() {
+  for (std::size_t i = 0; i < m_racers.size(); ++i) {
+    auto xf = m_racers[i]->getComponent<Transform>();
+    if (xf && !m_racers[i]->isFinished()) {
+      m_grid.update(static_cast<std::uint32_t>(i), xf->getPosition(), m_racerRadius);
+    }
+    else {
+      m_grid.remove(static_cast<std::uint32_t>(i));
+    }
+  }
+}
+
+void RaceSimulation::keepNearestNeighbors(const sf::Vector2f& center) {
+  if (m_neighbors.size() <= m_maxNeighbors) {
+    return;
+  }
+  auto dist2 = [&](std::uint32_t id) {
+    const sf::Vector2f d = m_grid.getPosition(id) - center;
+    return dot(d, d);
+  };
+  std::nth_element(m_neighbors.begin(), m_neighbors.begin() + m_maxNeighbors, m_neighbors.end(),
+    [&](std::uint32_t a, std::uint32_t b) { return dist2(a) < dist2(b); });
+  m_neighbors.resize(m_maxNeighbors);
+}
+
+void RaceSimulation::updateAvoidance() {
+  const std::size_t n = m_racers.size();
+  if (n == 0 || !m_spline || m_spline->empty()) {
+    return;
+  }
+  // Hueco lateral necesario para pasar sin tocarse.
+  const float clearance = 2.f * m_racerRadius + m_avoidMargin;
+  const float closeRange = 2.5f * m_racerRadius;
+  const std::size_t budget = std::min(n, m_avoidBudget);
+
+  for (std::size_t k = 0; k < budget; ++k) {
+    const std::size_t i = (m_avoidCursor + k) % n;
+    auto& racer = m_racers[i];
+    auto xf = racer->getComponent<Transform>();
+    if (!xf || racer->isManualControl() || racer->isFinished()) {
+      continue;
+    }
+    const sf::Vector2f pos = xf->getPosition();
+    const RacingSpline::Sample here = m_spline->sample(racer->getTrackDistance());
+    const sf::Vector2f normal{ -here.tangent.y, here.tangent.x };
+
+    m_grid.queryRadius(pos, m_avoidRange, m_neighbors, static_cast<std::uint32_t>(i));
+    keepNearestNeighbors(pos);
+
+    float shift = 0.f;
+    float speedScale = 1.f;
+    for (std::uint32_t j : m_neighbors) {
+      const sf::Vector2f rel = m_grid.getPosition(j) - pos;
+      const float fwd = dot(rel, here.tangent);
+      const float lat = dot(rel, normal);
+      const float overlap = clearance - std::abs(lat);
+      if (overlap <= 0.f || fwd < -m_racerRadius) {
+        continue; // fuera de mi trazada o ya adelantado
+      }
+      // Se adelanta por el lado contrario al rival; si está justo delante,
+      // hacia el centro de la parrilla.
+      const float side = (lat > 0.f) ? -1.f : (lat < 0.f) ? 1.f : (racer->getLaneOffset() > 0.f ? -1.f : 1.f);
+      const float weight = 1.f - std::max(0.f, fwd) / m_avoidRange;
+      shift += side * overlap * weight;
+
+      // Pegado detrás sin hueco todavía: levantar el pie en lugar de empujar.
+      if (fwd > 0.f && fwd < closeRange && std::abs(lat) < 1.5f * m_racerRadius) {
+        speedScale = std::min(speedScale, 0.7f + 0.3f * fwd / closeRange);
+      }
+    }
+
+    // Sin tráfico se vuelve al carril; con tráfico el desvío se acumula sobre el actual.
+    const float target = (shift != 0.f)
+      ? std::clamp(racer->getAvoidanceOffset() + shift, -m_maxAvoidOffset, m_maxAvoidOffset)
+      : 0.f;
+    racer->setAvoidance(target, speedScale);
+  }
+  m_avoidCursor = (m_avoidCursor + budget) % n;
+}
+
+void RaceSimulation::applySurface() {
+  if (!m_surface) {
+    return;
+  }
+  for (auto& racer : m_racers) {
+    auto xf = racer->getComponent<Transform>();
+    if (!xf || racer->isManualControl() || racer->isFinished()) {
+      continue;
+    }
+    const bool offroad = m_surface->getSurface(xf->getPosition()) != TrackSurface::Surface::Road;
+    racer->setTerrain(offroad ? m_offroadSpeedScale : 1.f,
+      offroad && m_surface->getDistance(xf->getPosition()) > m_racerRadius);
+  }
+}
+
+void RaceSimulation::enforceWalls(float dt) {
+  if (!m_surface) {
+    return;
+  }
+  const float wall = m_surface->getWallDistance();
+  for (std::size_t i = 0; i < m_racers.size(); ++i) {
+    auto& racer = m_racers[i];
+    auto xf = racer->getComponent<Transform>();
+    if (!xf || racer->isFinished()) {
+      continue;
+    }
+    sf::Vector2f pos = xf->getPosition();
+    if (m_surface->getSurface(pos) != TrackSurface::Surface::Wall) {
+      continue;
+    }
+    // Se retrocede por el gradiente del campo de distancia hasta salir del muro.
+    const sf::Vector2f outward = m_surface->getGradient(pos);
+    const float depth = std::max(m_surface->getDistance(pos) - wall, 0.f) + 1.f;
+    pos -= outward * depth;
+    for (int iter = 0; iter < 8 && m_surface->getSurface(pos) == TrackSurface::Surface::Wall; ++iter) {
+      pos -= outward * 4.f; // muros pintados en la máscara, más cerca que wallDistance
+    }
+    xf->setPosition(pos);
+
+    // Sin velocidad hacia el muro (choque plástico, desliza a lo largo de él).
+    const float into = dot(racerVelocity(i, dt), outward);
+    if (into > 0.f) {
+      applyImpulse(i, -outward * into);
+    }
+  }
+}
+
+sf::Vector2f RaceSimulation::racerVelocity(std::size_t idx, float dt) const {
+  if (m_racers[idx]->isPhysicsDriven()) {
+    return m_racers[idx]->getPhysics()->getVelocity() + m_racers[idx]->getBumpVelocity();
+  }
+  auto xf = m_racers[idx]->getComponent<Transform>();
+  return (xf && dt > 0.f) ? (xf->getPosition() - xf->getPreviousPosition()) / dt : sf::Vector2f{ 0.f, 0.f };
+}
+
+void RaceSimulation::applyImpulse(std::size_t idx, const sf::Vector2f& deltaVelocity) {
+  auto& racer = m_racers[idx];
+  if (!racer->isPhysicsDriven()) {
+    racer->addImpulse(deltaVelocity);
+    return;
+  }
+  // Con física: la componente longitudinal frena/acelera el kart; la lateral es rebote.
+  KartPhysics& kart = *racer->getPhysics();
+  const sf::Vector2f forward = kart.getForward();
+  const float along = dot(deltaVelocity, forward);
+  kart.addVelocity(forward * along);
+  racer->addImpulse(deltaVelocity - forward * along);
+}
+
+void RaceSimulation::resolveCollisions(float dt) {
+  m_contactCount = 0;
+  const float minDist = 2.f * m_racerRadius;
+  // La rejilla puede ir unos píxeles por detrás de las correcciones de este mismo bucle.
+  const float queryRadius = m_racerRadius + 2.f;
+
+  for (std::size_t i = 0; i < m_racers.size(); ++i) {
+    if (!m_grid.contains(static_cast<std::uint32_t>(i))) {
+      continue;
+    }
+    auto xfi = m_racers[i]->getComponent<Transform>();
+    m_grid.queryRadius(xfi->getPosition(), queryRadius, m_neighbors, static_cast<std::uint32_t>(i));
+    keepNearestNeighbors(xfi->getPosition());
+
+    for (std::uint32_t j : m_neighbors) {
+      if (j < i) {
+        continue; // cada par una sola vez
+      }
+      auto xfj = m_racers[j]->getComponent<Transform>();
+      const sf::Vector2f d = xfj->getPosition() - xfi->getPosition();
+      const float dist2 = dot(d, d);
+      if (dist2 >= minDist * minDist) {
+        continue;
+      }
+      const float dist = std::sqrt(dist2);
+      const sf::Vector2f normal = (dist > 1e-4f) ? d / dist : sf::Vector2f{ 1.f, 0.f };
+
+      // Separación a partes iguales (misma masa).
+      const sf::Vector2f push = normal * (0.5f * (minDist - dist));
+      xfi->setPosition(xfi->getPosition() - push);
+      xfj->setPosition(xfj->getPosition() + push);
+
+      // Impulso sólo si se acercan.
+      const float approach = dot(racerVelocity(j, dt) - racerVelocity(i, dt), normal);
+      if (approach < 0.f) {
+        const float impulse = -(1.f + m_restitution) * approach * 0.5f;
+        applyImpulse(i, -normal * impulse);
+        applyImpulse(j, normal * impulse);
+      }
+      ++m_contactCount;
+    }
+  }
+}
+
+bool RaceSimulation::isRaceOver() const {
+  return !m_racers.empty() && m_ranking.getFinishedCount() == m_racers.size();
+}
+
+float RaceSimulation::getFinishTime(std::size_t idx) const {
+  return (idx < m_finishTimes.size()) ? m_finishTimes[idx] : -1.f;
+}
+
+std::uint32_t RaceSimulation::checksum() const {
+  std::uint32_t h = Hash::kFnv32Seed;
+  h = fnv1a(h, &m_raceTime, sizeof(m_raceTime));
+  for (const auto& racer : m_racers) {
+    if (auto xf = racer->getComponent<Transform>()) {
+      const sf::Vector2f pos = xf->getPosition();
+      h = fnv1a(h, &pos, sizeof(pos));
+    }
+    const std::int32_t lap[] = { racer->getCurrentLap(), racer->getSector(), racer->getPlace() };
+    h = fnv1a(h, lap, sizeof(lap));
+    if (racer->isPhysicsDriven()) {
+      const KartPhysics& kart = *racer->getPhysics();
+      const float state[] = { kart.getVelocity().x, kart.getVelocity().y, kart.getHeading(), kart.getBoostTime() };
+      h = fnv1a(h, state, sizeof(state));
+    }
+  }
+  h = fnv1a(h, &m_playerIdx, sizeof(m_playerIdx));
+  if (m_itemsEnabled) {
+    const std::uint32_t items[] = { static_cast<std::uint32_t>(m_items.getLiveCount()), m_items.getSpawned(), m_items.getHits() };
+    h = fnv1a(h, items, sizeof(items));
+  }
+  return h;
+}
+
+void RaceSimulation::saveState(std::vector<std::uint8_t>& out) const {
+  StateWriter writer(out);
+  writer.put(static_cast<std::uint32_t>(m_racers.size()));
+  for (const auto& racer : m_racers) {
+    writer.put(racer->getState());
+  }
+  writer.put(m_raceTime);
+  writer.putVector(m_finishTimes);
+  writer.put(m_avoidCursor);
+  writer.put(m_contactCount);
+  writer.put(m_playerIdx);
+  writer.put(m_playerInput);
+  writer.putVector(m_remoteKarts);
+  m_lapTimer.saveState(writer);
+  m_ranking.saveState(writer);
+  m_grid.saveState(writer);
+  m_items.saveState(writer);
+}
+
+bool RaceSimulation::loadState(const std::vector<std::uint8_t>& in) {
+  StateReader reader(in);
+  std::uint32_t count = 0;
+  reader.get(count);
+  if (!reader.ok() || count != m_racers.size()) {
+    std::cerr << "RaceSimulation::loadState : el estado es de otra parrilla\n";
+    return false;
+  }
+  A_Racer::State state;
+  for (auto& racer : m_racers) {
+    reader.get(state);
+    racer->setState(state);
+  }
+  reader.get(m_raceTime);
+  reader.getVector(m_finishTimes);
+  reader.get(m_avoidCursor);
+  reader.get(m_contactCount);
+  reader.get(m_playerIdx);
+  reader.get(m_playerInput);
+  reader.getVector(m_remoteKarts);
+  m_lapTimer.loadState(reader);
+  m_ranking.loadState(reader);
+  m_grid.loadState(reader);
+  m_items.loadState(reader);
+  if (!reader.ok() || !reader.atEnd()) {
+    std::cerr << "RaceSimulation::loadState : estado truncado\n";
+    return false;
+  }
+  return true;
+}
+
+void RaceSimulation::setRemoteControl(int idx, bool remote) {
+  if (idx < 0 || idx >= static_cast<int>(m_racers.size()) || idx == m_playerIdx) {
+    return;
+  }
+  auto it = std::find_if(m_remoteKarts.begin(), m_remoteKarts.end(),
+    [idx](const RemoteKart& kart) { return kart.idx == idx; });
+  if (remote == (it != m_remoteKarts.end())) {
+    return;
+  }
+  auto& racer = m_racers[idx];
+  if (!remote) {
+    racer->setManualControl(false);
+    m_remoteKarts.erase(it);
+    return;
+  }
+  auto xf = racer->getComponent<Transform>();
+  if (xf && !racer->isPhysicsDriven()) {
+    racer->getPhysics()->reset((xf->getRotation() - racer->getSpriteAngleOffset()) / kRadToDeg);
+  }
+  racer->setManualControl(true);
+  RemoteKart kart;
+  kart.idx = idx;
+  m_remoteKarts.push_back(kart);
+}
+
+void RaceSimulation::setRacerInput(int idx, const PlayerInput& input) {
+  if (idx == m_playerIdx) {
+    m_playerInput = input;
+    return;
+  }
+  for (RemoteKart& kart : m_remoteKarts) {
+    if (kart.idx == idx) {
+      kart.input = input;
+      return;
+    }
+  }
+}
+
+void RaceSimulation::updatePlayer(float dt) {
+  if (m_playerIdx >= 0 && m_playerIdx < static_cast<int>(m_racers.size())) {
+    driveKart(m_playerIdx, m_playerInput, dt);
+  }
+  for (const RemoteKart& kart : m_remoteKarts) {
+    driveKart(kart.idx, kart.input, dt);
+  }
+}
+
+void RaceSimulation::driveKart(int idx, const PlayerInput& playerInput, float dt) {
+  auto& racer = m_racers[idx];
+  auto xf = racer->getComponent<Transform>();
+  if (!xf || racer->isFinished()) {
+    return;
+  }
+
+  if (m_itemsEnabled && playerInput.useItem) {
+    m_items.useItem(*this, static_cast<std::size_t>(idx));
+  }
+
+  // Tras un impacto el kart gira sin control hasta que pasa el trompo.
+  KartPhysics::Input input;
+  if (racer->getSpinTime() <= 0.f) {
+    input.throttle = std::clamp(playerInput.throttle, -1.f, 1.f);
+    input.steer = std::clamp(playerInput.steer, -1.f, 1.f);
+    input.drift = playerInput.drift;
+  }
+
+  // Todo por dt (sub-pasos si el tick es largo): la conducción no depende de la frecuencia.
+  KartPhysics& kart = *racer->getPhysics();
+  kart.setParams(m_playerKart);
+  kart.setOffroadSpeedScale(m_offroadSpeedScale);
+  kart.setInput(input);
+  kart.integrate(*xf, dt, m_surface.get(), racer->getSpriteAngleOffset());
+}
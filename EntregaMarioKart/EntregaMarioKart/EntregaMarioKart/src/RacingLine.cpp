@@ -0,0 +1,113 @@
+#include "RacingLine.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+  constexpr std::uint32_t kLineMagic = 0x314E4C52; // "RLN1"
+  constexpr std::uint32_t kLineVersion = 1;
+  constexpr float kOffsetScale = 4.f;              ///< Cuartos de píxel.
+  constexpr float kSpeedScale = 65535.f;
+
+  using Hash::fnv1a;
+}
+
+std::uint64_t RacingLine::splineKey(const RacingSpline& spline) {
+  std::uint64_t key = Hash::kFnv64Seed;
+  for (const auto& sample : spline.getSamples()) {
+    const std::int32_t q[] = { static_cast<std::int32_t>(std::lround(sample.position.x * 4.f)),
+                               static_cast<std::int32_t>(std::lround(sample.position.y * 4.f)) };
+    key = fnv1a(key, q, sizeof(q));
+  }
+  return key;
+}
+
+void RacingLine::assign(const RacingSpline& spline, const std::vector<float>& offsets,
+                        const std::vector<float>& speedScales) {
+  const std::size_t n = std::min({ spline.getSampleCount(), offsets.size(), speedScales.size() });
+  m_offsets.resize(n);
+  m_speeds.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    m_offsets[i] = static_cast<std::int16_t>(std::clamp(std::lround(offsets[i] * kOffsetScale), -32767l, 32767l));
+    m_speeds[i] = static_cast<std::uint16_t>(std::lround(std::clamp(speedScales[i], 0.f, 1.f) * kSpeedScale));
+  }
+  m_key = splineKey(spline);
+  m_length = spline.getLength();
+  m_invStep = 1.f / spline.getStep();
+}
+
+std::size_t RacingLine::locate(float s, float& u) const {
+  s = std::fmod(s, m_length);
+  if (s < 0.f) {
+    s += m_length;
+  }
+  const float f = s * m_invStep;
+  const std::size_t i = std::min(static_cast<std::size_t>(f), m_offsets.size() - 1);
+  u = f - static_cast<float>(i);
+  return i;
+}
+
+float RacingLine::getOffset(float s) const {
+  if (m_offsets.empty()) {
+    return 0.f;
+  }
+  float u = 0.f;
+  const std::size_t i = locate(s, u);
+  const std::size_t j = (i + 1) % m_offsets.size();
+  return (m_offsets[i] + (m_offsets[j] - m_offsets[i]) * u) / kOffsetScale;
+}
+
+float RacingLine::getSpeedScale(float s) const {
+  if (m_speeds.empty()) {
+    return 1.f;
+  }
+  float u = 0.f;
+  const std::size_t i = locate(s, u);
+  const std::size_t j = (i + 1) % m_speeds.size();
+  return (m_speeds[i] + (static_cast<float>(m_speeds[j]) - m_speeds[i]) * u) / kSpeedScale;
+}
+
+bool RacingLine::save(const std::string& path) const {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  const std::uint32_t header[] = { kLineMagic, kLineVersion, static_cast<std::uint32_t>(m_offsets.size()) };
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(&m_key), sizeof(m_key));
+  out.write(reinterpret_cast<const char*>(m_offsets.data()),
+    static_cast<std::streamsize>(m_offsets.size() * sizeof(std::int16_t)));
+  out.write(reinterpret_cast<const char*>(m_speeds.data()),
+    static_cast<std::streamsize>(m_speeds.size() * sizeof(std::uint16_t)));
+  return static_cast<bool>(out);
+}
+
+bool RacingLine::load(const std::string& path, const RacingSpline& spline) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::uint32_t header[3] = {};
+  std::uint64_t key = 0;
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  in.read(reinterpret_cast<char*>(&key), sizeof(key));
+  if (!in || header[0] != kLineMagic || header[1] != kLineVersion
+      || header[2] != spline.getSampleCount() || key != splineKey(spline)) {
+    return false;
+  }
+  std::vector<std::int16_t> offsets(header[2]);
+  std::vector<std::uint16_t> speeds(header[2]);
+  in.read(reinterpret_cast<char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(std::int16_t)));
+  in.read(reinterpret_cast<char*>(speeds.data()), static_cast<std::streamsize>(speeds.size() * sizeof(std::uint16_t)));
+  if (!in || offsets.empty()) {
+    return false;
+  }
+  m_offsets = std::move(offsets);
+  m_speeds = std::move(speeds);
+  m_key = key;
+  m_length = spline.getLength();
+  m_invStep = 1.f / spline.getStep();
+  return true;
+}
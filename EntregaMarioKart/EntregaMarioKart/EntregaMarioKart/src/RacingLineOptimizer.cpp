@@ -0,0 +1,235 @@
+#include "RacingLineOptimizer.h"
+#include "RaceSimulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+  constexpr int   kCoarseStride = 4;     ///< Muestras de la LUT por punto de la rejilla gruesa.
+  constexpr float kWidthStep = 2.f;      ///< Paso de la búsqueda del borde (px).
+  constexpr float kMaxWidth = 300.f;     ///< Búsqueda máxima a cada lado (px).
+  constexpr float kRelaxRate = 0.06f;    ///< < 1/8 para que la cuarta diferencia sea estable.
+
+  float dot(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return a.x * b.x + a.y * b.y;
+  }
+
+  float length(const sf::Vector2f& v) {
+    return std::sqrt(v.x * v.x + v.y * v.y);
+  }
+
+  /**
+   * Descenso de la curvatura: mueve cada punto por su normal contra la cuarta diferencia
+   * (P[i-2] - 4P[i-1] + 6P[i] - 4P[i+1] + P[i+2]) y lo limita al ancho disponible.
+   */
+  void relax(const std::vector<sf::Vector2f>& center, const std::vector<sf::Vector2f>& normal,
+             const std::vector<float>& lo, const std::vector<float>& hi,
+             std::vector<float>& offset, int iterations) {
+    const int m = static_cast<int>(center.size());
+    if (m < 5) {
+      return;
+    }
+    std::vector<sf::Vector2f> p(m);
+    std::vector<float> next(m);
+    auto at = [&](int i) -> const sf::Vector2f& { return p[(i % m + m) % m]; };
+    for (int it = 0; it < iterations; ++it) {
+      for (int i = 0; i < m; ++i) {
+        p[i] = center[i] + normal[i] * offset[i];
+      }
+      for (int i = 0; i < m; ++i) {
+        const sf::Vector2f d = at(i - 2) - at(i - 1) * 4.f + p[i] * 6.f - at(i + 1) * 4.f + at(i + 2);
+        next[i] = std::clamp(offset[i] - kRelaxRate * dot(d, normal[i]), lo[i], hi[i]);
+      }
+      offset.swap(next);
+    }
+  }
+
+  /** Curvatura de Menger del punto @p b entre @p a y @p c (1/px, con signo). */
+  float curvature(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c) {
+    const sf::Vector2f ab = b - a;
+    const sf::Vector2f bc = c - b;
+    const float denom = length(ab) * length(bc) * length(c - a);
+    return (denom > 1e-6f) ? 2.f * (ab.x * bc.y - ab.y * bc.x) / denom : 0.f;
+  }
+
+  /**
+   * Perfil de velocidad de un circuito cerrado de puntos: límite lateral y pasadas de
+   * aceleración/frenada (dos vueltas cada una para que el cierre también cuadre).
+   * @return Tiempo de vuelta estimado (s).
+   */
+  float speedProfile(const std::vector<sf::Vector2f>& points, const RacingLineOptimizer::Config& config,
+                     std::vector<float>& speed, float* minRadius) {
+    const int m = static_cast<int>(points.size());
+    speed.assign(m, config.referenceSpeed);
+    std::vector<float> ds(m);
+    float tightest = 1e9f;
+    for (int i = 0; i < m; ++i) {
+      const sf::Vector2f& prev = points[(i + m - 1) % m];
+      const sf::Vector2f& next = points[(i + 1) % m];
+      const float k = std::abs(curvature(prev, points[i], next));
+      if (k > 1e-6f) {
+        speed[i] = std::min(speed[i], std::sqrt(config.lateralAccel / k));
+        tightest = std::min(tightest, 1.f / k);
+      }
+      ds[i] = length(next - points[i]);
+    }
+    for (int pass = 0; pass < 2 * m; ++pass) {
+      const int i = pass % m;
+      const int j = (i + 1) % m;
+      speed[j] = std::min(speed[j], std::sqrt(speed[i] * speed[i] + 2.f * config.accel * ds[i]));
+    }
+    for (int pass = 2 * m; pass > 0; --pass) {
+      const int i = pass % m;
+      const int j = (i + 1) % m;
+      speed[i] = std::min(speed[i], std::sqrt(speed[j] * speed[j] + 2.f * config.brake * ds[i]));
+    }
+    if (minRadius) {
+      *minRadius = tightest;
+    }
+    float time = 0.f;
+    for (int i = 0; i < m; ++i) {
+      time += ds[i] / std::max(0.5f * (speed[i] + speed[(i + 1) % m]), 1.f);
+    }
+    return time;
+  }
+}
+
+bool RacingLineOptimizer::parseArgs(int argc, char* argv[], Config& out) {
+  bool requested = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (std::strcmp(arg, "--optimize-line") == 0) {
+      requested = true;
+    }
+    else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+      out.outPath = argv[++i];
+    }
+    else if (std::strcmp(arg, "--generated") == 0) {
+      out.generatedSurface = true;
+    }
+    else if (std::strcmp(arg, "--margin") == 0 && hasValue) {
+      out.margin = std::max(0.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--lateral-accel") == 0 && hasValue) {
+      out.lateralAccel = std::max(1.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--accel") == 0 && hasValue) {
+      out.accel = std::max(1.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--brake") == 0 && hasValue) {
+      out.brake = std::max(1.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--reference-speed") == 0 && hasValue) {
+      out.referenceSpeed = std::max(1.f, static_cast<float>(std::atof(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--iterations") == 0 && hasValue) {
+      out.iterations = std::max(0, std::atoi(argv[++i]));
+    }
+  }
+  return requested;
+}
+
+RacingLine RacingLineOptimizer::optimize(const RacingSpline& spline, const TrackSurface& surface,
+                                         const Config& config, Report* report) {
+  const auto& samples = spline.getSamples();
+  const int n = static_cast<int>(samples.size());
+  std::vector<sf::Vector2f> center(n), normal(n);
+  std::vector<float> lo(n), hi(n);
+  float minWidth = 1e9f;
+  for (int i = 0; i < n; ++i) {
+    center[i] = samples[i].position;
+    normal[i] = { -samples[i].tangent.y, samples[i].tangent.x };
+    auto reach = [&](float side) {
+      float d = 0.f;
+      while (d + kWidthStep <= kMaxWidth
+             && surface.getDistance(center[i] + normal[i] * (side * (d + kWidthStep))) <= -config.margin) {
+        d += kWidthStep;
+      }
+      return d;
+    };
+    const bool onRoad = surface.getDistance(center[i]) <= -config.margin;
+    lo[i] = onRoad ? -reach(-1.f) : 0.f;
+    hi[i] = onRoad ? reach(1.f) : 0.f;
+    minWidth = std::min(minWidth, hi[i] - lo[i]);
+  }
+
+  // Rejilla gruesa: los modos largos de la trazada convergen mucho antes.
+  const int m = std::max(1, n / kCoarseStride);
+  std::vector<sf::Vector2f> coarseCenter(m), coarseNormal(m);
+  std::vector<float> coarseLo(m), coarseHi(m), coarseOffset(m, 0.f);
+  for (int k = 0; k < m; ++k) {
+    const int i = k * n / m;
+    coarseCenter[k] = center[i];
+    coarseNormal[k] = normal[i];
+    coarseLo[k] = lo[i];
+    coarseHi[k] = hi[i];
+  }
+  relax(coarseCenter, coarseNormal, coarseLo, coarseHi, coarseOffset, config.iterations);
+
+  std::vector<float> offset(n);
+  for (int i = 0; i < n; ++i) {
+    const float f = static_cast<float>(i) * m / n;
+    const int k = static_cast<int>(f);
+    const float u = f - static_cast<float>(k);
+    offset[i] = std::clamp(coarseOffset[k % m] + (coarseOffset[(k + 1) % m] - coarseOffset[k % m]) * u, lo[i], hi[i]);
+  }
+  relax(center, normal, lo, hi, offset, config.iterations / 10);
+
+  std::vector<sf::Vector2f> line(n);
+  for (int i = 0; i < n; ++i) {
+    line[i] = center[i] + normal[i] * offset[i];
+  }
+  std::vector<float> speed;
+  Report r;
+  r.lapTime = speedProfile(line, config, speed, &r.minRadius);
+  std::vector<float> scale(n);
+  for (int i = 0; i < n; ++i) {
+    scale[i] = speed[i] / config.referenceSpeed;
+    r.minSpeedScale = std::min(r.minSpeedScale, scale[i]);
+    r.lineLength += length(line[(i + 1) % n] - line[i]);
+  }
+  std::vector<float> centerSpeed;
+  r.centerLapTime = speedProfile(center, config, centerSpeed, &r.centerMinRadius);
+  r.centerLength = spline.getLength();
+  r.minWidth = minWidth;
+  if (report) {
+    *report = r;
+  }
+
+  RacingLine result;
+  result.assign(spline, offset, scale);
+  return result;
+}
+
+int RacingLineOptimizer::run(const Config& config) {
+  RaceSimulation sim;
+  sim.setupDefaultRace();
+  if (!config.generatedSurface && !sim.loadDefaultTrackSurface()) {
+    std::cerr << "RacingLineOptimizer::run : la imagen de la pista no cubre la línea de carrera; se usa la calzada generada\n";
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  Report report;
+  const RacingLine line = optimize(*sim.getSpline(), *sim.getSurface(), config, &report);
+  const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  std::printf("=== Trazada optimizada (%zu muestras, %.0f ms) ===\n", line.size(), ms);
+  std::printf("Longitud:         %.0f px (centro %.0f px)\n", report.lineLength, report.centerLength);
+  std::printf("Radio mínimo:     %.0f px (centro %.0f px)\n", report.minRadius, report.centerMinRadius);
+  std::printf("Ancho útil mín.:  %.0f px (holgura %.0f px)\n", report.minWidth, config.margin);
+  std::printf("Velocidad mín.:   %.0f %% de la máxima\n", report.minSpeedScale * 100.f);
+  std::printf("Vuelta estimada:  %.2f s (centro %.2f s, a %.0f px/s)\n",
+    report.lapTime, report.centerLapTime, config.referenceSpeed);
+  if (!line.save(config.outPath)) {
+    std::cerr << "RacingLineOptimizer::run : no se pudo escribir " << config.outPath << "\n";
+    return 1;
+  }
+  std::printf("Asset:            %s\n", config.outPath.c_str());
+  return 0;
+}
@@ -0,0 +1,208 @@
+#include "RacingSpline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+  float length(const sf::Vector2f& v) {
+    return std::sqrt(v.x * v.x + v.y * v.y);
+  }
+
+  sf::Vector2f normalizeOr(const sf::Vector2f& v, const sf::Vector2f& fallback) {
+    float len = length(v);
+    return (len > 1e-6f) ? v / len : fallback;
+  }
+
+  /**
+   * Catmull-Rom centrípeta (alpha = 0.5, formulación de Barry-Goldman) en u en [0,1]
+   * entre p1 y p2. No forma bucles ni picos en curvas cerradas.
+   */
+  sf::Vector2f catmullRom(const sf::Vector2f& p0, const sf::Vector2f& p1,
+    const sf::Vector2f& p2, const sf::Vector2f& p3, float u) {
+    auto knot = [](float t, const sf::Vector2f& a, const sf::Vector2f& b) {
+      return t + std::max(std::sqrt(length(b - a)), 1e-4f);
+    };
+    const float t0 = 0.f;
+    const float t1 = knot(t0, p0, p1);
+    const float t2 = knot(t1, p1, p2);
+    const float t3 = knot(t2, p2, p3);
+    const float t = t1 + (t2 - t1) * u;
+
+    sf::Vector2f a1 = p0 * ((t1 - t) / (t1 - t0)) + p1 * ((t - t0) / (t1 - t0));
+    sf::Vector2f a2 = p1 * ((t2 - t) / (t2 - t1)) + p2 * ((t - t1) / (t2 - t1));
+    sf::Vector2f a3 = p2 * ((t3 - t) / (t3 - t2)) + p3 * ((t - t2) / (t3 - t2));
+    sf::Vector2f b1 = a1 * ((t2 - t) / (t2 - t0)) + a2 * ((t - t0) / (t2 - t0));
+    sf::Vector2f b2 = a2 * ((t3 - t) / (t3 - t1)) + a3 * ((t - t1) / (t3 - t1));
+    return b1 * ((t2 - t) / (t2 - t1)) + b2 * ((t - t1) / (t2 - t1));
+  }
+
+} // namespace
+
+bool RacingSpline::build(const std::vector<sf::Vector2f>& controlPoints, bool closed, float step) {
+  m_samples.clear();
+  m_length = 0.f;
+  m_closed = closed;
+
+  std::vector<sf::Vector2f> pts = controlPoints;
+  // Un circuito cerrado que repite el primer punto al final no necesita el duplicado.
+  if (closed && pts.size() > 2 && length(pts.front() - pts.back()) < 1e-3f) {
+    pts.pop_back();
+  }
+  const int n = static_cast<int>(pts.size());
+  if (n < 2 || step <= 0.f) {
+    return false;
+  }
+
+  auto control = [&](int i) -> sf::Vector2f {
+    if (closed) {
+      return pts[((i % n) + n) % n];
+    }
+    // Extremos abiertos: punto fantasma reflejado para mantener la tangente.
+    if (i < 0)  return pts[0] * 2.f - pts[1];
+    if (i >= n) return pts[n - 1] * 2.f - pts[n - 2];
+    return pts[i];
+  };
+
+  // --- 1) Polilínea densa de la curva con longitud de arco acumulada ---
+  std::vector<sf::Vector2f> dense;
+  std::vector<float>        arc;
+  const int segments = closed ? n : n - 1;
+  dense.push_back(control(0));
+  arc.push_back(0.f);
+  for (int i = 0; i < segments; ++i) {
+    const sf::Vector2f p0 = control(i - 1);
+    const sf::Vector2f p1 = control(i);
+    const sf::Vector2f p2 = control(i + 1);
+    const sf::Vector2f p3 = control(i + 2);
+    const int subdiv = std::max(4, static_cast<int>(std::ceil(length(p2 - p1) * 4.f / step)));
+    for (int k = 1; k <= subdiv; ++k) {
+      sf::Vector2f p = catmullRom(p0, p1, p2, p3, static_cast<float>(k) / subdiv);
+      arc.push_back(arc.back() + length(p - dense.back()));
+      dense.push_back(p);
+    }
+  }
+  m_length = arc.back();
+  if (m_length <= 1e-3f) {
+    m_length = 0.f;
+    return false;
+  }
+
+  // --- 2) Remuestreo a paso de arco constante ---
+  // En circuito cerrado la última muestra no se repite: el paso se ajusta para que
+  // count * step == longitud y la interpolación envuelva sin costura.
+  const int count = closed
+    ? std::max(3, static_cast<int>(std::lround(m_length / step)))
+    : std::max(2, static_cast<int>(std::lround(m_length / step)) + 1);
+  m_step = closed ? m_length / count : m_length / (count - 1);
+  m_invStep = 1.f / m_step;
+
+  m_samples.resize(count);
+  std::size_t j = 1;
+  for (int i = 0; i < count; ++i) {
+    const float s = std::min(i * m_step, m_length);
+    while (j + 1 < arc.size() && arc[j] < s) {
+      ++j;
+    }
+    const float segLen = arc[j] - arc[j - 1];
+    const float u = (segLen > 1e-6f) ? (s - arc[j - 1]) / segLen : 0.f;
+    m_samples[i].position = dense[j - 1] + (dense[j] - dense[j - 1]) * u;
+  }
+
+  // --- 3) Tangentes (diferencia central) y curvatura con signo ---
+  for (int i = 0; i < count; ++i) {
+    const sf::Vector2f prev = at(i - 1).position;
+    const sf::Vector2f next = at(i + 1).position;
+    m_samples[i].tangent = normalizeOr(next - prev, { 1.f, 0.f });
+  }
+  for (int i = 0; i < count; ++i) {
+    const sf::Vector2f& ta = at(i - 1).tangent;
+    const sf::Vector2f& tb = at(i + 1).tangent;
+    const int span = (!closed && (i == 0 || i == count - 1)) ? 1 : 2;
+    const float cross = ta.x * tb.y - ta.y * tb.x;
+    const float dot = ta.x * tb.x + ta.y * tb.y;
+    m_samples[i].curvature = std::atan2(cross, dot) / (span * m_step);
+  }
+  return true;
+}
+
+const RacingSpline::Sample& RacingSpline::at(int i) const {
+  const int n = static_cast<int>(m_samples.size());
+  if (m_closed) {
+    return m_samples[((i % n) + n) % n];
+  }
+  return m_samples[std::clamp(i, 0, n - 1)];
+}
+
+float RacingSpline::wrap(float s) const {
+  if (m_length <= 0.f) {
+    return 0.f;
+  }
+  if (!m_closed) {
+    return std::clamp(s, 0.f, m_length);
+  }
+  s = std::fmod(s, m_length);
+  return (s < 0.f) ? s + m_length : s;
+}
+
+RacingSpline::Sample RacingSpline::sample(float s) const {
+  if (m_samples.empty()) {
+    return Sample{};
+  }
+  const float f = wrap(s) * m_invStep;
+  const int   i = static_cast<int>(f);
+  const float u = f - static_cast<float>(i);
+  const Sample& a = at(i);
+  const Sample& b = at(i + 1);
+
+  Sample out;
+  out.position = a.position + (b.position - a.position) * u;
+  out.tangent = normalizeOr(a.tangent + (b.tangent - a.tangent) * u, a.tangent);
+  out.curvature = a.curvature + (b.curvature - a.curvature) * u;
+  return out;
+}
+
+float RacingSpline::project(const sf::Vector2f& point, float hint, float window) const {
+  const int n = static_cast<int>(m_samples.size());
+  if (n == 0) {
+    return 0.f;
+  }
+  const int center = static_cast<int>(std::lround(wrap(hint) * m_invStep));
+  const int reach = std::min(static_cast<int>(std::ceil(window * m_invStep)) + 1, n / 2 + 1);
+
+  int   best = center;
+  float bestD2 = std::numeric_limits<float>::max();
+  for (int i = center - reach; i <= center + reach; ++i) {
+    if (!m_closed && (i < 0 || i >= n)) {
+      continue;
+    }
+    const sf::Vector2f d = point - at(i).position;
+    const float d2 = d.x * d.x + d.y * d.y;
+    if (d2 < bestD2) {
+      bestD2 = d2;
+      best = i;
+    }
+  }
+
+  // Refinamiento sobre el segmento [best, best+1] o [best-1, best].
+  auto projectOn = [&](int i0, float& outS, float& outD2) {
+    const sf::Vector2f a = at(i0).position;
+    const sf::Vector2f ab = at(i0 + 1).position - a;
+    const float len2 = ab.x * ab.x + ab.y * ab.y;
+    float u = (len2 > 1e-9f) ? ((point - a).x * ab.x + (point - a).y * ab.y) / len2 : 0.f;
+    u = std::clamp(u, 0.f, 1.f);
+    const sf::Vector2f d = point - (a + ab * u);
+    outD2 = d.x * d.x + d.y * d.y;
+    outS = (static_cast<float>(i0) + u) * m_step;
+  };
+  float sA = best * m_step, dA = bestD2;
+  float sB = sA, dB = bestD2;
+  if (m_closed || best + 1 < n) projectOn(best, sA, dA);
+  if (m_closed || best - 1 >= 0) projectOn(best - 1, sB, dB);
+  return wrap(dA <= dB ? sA : sB);
+}
+
+float RacingSpline::project(const sf::Vector2f& point) const {
+  return project(point, 0.f, m_length);
+}
@@ -1,47 +1,41 @@
-﻿// =================== ChrisEngine ResourceManager ===================
-#include <iostream>
-#include <filesystem>
-#include "EngineUtilities.h"
-#include "Texture.h"
-
-class ChrisEngineResourceManager {
-private:
-    std::map<std::string, EngineUtilities::TSharedPointer<Texture>> m_textures;
-
-public:
-    // Carga una textura y la guarda en el mapa
-    bool loadTexture(const std::string& fileName, const std::string& extension) {
-        // Si ya existe y no es nula, no recargar
-        auto it = m_textures.find(fileName);
-        if (it != m_textures.end() && !it->second.isNull())
-            return true;
-
-        // Construir ruta absoluta del archivo
-        std::string fullName = fileName + "." + extension;
-        std::filesystem::path fullPath = std::filesystem::absolute(fullName);
-
-        // Crear puntero compartido a la textura
-        auto texturePtr = EngineUtilities::MakeShared<Texture>(fileName, extension);
+#include "ResourceManager.h"
 
-        // Guardar aunque falle para evitar reintentos infinitos
-        m_textures[fileName] = texturePtr;
-
-        // Retorna true si la textura cargó correctamente
-        return !texturePtr.isNull();
-    }
-
-    // Obtener puntero a textura cargada
-    EngineUtilities::TSharedPointer<Texture> getTexture(const std::string& fileName) {
-        auto it = m_textures.find(fileName);
-        if (it != m_textures.end())
-            return it->second;
-
-        // No encontrada: puntero nulo
-        return EngineUtilities::TSharedPointer<Texture>();
-    }
+#include <iostream>
 
-    // Carga todos los sprites de la carrera
-    void loadAllResources() {
-        loadTexture("princesa", "png");
-        loadTexture("sonic", "png");
-        l
+bool ResourceManager::loadAtlas(const std::vector<std::string>& names, const std::string& cacheBase,
+                                const std::string& extension) {
+  if (!m_atlas.loadOrBuild(names, cacheBase, extension)) {
+    std::cerr << "ResourceManager::loadAtlas : sin atlas; las texturas se cargarán sueltas\n";
+    return false;
+  }
+  return true;
+}
+
+bool ResourceManager::loadTexture(const std::string& fileName, const std::string& extension) {
+  // Si ya existe y no es nula, no recargar
+  auto it = m_textures.find(fileName);
+  if (it != m_textures.end() && !it->second.isNull()) {
+    return it->second->getSprite() != nullptr;
+  }
+
+  EngineUtilities::TSharedPointer<Texture> texture;
+  const TextureAtlas::Region region = m_atlas.find(fileName);
+  if (region.texture) {
+    texture = EngineUtilities::MakeShared<Texture>(fileName, *region.texture, region.rect);
+  }
+  else {
+    texture = EngineUtilities::MakeShared<Texture>(fileName, extension);
+  }
+
+  // Se guarda aunque falle para no reintentar cada vez
+  m_textures[fileName] = texture;
+  return texture->getSprite() != nullptr;
+}
+
+EngineUtilities::TSharedPointer<Texture> ResourceManager::getTexture(const std::string& fileName) {
+  auto it = m_textures.find(fileName);
+  if (it != m_textures.end()) {
+    return it->second;
+  }
+  return EngineUtilities::TSharedPointer<Texture>();
+}
@@ -0,0 +1,252 @@
+#include "RollbackSession.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  double secondsSince(const Clock::time_point& start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  bool sameInput(const RaceSimulation::PlayerInput& a, const RaceSimulation::PlayerInput& b) {
+    return a.throttle == b.throttle && a.steer == b.steer && a.drift == b.drift && a.useItem == b.useItem;
+  }
+}
+
+void RollbackSession::start(RaceSimulation& sim, NetTransport& transport, int localRacer,
+                            const std::vector<Remote>& remotes, const Config& config) {
+  m_sim = &sim;
+  m_transport = &transport;
+  m_config = config;
+  m_config.inputDelay = std::max(0, m_config.inputDelay);
+  m_config.maxRollback = std::max(1, m_config.maxRollback);
+  m_tick = 0;
+  m_rollbackTo = UINT32_MAX;
+  m_stats = Stats{};
+
+  m_players.clear();
+  Player local;
+  local.racer = localRacer;
+  m_players.push_back(local);
+  for (const Remote& remote : remotes) {
+    Player player;
+    player.peer = remote.peer;
+    player.racer = remote.racer;
+    m_players.push_back(player);
+  }
+
+  // Los primeros inputDelay ticks no tienen mando de nadie: neutros y ya confirmados.
+  const std::uint32_t delay = static_cast<std::uint32_t>(m_config.inputDelay);
+  sim.setPlayer(-1);
+  for (Player& player : m_players) {
+    sim.setRemoteControl(player.racer, true);
+    for (std::uint32_t t = 0; t < delay; ++t) {
+      InputSlot& slot = player.inputs[t % kInputWindow];
+      slot.tick = t;
+      slot.confirmed = true;
+      slot.input = RaceSimulation::PlayerInput{};
+    }
+    player.received = delay;
+    player.acked = delay;
+  }
+
+  // Lo único que crece durante la carrera es el orden de llegada (un id por kart) y,
+  // con objetos, los proyectiles vivos (como mucho el pool entero).
+  m_states.assign(static_cast<std::size_t>(m_config.maxRollback) + 2, SavedState{});
+  sim.saveState(m_states[0].bytes);
+  m_stateSize = m_states[0].bytes.size();
+  const std::size_t capacity = m_stateSize + sim.getRacers().size() * sizeof(std::uint32_t)
+    + sim.getItems().getCapacity() * ItemSystem::kProjectileStateSize;
+  for (SavedState& saved : m_states) {
+    saved.bytes.reserve(capacity);
+  }
+}
+
+std::uint32_t RollbackSession::getConfirmedTick() const {
+  std::uint32_t confirmed = m_players.empty() ? m_tick : m_players[0].received;
+  for (std::size_t i = 1; i < m_players.size(); ++i) {
+    confirmed = std::min(confirmed, m_players[i].received);
+  }
+  return confirmed;
+}
+
+bool RollbackSession::advance(const RaceSimulation::PlayerInput& localInput) {
+  if (!m_sim) {
+    return false;
+  }
+  receive();
+  rollback();
+
+  // Sin margen de predicción, o con mandos propios que el otro aún no tiene a punto de
+  // salir del anillo: se espera en vez de simular.
+  const std::uint32_t scheduled = m_tick + static_cast<std::uint32_t>(m_config.inputDelay);
+  bool wait = m_tick >= getConfirmedTick() + static_cast<std::uint32_t>(m_config.maxRollback);
+  for (std::size_t i = 1; i < m_players.size(); ++i) {
+    wait = wait || scheduled - m_players[i].acked >= kInputWindow;
+  }
+  if (wait) {
+    ++m_stats.stalls;
+    sendInputs();
+    return false;
+  }
+
+  Player& local = m_players[0];
+  InputSlot& slot = local.inputs[scheduled % kInputWindow];
+  slot.tick = scheduled;
+  slot.confirmed = true;
+  slot.input = quantizeInput(localInput);
+  local.received = scheduled + 1;
+
+  simulateTick();
+  ++m_stats.ticks;
+  sendInputs();
+  return true;
+}
+
+void RollbackSession::poll() {
+  if (!m_sim) {
+    return;
+  }
+  receive();
+  rollback();
+  sendInputs();
+}
+
+void RollbackSession::receive() {
+  int peer = -1;
+  while (m_transport->receive(peer, m_packet)) {
+    auto it = std::find_if(m_players.begin() + 1, m_players.end(),
+      [peer](const Player& player) { return player.peer == peer; });
+    if (it == m_players.end() || m_packet.empty()) {
+      continue;
+    }
+    m_stats.bytesIn += m_packet.size();
+    NetReader in(m_packet);
+    if (static_cast<NetMessage>(in.getByte()) != NetMessage::RollbackInput) {
+      continue;
+    }
+    const std::uint32_t ack = in.getVarint();
+    const std::uint32_t first = in.getVarint();
+    const std::uint32_t count = in.getVarint();
+    if (!in.ok() || count > kMaxInputsPerPacket) {
+      continue;
+    }
+    it->acked = std::max(it->acked, std::min(ack, m_players[0].received));
+    for (std::uint32_t i = 0; i < count; ++i) {
+      const RaceSimulation::PlayerInput input = in.getInput();
+      if (!in.ok()) {
+        break;
+      }
+      confirmInput(*it, first + i, input);
+    }
+  }
+}
+
+void RollbackSession::confirmInput(Player& player, std::uint32_t tick, const RaceSimulation::PlayerInput& input) {
+  if (tick < player.received || tick >= player.received + kInputWindow) {
+    return; // repetido o demasiado adelantado (se reenviará)
+  }
+  InputSlot& slot = player.inputs[tick % kInputWindow];
+  if (slot.tick == tick && slot.confirmed) {
+    return;
+  }
+  if (slot.tick == tick && tick < m_tick && !sameInput(slot.input, input)) {
+    ++m_stats.mispredictions;
+    m_rollbackTo = std::min(m_rollbackTo, tick);
+  }
+  slot.tick = tick;
+  slot.confirmed = true;
+  slot.input = input;
+
+  for (;;) {
+    const InputSlot& next = player.inputs[player.received % kInputWindow];
+    if (next.tick != player.received || !next.confirmed) {
+      break;
+    }
+    ++player.received;
+  }
+}
+
+void RollbackSession::rollback() {
+  if (m_rollbackTo >= m_tick) {
+    m_rollbackTo = UINT32_MAX;
+    return;
+  }
+  const SavedState& saved = m_states[m_rollbackTo % m_states.size()];
+  if (saved.tick != m_rollbackTo) {
+    std::cerr << "RollbackSession::rollback : no hay estado guardado del tick " << m_rollbackTo << "\n";
+    m_rollbackTo = UINT32_MAX;
+    return;
+  }
+
+  Clock::time_point start = Clock::now();
+  m_sim->loadState(saved.bytes);
+  m_stats.loadSeconds += secondsSince(start);
+  ++m_stats.loads;
+
+  const std::uint32_t target = m_tick;
+  m_stats.maxDepth = std::max(m_stats.maxDepth, target - m_rollbackTo);
+  m_stats.resimulated += target - m_rollbackTo;
+  ++m_stats.rollbacks;
+  m_tick = m_rollbackTo;
+  m_rollbackTo = UINT32_MAX;
+
+  start = Clock::now();
+  while (m_tick < target) {
+    simulateTick();
+  }
+  m_stats.resimSeconds += secondsSince(start);
+}
+
+void RollbackSession::simulateTick() {
+  // Sólo se puede volver a un tick con algún mando sin confirmar: los demás no se guardan.
+  if (m_tick >= getConfirmedTick()) {
+    SavedState& saved = m_states[m_tick % m_states.size()];
+    const Clock::time_point start = Clock::now();
+    m_sim->saveState(saved.bytes);
+    m_stats.saveSeconds += secondsSince(start);
+    ++m_stats.saves;
+    saved.tick = m_tick;
+  }
+  for (Player& player : m_players) {
+    m_sim->setRacerInput(player.racer, inputFor(player, m_tick));
+  }
+  m_sim->step(1.f / m_config.hz);
+  ++m_tick;
+}
+
+const RaceSimulation::PlayerInput& RollbackSession::inputFor(Player& player, std::uint32_t tick) {
+  InputSlot& slot = player.inputs[tick % kInputWindow];
+  if (slot.tick == tick && slot.confirmed) {
+    return slot.input;
+  }
+  // Predicción: el jugador sigue con el último mando confirmado.
+  const InputSlot& last = player.inputs[(player.received + kInputWindow - 1) % kInputWindow];
+  slot.tick = tick;
+  slot.confirmed = false;
+  slot.input = (player.received > 0 && last.tick == player.received - 1) ? last.input : RaceSimulation::PlayerInput{};
+  return slot.input;
+}
+
+void RollbackSession::sendInputs() {
+  const Player& local = m_players[0];
+  for (std::size_t i = 1; i < m_players.size(); ++i) {
+    const Player& remote = m_players[i];
+    const std::uint32_t first = remote.acked;
+    const std::uint32_t count = std::min(local.received - first, kMaxInputsPerPacket);
+    m_packet.clear();
+    NetWriter out(m_packet);
+    out.putByte(static_cast<std::uint8_t>(NetMessage::RollbackInput));
+    out.putVarint(remote.received);
+    out.putVarint(first);
+    out.putVarint(count);
+    for (std::uint32_t k = 0; k < count; ++k) {
+      out.putInput(local.inputs[(first + k) % kInputWindow].input);
+    }
+    m_transport->send(remote.peer, m_packet);
+    m_stats.bytesOut += m_packet.size();
+    ++m_stats.packetsOut;
+  }
+}
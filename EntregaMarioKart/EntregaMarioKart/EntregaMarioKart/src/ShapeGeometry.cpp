@@ -0,0 +1,158 @@
+#include "ShapeGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+namespace {
+  constexpr float kPi = 3.14159265f;
+
+  struct KeyHash {
+    std::size_t operator()(const ShapeGeometry::Key& key) const {
+      std::size_t h = std::hash<int>()(static_cast<int>(key.type));
+      h = h * 31 + std::hash<float>()(key.width);
+      h = h * 31 + std::hash<float>()(key.height);
+      h = h * 31 + std::hash<std::uint32_t>()(key.points);
+      h = h * 31 + std::hash<float>()(key.outline);
+      return h;
+    }
+  };
+
+  using Cache = std::unordered_map<ShapeGeometry::Key, EngineUtilities::TSharedPointer<ShapeGeometry>, KeyHash>;
+
+  Cache& cache() {
+    thread_local Cache geometries;
+    return geometries;
+  }
+
+  /**
+   * Contorno de un polígono regular inscrito en la caja (0,0)-(2r,2r), empezando arriba
+   * (mismo reparto que sf::CircleShape).
+   */
+  std::vector<sf::Vector2f> regularOutline(float radius, std::uint32_t points) {
+    std::vector<sf::Vector2f> outline(points);
+    for (std::uint32_t i = 0; i < points; ++i) {
+      const float angle = static_cast<float>(i) * 2.f * kPi / static_cast<float>(points) - 0.5f * kPi;
+      outline[i] = { radius + radius * std::cos(angle), radius + radius * std::sin(angle) };
+    }
+    return outline;
+  }
+
+  /**
+   * Normal unitaria del lado @p a -> @p b.
+   */
+  sf::Vector2f edgeNormal(const sf::Vector2f& a, const sf::Vector2f& b) {
+    const sf::Vector2f n(a.y - b.y, b.x - a.x);
+    const float length = std::sqrt(n.x * n.x + n.y * n.y);
+    return length > 0.f ? n / length : n;
+  }
+
+  /**
+   * Contorno desplazado @p thickness hacia fuera con ingletes en las esquinas (como el borde
+   * de sf::Shape). @p center decide qué lado es "fuera".
+   */
+  std::vector<sf::Vector2f> offsetOutline(const std::vector<sf::Vector2f>& outline, const sf::Vector2f& center,
+                                          float thickness) {
+    const std::size_t count = outline.size();
+    std::vector<sf::Vector2f> offset(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      const sf::Vector2f& p0 = outline[(i + count - 1) % count];
+      const sf::Vector2f& p1 = outline[i];
+      const sf::Vector2f& p2 = outline[(i + 1) % count];
+      sf::Vector2f n1 = edgeNormal(p0, p1);
+      sf::Vector2f n2 = edgeNormal(p1, p2);
+      if (n1.dot(p1 - center) < 0.f) {
+        n1 = -n1;
+      }
+      if (n2.dot(p1 - center) < 0.f) {
+        n2 = -n2;
+      }
+      const float factor = 1.f + n1.dot(n2);
+      offset[i] = p1 + (n1 + n2) * (thickness / std::max(factor, 1e-3f));
+    }
+    return offset;
+  }
+}
+
+ShapeGeometry::Key ShapeGeometry::defaultKey(ShapeType type) {
+  switch (type) {
+  case ShapeType::CIRCLE:    return Key{ type, 10.f, 10.f, 30 };
+  case ShapeType::RECTANGLE: return Key{ type, 100.f, 50.f, 4 };
+  case ShapeType::TRIANGLE:  return Key{ type, 100.f, 100.f, 3 };
+  case ShapeType::POLYGON:   return Key{ type, 50.f, 50.f, 5 };
+  default:                   return Key{};
+  }
+}
+
+EngineUtilities::TSharedPointer<ShapeGeometry> ShapeGeometry::get(const Key& key) {
+  Cache& geometries = cache();
+  auto it = geometries.find(key);
+  if (it != geometries.end()) {
+    return it->second;
+  }
+  auto geometry = EngineUtilities::MakeShared<ShapeGeometry>(key);
+  geometries.emplace(key, geometry);
+  return geometry;
+}
+
+std::size_t ShapeGeometry::getCacheSize() {
+  return cache().size();
+}
+
+ShapeGeometry::ShapeGeometry(const Key& key)
+  : m_key(key)
+{
+  std::vector<sf::Vector2f> outline;
+  switch (key.type) {
+  case ShapeType::CIRCLE:
+  case ShapeType::POLYGON:
+    outline = regularOutline(key.width, std::max(key.points, 3u));
+    break;
+  case ShapeType::RECTANGLE:
+    outline = { { 0.f, 0.f }, { key.width, 0.f }, { key.width, key.height }, { 0.f, key.height } };
+    break;
+  case ShapeType::TRIANGLE:
+    outline = { { 0.f, 0.f }, { 0.5f * key.width, key.height }, { key.width, 0.f } };
+    break;
+  default:
+    break;
+  }
+  if (outline.size() < 3) {
+    return;
+  }
+
+  // Formas convexas: abanico desde el primer punto.
+  const std::size_t count = outline.size();
+  m_triangles.reserve((count - 2) * 3 + (key.outline > 0.f ? count * 6 : 0));
+  for (std::size_t i = 1; i + 1 < count; ++i) {
+    m_triangles.push_back(outline[0]);
+    m_triangles.push_back(outline[i]);
+    m_triangles.push_back(outline[i + 1]);
+  }
+  m_fillCount = m_triangles.size();
+
+  sf::Vector2f low = outline[0];
+  sf::Vector2f high = outline[0];
+  for (const sf::Vector2f& p : outline) {
+    low = { std::min(low.x, p.x), std::min(low.y, p.y) };
+    high = { std::max(high.x, p.x), std::max(high.y, p.y) };
+  }
+  m_bounds = sf::FloatRect(low, high - low);
+
+  // Borde: un anillo de dos triángulos por lado entre el contorno y su desplazado.
+  if (key.outline > 0.f) {
+    const std::vector<sf::Vector2f> outer = offsetOutline(outline, m_bounds.getCenter(), key.outline);
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::size_t j = (i + 1) % count;
+      m_triangles.insert(m_triangles.end(), { outline[i], outer[i], outline[j], outer[i], outer[j], outline[j] });
+    }
+  }
+
+  // La textura cubre la caja del relleno, como en sf::Shape.
+  m_texCoords.reserve(m_triangles.size());
+  for (const sf::Vector2f& p : m_triangles) {
+    m_texCoords.push_back({ m_bounds.size.x > 0.f ? (p.x - low.x) / m_bounds.size.x : 0.f,
+                            m_bounds.size.y > 0.f ? (p.y - low.y) / m_bounds.size.y : 0.f });
+  }
+}
@@ -0,0 +1,186 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize) {
+  setCellSize(cellSize);
+}
+
+void SpatialGrid::setCellSize(float cellSize) {
+  m_cellSize = std::max(1.f, cellSize);
+  m_invCellSize = 1.f / m_cellSize;
+  m_cells.clear();
+  for (auto& e : m_entries) {
+    e.active = false;
+  }
+  m_count = 0;
+  m_maxRadius = 0.f;
+}
+
+void SpatialGrid::clear() {
+  for (auto& cell : m_cells) {
+    cell.second.clear();
+  }
+  for (auto& e : m_entries) {
+    e.active = false;
+  }
+  m_count = 0;
+  m_maxRadius = 0.f;
+}
+
+std::int32_t SpatialGrid::cellCoord(float v) const {
+  return static_cast<std::int32_t>(std::floor(v * m_invCellSize));
+}
+
+void SpatialGrid::update(std::uint32_t id, const sf::Vector2f& position, float radius) {
+  if (id >= m_entries.size()) {
+    m_entries.resize(static_cast<std::size_t>(id) + 1);
+  }
+  Entry& e = m_entries[id];
+  e.position = position;
+  e.radius = radius;
+  m_maxRadius = std::max(m_maxRadius, radius);
+
+  const std::uint64_t key = makeKey(cellCoord(position.x), cellCoord(position.y));
+  if (e.active) {
+    if (e.cell == key) {
+      return; // Caso habitual: sigue en la misma celda.
+    }
+    unlink(e);
+  }
+  else {
+    ++m_count;
+  }
+
+  auto& cell = m_cells[key];
+  e.cell = key;
+  e.slot = static_cast<std::uint32_t>(cell.size());
+  e.active = true;
+  cell.push_back(id);
+}
+
+void SpatialGrid::remove(std::uint32_t id) {
+  if (!contains(id)) {
+    return;
+  }
+  unlink(m_entries[id]);
+  m_entries[id].active = false;
+  --m_count;
+}
+
+void SpatialGrid::saveState(StateWriter& out) const {
+  out.putVector(m_entries);
+  out.put(m_count);
+  out.put(m_maxRadius);
+}
+
+void SpatialGrid::loadState(StateReader& in) {
+  // Sólo hay ids en las celdas de las entradas activas: basta con vaciar ésas. Las celdas
+  // vacías que queden no cambian ningún resultado: las consultas nunca dependen de m_cells
+  // más allá del contenido de cada celda.
+  for (const Entry& e : m_entries) {
+    if (e.active) {
+      m_cells[e.cell].clear();
+    }
+  }
+  in.getVector(m_entries);
+  in.get(m_count);
+  in.get(m_maxRadius);
+  for (std::uint32_t id = 0; id < m_entries.size(); ++id) {
+    const Entry& e = m_entries[id];
+    if (!e.active) {
+      continue;
+    }
+    auto& ids = m_cells[e.cell];
+    if (ids.size() <= e.slot) {
+      ids.resize(static_cast<std::size_t>(e.slot) + 1);
+    }
+    ids[e.slot] = id;
+  }
+}
+
+bool SpatialGrid::contains(std::uint32_t id) const {
+  return id < m_entries.size() && m_entries[id].active;
+}
+
+void SpatialGrid::unlink(const Entry& e) {
+  auto it = m_cells.find(e.cell);
+  if (it == m_cells.end()) {
+    return;
+  }
+  auto& ids = it->second;
+  // swap-and-pop: el último de la celda ocupa el hueco y se le actualiza el slot.
+  const std::uint32_t last = ids.back();
+  ids[e.slot] = last;
+  m_entries[last].slot = e.slot;
+  ids.pop_back();
+}
+
+template<typename Fn>
+void SpatialGrid::forEachCandidate(const sf::Vector2f& min, const sf::Vector2f& max, Fn&& fn) const {
+  if (m_count == 0) {
+    return;
+  }
+  const std::int32_t x0 = cellCoord(min.x - m_maxRadius);
+  const std::int32_t y0 = cellCoord(min.y - m_maxRadius);
+  const std::int32_t x1 = cellCoord(max.x + m_maxRadius);
+  const std::int32_t y1 = cellCoord(max.y + m_maxRadius);
+
+  // Consultas enormes: más barato recorrer las entidades que las celdas. Se recorren por id
+  // y se decide con m_entries (que se guarda en el estado), no con m_cells: el mapa conserva
+  // celdas vacías y su orden de hash, que tras un rollback no coinciden entre máquinas.
+  const std::int64_t cellSpan = static_cast<std::int64_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+  if (cellSpan > static_cast<std::int64_t>(m_entries.size())) {
+    for (std::uint32_t id = 0; id < m_entries.size(); ++id) {
+      if (m_entries[id].active) {
+        fn(id, m_entries[id]);
+      }
+    }
+    return;
+  }
+
+  for (std::int32_t cy = y0; cy <= y1; ++cy) {
+    for (std::int32_t cx = x0; cx <= x1; ++cx) {
+      auto it = m_cells.find(makeKey(cx, cy));
+      if (it == m_cells.end()) {
+        continue;
+      }
+      for (std::uint32_t id : it->second) {
+        fn(id, m_entries[id]);
+      }
+    }
+  }
+}
+
+void SpatialGrid::queryRadius(const sf::Vector2f& center, float radius, std::vector<std::uint32_t>& out,
+                              std::uint32_t ignore) const {
+  out.clear();
+  const sf::Vector2f ext{ radius, radius };
+  forEachCandidate(center - ext, center + ext, [&](std::uint32_t id, const Entry& e) {
+    if (id == ignore) {
+      return;
+    }
+    const sf::Vector2f d = e.position - center;
+    const float r = radius + e.radius;
+    if (d.x * d.x + d.y * d.y <= r * r) {
+      out.push_back(id);
+    }
+  });
+}
+
+void SpatialGrid::queryAABB(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const {
+  out.clear();
+  const sf::Vector2f min = area.position;
+  const sf::Vector2f max = area.position + area.size;
+  forEachCandidate(min, max, [&](std::uint32_t id, const Entry& e) {
+    // Punto del rectángulo más cercano al centro del círculo.
+    const float nx = std::clamp(e.position.x, min.x, max.x);
+    const float ny = std::clamp(e.position.y, min.y, max.y);
+    const float dx = e.position.x - nx;
+    const float dy = e.position.y - ny;
+    if (dx * dx + dy * dy <= e.radius * e.radius) {
+      out.push_back(id);
+    }
+  });
+}
@@ -0,0 +1,134 @@
+#include "SpriteBatch.h"
+#include "CShape.h"
+#include "Window.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+void SpriteBatch::beginFrame() {
+  m_stats = Stats{};
+}
+
+void SpriteBatch::draw(const sf::Sprite& sprite, int layer) {
+  draw(&sprite.getTexture(), sprite.getTextureRect(), sprite.getTransform(), sprite.getColor(), layer);
+}
+
+void SpriteBatch::draw(const sf::Texture* texture, const sf::IntRect& rect, const sf::Transform& transform,
+                       const sf::Color& color, int layer) {
+  // Igual que sf::Sprite: el quad local va de (0,0) a |rect.size| y las coordenadas de
+  // textura salen del recorte (un tamaño negativo voltea la imagen).
+  const sf::Vector2f size{ static_cast<float>(std::abs(rect.size.x)), static_cast<float>(std::abs(rect.size.y)) };
+  const float left = static_cast<float>(rect.position.x);
+  const float top = static_cast<float>(rect.position.y);
+  const float right = left + static_cast<float>(rect.size.x);
+  const float bottom = top + static_cast<float>(rect.size.y);
+  const sf::Vector2f local[4] = { { 0.f, 0.f }, { size.x, 0.f }, { size.x, size.y }, { 0.f, size.y } };
+  const sf::Vector2f uv[4] = { { left, top }, { right, top }, { right, bottom }, { left, bottom } };
+  sf::Vertex corners[4];
+  for (int i = 0; i < 4; ++i) {
+    corners[i] = sf::Vertex{ transform.transformPoint(local[i]), color, uv[i] };
+  }
+  const int order[6] = { 0, 1, 2, 0, 2, 3 };
+  const std::size_t first = m_vertices.getVertexCount();
+  m_vertices.resize(first + 6);
+  for (std::size_t i = 0; i < 6; ++i) {
+    m_vertices[first + i] = corners[order[i]];
+  }
+  if (enqueue(texture, layer, first)) {
+    ++m_stats.quads;
+  }
+}
+
+void SpriteBatch::draw(const CShape& shape, int layer) {
+  const std::size_t first = m_vertices.getVertexCount();
+  shape.appendTo(m_vertices);
+  if (m_vertices.getVertexCount() > first && enqueue(shape.getDrawTexture(), layer, first)) {
+    ++m_stats.shapes;
+  }
+}
+
+bool SpriteBatch::enqueue(const sf::Texture* texture, int layer, std::size_t first) {
+  const std::size_t end = m_vertices.getVertexCount();
+  if (m_cullRect) {
+    sf::Vector2f min = m_vertices[first].position;
+    sf::Vector2f max = min;
+    for (std::size_t i = first + 1; i < end; ++i) {
+      min.x = std::min(min.x, m_vertices[i].position.x);
+      min.y = std::min(min.y, m_vertices[i].position.y);
+      max.x = std::max(max.x, m_vertices[i].position.x);
+      max.y = std::max(max.y, m_vertices[i].position.y);
+    }
+    const sf::FloatRect& cull = *m_cullRect;
+    if (max.x < cull.position.x || max.y < cull.position.y
+        || min.x > cull.position.x + cull.size.x || min.y > cull.position.y + cull.size.y) {
+      m_vertices.resize(first);
+      ++m_stats.culled;
+      return false;
+    }
+  }
+  Item& item = m_items.emplace_back();
+  item.texture = texture;
+  item.layer = layer;
+  item.order = static_cast<std::uint32_t>(m_items.size() - 1);
+  item.first = static_cast<std::uint32_t>(first);
+  item.count = static_cast<std::uint32_t>(end - first);
+  return true;
+}
+
+void SpriteBatch::flush(const EngineUtilities::TSharedPointer<Window>& window) {
+  if (m_items.empty()) {
+    return;
+  }
+  m_sorted.resize(m_items.size());
+  for (std::uint32_t i = 0; i < m_sorted.size(); ++i) {
+    m_sorted[i] = i;
+  }
+  std::sort(m_sorted.begin(), m_sorted.end(), [this](std::uint32_t a, std::uint32_t b) {
+    const Item& qa = m_items[a];
+    const Item& qb = m_items[b];
+    if (qa.layer != qb.layer) {
+      return qa.layer < qb.layer;
+    }
+    if (qa.texture != qb.texture) {
+      return std::less<const sf::Texture*>()(qa.texture, qb.texture);
+    }
+    return qa.order < qb.order;
+  });
+
+  // Un vertex array por tramo de misma capa y textura.
+  std::size_t run = 0;
+  for (std::size_t begin = 0; begin < m_sorted.size(); ++run) {
+    const Item& first = m_items[m_sorted[begin]];
+    std::size_t count = first.count;
+    std::size_t end = begin + 1;
+    while (end < m_sorted.size() && m_items[m_sorted[end]].layer == first.layer
+           && m_items[m_sorted[end]].texture == first.texture) {
+      count += m_items[m_sorted[end]].count;
+      ++end;
+    }
+
+    if (run == m_arrays.size()) {
+      m_arrays.emplace_back(sf::PrimitiveType::Triangles);
+    }
+    sf::VertexArray& vertices = m_arrays[run];
+    vertices.resize(count);
+    std::size_t v = 0;
+    for (std::size_t k = begin; k < end; ++k) {
+      const Item& item = m_items[m_sorted[k]];
+      for (std::uint32_t i = 0; i < item.count; ++i) {
+        vertices[v++] = m_vertices[item.first + i];
+      }
+    }
+
+    sf::RenderStates states;
+    states.texture = first.texture;
+    window->draw(vertices, states);
+    ++m_stats.drawCalls;
+    begin = end;
+  }
+
+  ++m_stats.flushes;
+  m_items.clear();
+  m_vertices.clear();
+}
@@ -0,0 +1,153 @@
+#include "SpriteSheetBaker.h"
+#include "ECS/DirectionalSprite.h"
+#include "RaceSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace {
+  constexpr float kDegToRad = 0.0174532925f;
+
+  std::vector<std::string> parseNames(const char* text) {
+    std::vector<std::string> names;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (!item.empty()) {
+        names.push_back(item);
+      }
+    }
+    return names;
+  }
+
+  /**
+   * Muestra bilineal de @p source en (x, y) (px, centros en .5); fuera de la imagen es transparente.
+   * El color se pondera por el alfa para que los texels transparentes no tiñan los bordes.
+   */
+  sf::Color sampleBilinear(const sf::Image& source, float x, float y) {
+    const sf::Vector2u size = source.getSize();
+    const float fx = x - 0.5f;
+    const float fy = y - 0.5f;
+    const int x0 = static_cast<int>(std::floor(fx));
+    const int y0 = static_cast<int>(std::floor(fy));
+    const float tx = fx - static_cast<float>(x0);
+    const float ty = fy - static_cast<float>(y0);
+
+    float r = 0.f, g = 0.f, b = 0.f, a = 0.f;
+    for (int j = 0; j < 2; ++j) {
+      for (int i = 0; i < 2; ++i) {
+        const int sx = x0 + i;
+        const int sy = y0 + j;
+        if (sx < 0 || sy < 0 || sx >= static_cast<int>(size.x) || sy >= static_cast<int>(size.y)) {
+          continue;
+        }
+        const float w = (i ? tx : 1.f - tx) * (j ? ty : 1.f - ty);
+        const sf::Color c = source.getPixel({ static_cast<unsigned>(sx), static_cast<unsigned>(sy) });
+        const float wa = w * static_cast<float>(c.a);
+        r += wa * c.r;
+        g += wa * c.g;
+        b += wa * c.b;
+        a += wa;
+      }
+    }
+    if (a <= 0.f) {
+      return sf::Color::Transparent;
+    }
+    return sf::Color(static_cast<std::uint8_t>(std::lround(r / a)), static_cast<std::uint8_t>(std::lround(g / a)),
+                     static_cast<std::uint8_t>(std::lround(b / a)), static_cast<std::uint8_t>(std::lround(std::min(a, 255.f))));
+  }
+}
+
+bool SpriteSheetBaker::parseArgs(int argc, char* argv[], Config& out) {
+  bool requested = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (std::strcmp(arg, "--bake-sprites") == 0) {
+      requested = true;
+    }
+    else if (std::strcmp(arg, "--directions") == 0 && hasValue) {
+      out.directions = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--cell") == 0 && hasValue) {
+      out.cellWidth = static_cast<unsigned>(std::max(4, std::atoi(argv[++i])));
+    }
+    else if (std::strcmp(arg, "--tilt") == 0 && hasValue) {
+      out.tilt = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.05f, 1.f);
+    }
+    else if (std::strcmp(arg, "--offset") == 0 && hasValue) {
+      out.spriteAngleOffset = static_cast<float>(std::atof(argv[++i]));
+    }
+    else if (std::strcmp(arg, "--names") == 0 && hasValue) {
+      out.names = parseNames(argv[++i]);
+    }
+  }
+  return requested;
+}
+
+sf::Image SpriteSheetBaker::bake(const sf::Image& source, const Config& config) {
+  const int directions = std::max(config.directions, 1);
+  const int columns = DirectionalSprite::columnsFor(directions);
+  const int rows = (directions + columns - 1) / columns;
+  const unsigned cellWidth = config.cellWidth;
+  const unsigned cellHeight = std::max(1u, static_cast<unsigned>(std::lround(cellWidth * config.tilt)));
+  sf::Image sheet({ cellWidth * columns, cellHeight * rows }, sf::Color::Transparent);
+
+  const sf::Vector2f sourceSize(source.getSize());
+  const float diagonal = std::sqrt(sourceSize.x * sourceSize.x + sourceSize.y * sourceSize.y);
+  if (diagonal <= 0.f) {
+    return sheet;
+  }
+  const float sourcePerCell = diagonal / static_cast<float>(cellWidth); // px de sprite por px de celda
+  const sf::Vector2f center = 0.5f * sourceSize;
+
+  for (int frame = 0; frame < directions; ++frame) {
+    // Morro del sprite en -offset; en pantalla debe apuntar arriba (-90) más el rumbo relativo.
+    const float relative = 360.f * static_cast<float>(frame) / static_cast<float>(directions);
+    const float rotation = (relative - 90.f + config.spriteAngleOffset) * kDegToRad;
+    const float c = std::cos(rotation);
+    const float s = std::sin(rotation);
+    const unsigned originX = cellWidth * static_cast<unsigned>(frame % columns);
+    const unsigned originY = cellHeight * static_cast<unsigned>(frame / columns);
+
+    for (unsigned y = 0; y < cellHeight; ++y) {
+      // Se deshace el aplastado y luego el giro para llegar al píxel del sprite cenital.
+      const float dy = (static_cast<float>(y) + 0.5f - 0.5f * static_cast<float>(cellHeight)) / config.tilt;
+      for (unsigned x = 0; x < cellWidth; ++x) {
+        const float dx = static_cast<float>(x) + 0.5f - 0.5f * static_cast<float>(cellWidth);
+        const float sx = (c * dx + s * dy) * sourcePerCell;
+        const float sy = (-s * dx + c * dy) * sourcePerCell;
+        sheet.setPixel({ originX + x, originY + y }, sampleBilinear(source, center.x + sx, center.y + sy));
+      }
+    }
+  }
+  return sheet;
+}
+
+int SpriteSheetBaker::run(const Config& config) {
+  const std::vector<std::string>& names = config.names.empty() ? RaceSimulation::defaultCharacters() : config.names;
+  int failures = 0;
+  for (const auto& name : names) {
+    const std::string inPath = "bin/" + name + ".png";
+    const std::string outPath = "bin/" + DirectionalSprite::sheetName(name) + ".png";
+    sf::Image source;
+    if (!source.loadFromFile(inPath)) {
+      std::cerr << "SpriteSheetBaker::run : no se pudo leer " << inPath << "\n";
+      ++failures;
+      continue;
+    }
+    const sf::Image sheet = bake(source, config);
+    if (!sheet.saveToFile(outPath)) {
+      std::cerr << "SpriteSheetBaker::run : no se pudo escribir " << outPath << "\n";
+      ++failures;
+      continue;
+    }
+    std::printf("%s -> %s (%d direcciones, %ux%u)\n", inPath.c_str(), outPath.c_str(), config.directions,
+      sheet.getSize().x, sheet.getSize().y);
+  }
+  return failures == 0 ? 0 : 1;
+}
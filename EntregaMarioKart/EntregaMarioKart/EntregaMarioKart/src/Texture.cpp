@@ -1,28 +1,63 @@
-﻿INICIAR ventana ChrisEngine de tamaño 800x600 con título "ChrisEngine Test"
-
-CREAR lista personajes :
-"princesa.png"
-"sonic.png"
-"virdo.png"
-"wario.png"
-
-CARGAR textura pista : "pista de carreras.png"
-CREAR sprite pista con la textura
-COLOCAR sprite pista en posición(0, 0)
-
-PARA cada personaje en lista personajes :
-CARGAR textura del personaje
-CREAR sprite con la textura
-COLOCAR sprite en posición(100, y)  // separar verticalmente
-AUMENTAR y en 100
-
-MIENTRAS ventana esté abierta :
-LEER eventos de la ventana
-SI evento es CerrarVentana :
-CERRAR ventana
-
-LIMPIAR ventana con color negro
-DIBUJAR sprite de pista
-DIBUJAR todos los sprites de personajes
-MOSTRAR ventana
-FIN MIETRAS
+#include "ECS/Texture.h"
+#include "Window.h"
+
+#include <iostream>
+
+namespace {
+  sf::Vector2f rectCenter(const sf::IntRect& rect) {
+    return { rect.size.x * 0.5f, rect.size.y * 0.5f };
+  }
+}
+
+Texture::Texture(const std::string& textureName, const std::string& extension)
+  : Component(ComponentType::TEXTURE)
+  , m_name(textureName)
+  , m_ext(extension)
+{
+  const std::string path = "bin/" + m_name + "." + m_ext;
+  if (!m_texture.loadFromFile(path)) {
+    std::cerr << "Texture::Texture : no se pudo leer " << path << "\n";
+    return;
+  }
+  m_sprite.emplace(m_texture);
+  m_sprite->setOrigin(rectCenter(m_sprite->getTextureRect()));
+}
+
+Texture::Texture(const std::string& textureName, const sf::Texture& atlasPage, const sf::IntRect& rect)
+  : Component(ComponentType::TEXTURE)
+  , m_name(textureName)
+  , m_atlas(true)
+{
+  m_sprite.emplace(atlasPage, rect);
+  m_sprite->setOrigin(rectCenter(rect));
+}
+
+void Texture::render(const EngineUtilities::TSharedPointer<Window>& window) {
+  if (m_sprite) {
+    window->draw(*m_sprite);
+  }
+}
+
+void Texture::setPosition(const sf::Vector2f& p) {
+  if (m_sprite) {
+    m_sprite->setPosition(p);
+  }
+}
+
+void Texture::setRotation(float degrees) {
+  if (m_sprite) {
+    m_sprite->setRotation(sf::degrees(degrees));
+  }
+}
+
+void Texture::setScale(const sf::Vector2f& s) {
+  if (m_sprite) {
+    m_sprite->setScale(s);
+  }
+}
+
+void Texture::setOrigin(const sf::Vector2f& o) {
+  if (m_sprite) {
+    m_sprite->setOrigin(o);
+  }
+}
@@ -0,0 +1,256 @@
+#include "TextureAtlas.h"
+#include "BinaryIO.h"
+#include "Hash.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+namespace {
+  constexpr std::uint32_t kMetaMagic = 0x314C5441; // "ATL1"
+  constexpr std::uint32_t kMetaVersion = 1;
+
+  using Hash::fnv1a;
+
+  std::string pagePath(const std::string& cacheBase, std::size_t page) {
+    return cacheBase + "_" + std::to_string(page) + ".png";
+  }
+}
+
+TextureAtlas::TextureAtlas(unsigned pageSize, unsigned padding)
+  : m_pageSize(std::max(pageSize, 1u))
+  , m_padding(padding)
+{
+}
+
+std::vector<TextureAtlas::Placement> TextureAtlas::pack(const std::vector<sf::Vector2u>& sizes,
+                                                        unsigned pageSize, unsigned padding) {
+  std::vector<Placement> placements(sizes.size());
+  std::vector<std::size_t> order(sizes.size());
+  std::iota(order.begin(), order.end(), std::size_t{ 0 });
+  // Las más altas primero: cada estantería desperdicia poco por encima de las que le siguen.
+  std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+    if (sizes[a].y != sizes[b].y) {
+      return sizes[a].y > sizes[b].y;
+    }
+    return sizes[a].x > sizes[b].x;
+  });
+
+  std::uint32_t page = 0;
+  unsigned x = 0;            // Cursor en la estantería actual.
+  unsigned shelfY = 0;       // Borde superior de la estantería actual.
+  unsigned shelfHeight = 0;
+  for (std::size_t i : order) {
+    const unsigned w = sizes[i].x + 2 * padding;
+    const unsigned h = sizes[i].y + 2 * padding;
+    if (w > pageSize || h > pageSize || sizes[i].x == 0 || sizes[i].y == 0) {
+      continue; // no cabe en ninguna página
+    }
+    if (x + w > pageSize) {
+      shelfY += shelfHeight;
+      x = 0;
+      shelfHeight = 0;
+    }
+    if (shelfY + h > pageSize) {
+      ++page; // la página actual ya tiene algo: una imagen sola siempre cabe
+      x = 0;
+      shelfY = 0;
+      shelfHeight = 0;
+    }
+    Placement& p = placements[i];
+    p.page = page;
+    p.rect = sf::IntRect({ static_cast<int>(x + padding), static_cast<int>(shelfY + padding) },
+                         { static_cast<int>(sizes[i].x), static_cast<int>(sizes[i].y) });
+    p.placed = true;
+    x += w;
+    shelfHeight = std::max(shelfHeight, h);
+  }
+  return placements;
+}
+
+bool TextureAtlas::loadOrBuild(const std::vector<std::string>& names, const std::string& cacheBase,
+                               const std::string& extension) {
+  namespace fs = std::filesystem;
+  m_fromCache = false;
+
+  // La clave cambia si cambia cualquier imagen, la lista o los parámetros de empaquetado.
+  std::vector<std::string> present;
+  std::uint64_t key = Hash::kFnv64Seed;
+  for (const auto& name : names) {
+    const fs::path source("bin/" + name + "." + extension);
+    std::error_code ec;
+    const auto size = fs::file_size(source, ec);
+    if (ec) {
+      std::cerr << "TextureAtlas::loadOrBuild : no se encuentra " << source.string() << "\n";
+      continue;
+    }
+    const auto stamp = fs::last_write_time(source, ec).time_since_epoch().count();
+    key = fnv1a(key, name.data(), name.size());
+    key = fnv1a(key, &size, sizeof(size));
+    key = fnv1a(key, &stamp, sizeof(stamp));
+    present.push_back(name);
+  }
+  key = fnv1a(key, &m_pageSize, sizeof(m_pageSize));
+  key = fnv1a(key, &m_padding, sizeof(m_padding));
+  key = fnv1a(key, &kMetaVersion, sizeof(kMetaVersion));
+  if (present.empty()) {
+    return false;
+  }
+
+  const std::string metaPath = cacheBase + ".atlas";
+  std::uint32_t pageCount = 0;
+  if (loadMeta(metaPath, key, pageCount)) {
+    std::vector<sf::Texture> pages(pageCount);
+    bool ok = true;
+    for (std::uint32_t p = 0; p < pageCount && ok; ++p) {
+      ok = pages[p].loadFromFile(pagePath(cacheBase, p));
+    }
+    if (ok) {
+      m_pages = std::move(pages);
+      m_fromCache = true;
+      return true;
+    }
+  }
+
+  // --- Empaquetado ---
+  std::vector<sf::Image> images(present.size());
+  std::vector<sf::Vector2u> sizes(present.size());
+  for (std::size_t i = 0; i < present.size(); ++i) {
+    const std::string path = "bin/" + present[i] + "." + extension;
+    if (!images[i].loadFromFile(path)) {
+      std::cerr << "TextureAtlas::loadOrBuild : no se pudo leer " << path << "\n";
+      continue; // tamaño 0: pack() la omite
+    }
+    sizes[i] = images[i].getSize();
+  }
+  const std::vector<Placement> placements = pack(sizes, m_pageSize, m_padding);
+
+  // Cada página se recorta a lo que ocupan sus imágenes.
+  std::vector<sf::Vector2u> extents;
+  for (const Placement& p : placements) {
+    if (!p.placed) {
+      continue;
+    }
+    if (p.page >= extents.size()) {
+      extents.resize(p.page + 1, { 0u, 0u });
+    }
+    extents[p.page].x = std::max(extents[p.page].x, static_cast<unsigned>(p.rect.position.x + p.rect.size.x) + m_padding);
+    extents[p.page].y = std::max(extents[p.page].y, static_cast<unsigned>(p.rect.position.y + p.rect.size.y) + m_padding);
+  }
+  std::vector<sf::Image> pageImages;
+  pageImages.reserve(extents.size());
+  for (const sf::Vector2u& extent : extents) {
+    pageImages.emplace_back(extent, sf::Color::Transparent);
+  }
+
+  m_entries.clear();
+  for (std::size_t i = 0; i < present.size(); ++i) {
+    const Placement& p = placements[i];
+    if (!p.placed) {
+      if (sizes[i].x > 0) {
+        std::cerr << "TextureAtlas::loadOrBuild : " << present[i] << " no cabe en una página de "
+                  << m_pageSize << " px\n";
+      }
+      continue;
+    }
+    const sf::Vector2u dest{ static_cast<unsigned>(p.rect.position.x), static_cast<unsigned>(p.rect.position.y) };
+    if (!pageImages[p.page].copy(images[i], dest)) {
+      std::cerr << "TextureAtlas::loadOrBuild : no se pudo copiar " << present[i] << "\n";
+      continue;
+    }
+    m_entries[present[i]] = Entry{ p.page, p.rect };
+  }
+  if (m_entries.empty()) {
+    return false;
+  }
+
+  m_pages = std::vector<sf::Texture>(pageImages.size());
+  for (std::size_t page = 0; page < pageImages.size(); ++page) {
+    if (!m_pages[page].loadFromImage(pageImages[page])) {
+      std::cerr << "TextureAtlas::loadOrBuild : no se pudo crear la página " << page << "\n";
+    }
+  }
+  for (std::size_t page = 0; page < pageImages.size(); ++page) {
+    if (!pageImages[page].saveToFile(pagePath(cacheBase, page))) {
+      std::cerr << "TextureAtlas::loadOrBuild : no se pudo escribir " << pagePath(cacheBase, page) << "\n";
+      return true; // sin páginas en disco no se escriben metadatos que las referencien
+    }
+  }
+  if (!saveMeta(metaPath, key)) {
+    std::cerr << "TextureAtlas::loadOrBuild : no se pudo escribir la caché " << metaPath << "\n";
+  }
+  MESSAGE("TextureAtlas", "loadOrBuild", metaPath);
+  return true;
+}
+
+TextureAtlas::Region TextureAtlas::find(const std::string& name) const {
+  auto it = m_entries.find(name);
+  if (it == m_entries.end() || it->second.page >= m_pages.size()) {
+    return Region{};
+  }
+  return Region{ &m_pages[it->second.page], it->second.rect };
+}
+
+bool TextureAtlas::saveMeta(const std::string& path, std::uint64_t sourceKey) const {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  const std::uint32_t header[] = { kMetaMagic, kMetaVersion,
+    static_cast<std::uint32_t>(m_pages.size()), static_cast<std::uint32_t>(m_entries.size()) };
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(&sourceKey), sizeof(sourceKey));
+  for (const auto& [name, entry] : m_entries) {
+    const std::uint16_t length = static_cast<std::uint16_t>(name.size());
+    const std::int32_t rect[] = { entry.rect.position.x, entry.rect.position.y, entry.rect.size.x, entry.rect.size.y };
+    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.write(name.data(), length);
+    out.write(reinterpret_cast<const char*>(&entry.page), sizeof(entry.page));
+    out.write(reinterpret_cast<const char*>(rect), sizeof(rect));
+  }
+  return static_cast<bool>(out);
+}
+
+bool TextureAtlas::loadMeta(const std::string& path, std::uint64_t sourceKey, std::uint32_t& pageCount) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::uint32_t header[4] = {};
+  std::uint64_t key = 0;
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  in.read(reinterpret_cast<char*>(&key), sizeof(key));
+  if (!in || header[0] != kMetaMagic || header[1] != kMetaVersion || key != sourceKey) {
+    return false;
+  }
+  // Toda página tiene al menos una entrada, y cada entrada ocupa como mínimo su longitud,
+  // la página y el rectángulo.
+  constexpr std::uint64_t kMinEntryBytes = sizeof(std::uint16_t) + sizeof(std::uint32_t) + 4 * sizeof(std::int32_t);
+  if (header[2] == 0 || header[2] > header[3] ||
+      static_cast<std::uint64_t>(header[3]) * kMinEntryBytes > BinaryIO::remainingBytes(in)) {
+    std::cerr << "TextureAtlas::loadMeta : metadatos no válidos en " << path << "\n";
+    return false;
+  }
+  std::unordered_map<std::string, Entry> entries;
+  for (std::uint32_t i = 0; i < header[3]; ++i) {
+    std::uint16_t length = 0;
+    in.read(reinterpret_cast<char*>(&length), sizeof(length));
+    std::string name(length, '\0');
+    in.read(name.data(), length);
+    Entry entry;
+    std::int32_t rect[4] = {};
+    in.read(reinterpret_cast<char*>(&entry.page), sizeof(entry.page));
+    in.read(reinterpret_cast<char*>(rect), sizeof(rect));
+    if (!in || entry.page >= header[2]) {
+      return false;
+    }
+    entry.rect = sf::IntRect({ rect[0], rect[1] }, { rect[2], rect[3] });
+    entries[name] = entry;
+  }
+  pageCount = header[2];
+  m_entries = std::move(entries);
+  return true;
+}
@@ -0,0 +1,100 @@
+#include "TrackChunker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+  /**
+   * true si todos los píxeles de @p rect en @p image tienen alfa 0.
+   */
+  bool isTransparent(const sf::Image& image, const sf::IntRect& rect) {
+    const std::uint8_t* pixels = image.getPixelsPtr();
+    const std::size_t stride = image.getSize().x;
+    for (int y = rect.position.y; y < rect.position.y + rect.size.y; ++y) {
+      const std::uint8_t* row = pixels + (static_cast<std::size_t>(y) * stride + rect.position.x) * 4;
+      for (int x = 0; x < rect.size.x; ++x) {
+        if (row[x * 4 + 3] != 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+bool TrackChunker::parseArgs(int argc, char* argv[], Config& out) {
+  bool requested = false;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (std::strcmp(arg, "--chunk-track") == 0) {
+      requested = true;
+    }
+    else if (std::strcmp(arg, "--track") == 0 && hasValue) {
+      out.trackPath = argv[++i];
+    }
+    else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+      out.outBase = argv[++i];
+    }
+    else if (std::strcmp(arg, "--chunk") == 0 && hasValue) {
+      out.chunkSize = static_cast<unsigned>(std::max(16, std::atoi(argv[++i])));
+    }
+  }
+  return requested;
+}
+
+bool TrackChunker::build(const sf::Image& image, const std::string& outBase, unsigned chunkSize,
+                         TrackStreamer::Index& index) {
+  index.width = image.getSize().x;
+  index.height = image.getSize().y;
+  constexpr std::uint32_t kMaxSize = TrackStreamer::Index::kMaxTrackSize;
+  if (index.width == 0 || index.height == 0 || index.width > kMaxSize || index.height > kMaxSize) {
+    std::cerr << "TrackChunker::build : tamaño de pista no admitido (" << index.width << "x" << index.height << ")\n";
+    return false;
+  }
+  index.chunkSize = std::clamp(chunkSize, 1u, TrackStreamer::Index::kMaxChunkSize);
+  index.columns = (index.width + index.chunkSize - 1) / index.chunkSize;
+  index.rows = (index.height + index.chunkSize - 1) / index.chunkSize;
+  index.empty.assign(static_cast<std::size_t>(index.columns) * index.rows, 0);
+
+  bool ok = true;
+  for (std::uint32_t row = 0; row < index.rows; ++row) {
+    for (std::uint32_t column = 0; column < index.columns; ++column) {
+      const sf::IntRect rect = index.chunkRect(column, row);
+      if (isTransparent(image, rect)) {
+        index.empty[row * index.columns + column] = 1;
+        continue;
+      }
+      sf::Image chunk(sf::Vector2u(rect.size), sf::Color::Transparent);
+      const std::string path = TrackStreamer::chunkPath(outBase, column, row);
+      if (!chunk.copy(image, { 0u, 0u }, rect) || !chunk.saveToFile(path)) {
+        std::cerr << "TrackChunker::build : no se pudo escribir " << path << "\n";
+        ok = false;
+      }
+    }
+  }
+  // El índice va al final: un troceado a medias no deja un índice que apunte a chunks viejos.
+  if (ok && !index.save(TrackStreamer::indexPath(outBase))) {
+    std::cerr << "TrackChunker::build : no se pudo escribir " << TrackStreamer::indexPath(outBase) << "\n";
+    ok = false;
+  }
+  return ok;
+}
+
+int TrackChunker::run(const Config& config) {
+  sf::Image image;
+  if (!image.loadFromFile(config.trackPath)) {
+    std::cerr << "TrackChunker::run : no se pudo leer " << config.trackPath << "\n";
+    return 1;
+  }
+  TrackStreamer::Index index;
+  if (!build(image, config.outBase, config.chunkSize, index)) {
+    return 1;
+  }
+  const std::size_t empty = static_cast<std::size_t>(std::count(index.empty.begin(), index.empty.end(), 1));
+  std::printf("%s (%ux%u) -> %s: %ux%u chunks de %u px, %zu vacíos\n", config.trackPath.c_str(), index.width,
+    index.height, TrackStreamer::indexPath(config.outBase).c_str(), index.columns, index.rows, index.chunkSize, empty);
+  return 0;
+}
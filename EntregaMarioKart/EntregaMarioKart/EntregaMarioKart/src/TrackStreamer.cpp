@@ -0,0 +1,304 @@
+#include "TrackStreamer.h"
+#include "SpriteBatch.h"
+#include "BinaryIO.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+  constexpr std::uint32_t kIndexMagic = 0x31484354; // "TCH1"
+  constexpr std::uint32_t kIndexVersion = 1;
+}
+
+// --- Índice ---
+
+bool TrackStreamer::Index::save(const std::string& path) const {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  const std::uint32_t header[] = { kIndexMagic, kIndexVersion, width, height, chunkSize, columns, rows };
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(empty.data()), static_cast<std::streamsize>(empty.size()));
+  return static_cast<bool>(out);
+}
+
+bool TrackStreamer::Index::load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::uint32_t header[7] = {};
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!in || header[0] != kIndexMagic || header[1] != kIndexVersion) {
+    return false;
+  }
+  // Con los límites, ni la rejilla ni el tamaño de un chunk en bytes desbordan; la rejilla
+  // además tiene que caber en lo que queda del fichero.
+  const std::uint32_t size = header[4];
+  if (size == 0 || size > kMaxChunkSize || header[2] == 0 || header[2] > kMaxTrackSize ||
+      header[3] == 0 || header[3] > kMaxTrackSize ||
+      header[5] != (header[2] + size - 1) / size || header[6] != (header[3] + size - 1) / size ||
+      static_cast<std::uint64_t>(header[5]) * header[6] > BinaryIO::remainingBytes(in)) {
+    std::cerr << "TrackStreamer::Index::load : índice no válido en " << path << "\n";
+    return false;
+  }
+  std::vector<std::uint8_t> flags(static_cast<std::size_t>(header[5]) * header[6]);
+  in.read(reinterpret_cast<char*>(flags.data()), static_cast<std::streamsize>(flags.size()));
+  if (!in) {
+    return false;
+  }
+  width = header[2];
+  height = header[3];
+  chunkSize = size;
+  columns = header[5];
+  rows = header[6];
+  empty = std::move(flags);
+  return true;
+}
+
+sf::IntRect TrackStreamer::Index::chunkRect(std::uint32_t column, std::uint32_t row) const {
+  const std::uint32_t x = column * chunkSize;
+  const std::uint32_t y = row * chunkSize;
+  return sf::IntRect({ static_cast<int>(x), static_cast<int>(y) },
+    { static_cast<int>(std::min(chunkSize, width - x)), static_cast<int>(std::min(chunkSize, height - y)) });
+}
+
+std::string TrackStreamer::chunkPath(const std::string& base, std::uint32_t column, std::uint32_t row) {
+  return base + "_" + std::to_string(column) + "_" + std::to_string(row) + ".png";
+}
+
+// --- Carga ---
+
+TrackStreamer::~TrackStreamer() {
+  close();
+}
+
+bool TrackStreamer::open(const std::string& base, const Params& params) {
+  close();
+  Index index;
+  if (!index.load(indexPath(base))) {
+    return false;
+  }
+  m_base = base;
+  m_index = std::move(index);
+  m_params = params;
+  m_chunks.clear();
+  m_chunks.resize(m_index.empty.size());
+  m_ready.clear();
+  m_frame = 0;
+  m_stats = Stats();
+  const std::size_t chunkBytes = static_cast<std::size_t>(m_index.chunkSize) * m_index.chunkSize * 4;
+  m_budgetChunks = std::max<std::size_t>(1, m_params.budgetBytes / chunkBytes);
+
+  m_stop = false;
+  m_worker = std::thread(&TrackStreamer::workerLoop, this);
+  MESSAGE("TrackStreamer", "open", indexPath(base));
+  return true;
+}
+
+void TrackStreamer::close() {
+  if (m_worker.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+      m_requests.clear();
+    }
+    m_wake.notify_all();
+    m_worker.join();
+  }
+  m_decoded.clear();
+  m_ready.clear();
+  m_chunks.clear();
+}
+
+void TrackStreamer::workerLoop() {
+  for (;;) {
+    std::uint32_t chunk = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+      if (m_stop) {
+        return;
+      }
+      chunk = m_requests.front();
+      m_requests.pop_front();
+    }
+    // Fuera del cerrojo: leer y decodificar el PNG es lo caro.
+    Decoded decoded;
+    decoded.chunk = chunk;
+    decoded.ok = decoded.image.loadFromFile(chunkPath(m_base, chunk % m_index.columns, chunk / m_index.columns));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_stop) {
+      m_decoded.push_back(std::move(decoded));
+    }
+  }
+}
+
+bool TrackStreamer::chunkRange(const sf::FloatRect& rect, sf::Vector2u& first, sf::Vector2u& last) const {
+  const float size = static_cast<float>(m_index.chunkSize);
+  const float left = std::max(rect.position.x, 0.f);
+  const float top = std::max(rect.position.y, 0.f);
+  const float right = std::min(rect.position.x + rect.size.x, static_cast<float>(m_index.width));
+  const float bottom = std::min(rect.position.y + rect.size.y, static_cast<float>(m_index.height));
+  if (right <= left || bottom <= top) {
+    return false;
+  }
+  first = { static_cast<unsigned>(left / size), static_cast<unsigned>(top / size) };
+  last = { std::min(static_cast<unsigned>(std::ceil(right / size)), m_index.columns),
+           std::min(static_cast<unsigned>(std::ceil(bottom / size)), m_index.rows) };
+  return true;
+}
+
+void TrackStreamer::update(const sf::FloatRect& visible) {
+  if (!isOpen()) {
+    return;
+  }
+  ++m_frame;
+  const float margin = m_params.margin;
+  const sf::FloatRect wantedRect(visible.position - sf::Vector2f(margin, margin),
+                                 visible.size + sf::Vector2f(2.f * margin, 2.f * margin));
+  const sf::Vector2f center = visible.position + 0.5f * visible.size;
+  const float size = static_cast<float>(m_index.chunkSize);
+
+  // --- Qué chunks hacen falta (marcados con el frame actual) ---
+  m_missing.clear();
+  m_stats.wanted = 0;
+  sf::Vector2u first, last;
+  if (chunkRange(wantedRect, first, last)) {
+    for (unsigned row = first.y; row < last.y; ++row) {
+      for (unsigned column = first.x; column < last.x; ++column) {
+        const std::uint32_t index = row * m_index.columns + column;
+        if (m_index.empty[index]) {
+          continue;
+        }
+        ++m_stats.wanted;
+        m_chunks[index].lastUsed = m_frame;
+        const sf::Vector2f chunkCenter((static_cast<float>(column) + 0.5f) * size, (static_cast<float>(row) + 0.5f) * size);
+        const sf::Vector2f d = chunkCenter - center;
+        m_missing.emplace_back(d.x * d.x + d.y * d.y, index);
+      }
+    }
+  }
+
+  // --- Cola de pedidos: se rehace entera, el más cercano delante ---
+  bool requested = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::uint32_t index : m_requests) {
+      m_chunks[index].state = State::Unloaded; // si sigue haciendo falta, se vuelve a pedir abajo
+    }
+    m_requests.clear();
+    m_missing.erase(std::remove_if(m_missing.begin(), m_missing.end(),
+      [this](const std::pair<float, std::uint32_t>& m) { return m_chunks[m.second].state != State::Unloaded; }),
+      m_missing.end());
+    std::sort(m_missing.begin(), m_missing.end());
+    for (const auto& m : m_missing) {
+      m_chunks[m.second].state = State::Queued;
+      m_requests.push_back(m.second);
+    }
+    requested = !m_requests.empty();
+    for (Decoded& decoded : m_decoded) {
+      m_ready.push_back(std::move(decoded));
+    }
+    m_decoded.clear();
+  }
+  if (requested) {
+    m_wake.notify_one();
+  }
+
+  // --- Subida a GPU, limitada por frame ---
+  int uploads = 0;
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < m_ready.size(); ++i) {
+    Decoded& decoded = m_ready[i];
+    Chunk& chunk = m_chunks[decoded.chunk];
+    if (chunk.lastUsed != m_frame) {
+      chunk.state = State::Unloaded; // salió de la vista mientras se decodificaba
+      continue;
+    }
+    if (uploads >= m_params.uploadsPerFrame) {
+      if (kept != i) {
+        m_ready[kept] = std::move(decoded);
+      }
+      ++kept;
+      continue;
+    }
+    auto texture = std::make_unique<sf::Texture>();
+    if (!decoded.ok || !texture->loadFromImage(decoded.image)) {
+      std::cerr << "TrackStreamer::update : no se pudo cargar "
+                << chunkPath(m_base, decoded.chunk % m_index.columns, decoded.chunk / m_index.columns) << "\n";
+      m_index.empty[decoded.chunk] = 1; // no se reintenta cada frame
+      chunk.state = State::Unloaded;
+      ++m_stats.failures;
+      continue;
+    }
+    chunk.texture = std::move(texture);
+    chunk.state = State::Resident;
+    ++m_stats.loads;
+    ++uploads;
+  }
+  m_ready.resize(kept);
+
+  // --- Presupuesto: fuera los usados hace más tiempo que no están a la vista ---
+  m_evictable.clear();
+  std::size_t resident = 0;
+  for (std::uint32_t i = 0; i < m_chunks.size(); ++i) {
+    if (m_chunks[i].state != State::Resident) {
+      continue;
+    }
+    ++resident;
+    if (m_chunks[i].lastUsed != m_frame) {
+      m_evictable.emplace_back(m_chunks[i].lastUsed, i);
+    }
+  }
+  if (resident > m_budgetChunks) {
+    std::sort(m_evictable.begin(), m_evictable.end());
+    for (const auto& e : m_evictable) {
+      if (resident <= m_budgetChunks) {
+        break;
+      }
+      m_chunks[e.second].texture.reset();
+      m_chunks[e.second].state = State::Unloaded;
+      --resident;
+      ++m_stats.evictions;
+    }
+  }
+
+  m_stats.resident = 0;
+  m_stats.residentBytes = 0;
+  m_stats.pending = 0;
+  for (const Chunk& chunk : m_chunks) {
+    if (chunk.state == State::Resident) {
+      const sf::Vector2u textureSize = chunk.texture->getSize();
+      ++m_stats.resident;
+      m_stats.residentBytes += static_cast<std::size_t>(textureSize.x) * textureSize.y * 4;
+    }
+    else if (chunk.state == State::Queued) {
+      ++m_stats.pending;
+    }
+  }
+  m_stats.overBudget = m_stats.resident > m_budgetChunks;
+}
+
+void TrackStreamer::submit(SpriteBatch& batch, const sf::FloatRect& visible, int layer) const {
+  sf::Vector2u first, last;
+  if (!isOpen() || !chunkRange(visible, first, last)) {
+    return;
+  }
+  for (unsigned row = first.y; row < last.y; ++row) {
+    for (unsigned column = first.x; column < last.x; ++column) {
+      const Chunk& chunk = m_chunks[row * m_index.columns + column];
+      if (chunk.state != State::Resident) {
+        continue;
+      }
+      const sf::IntRect rect = m_index.chunkRect(column, row);
+      sf::Transform transform;
+      transform.translate(sf::Vector2f(rect.position));
+      batch.draw(chunk.texture.get(), sf::IntRect({ 0, 0 }, rect.size), transform, sf::Color::White, layer);
+    }
+  }
+}
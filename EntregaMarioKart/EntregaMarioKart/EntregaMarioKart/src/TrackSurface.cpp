@@ -0,0 +1,303 @@
+#include "TrackSurface.h"
+#include "BinaryIO.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace {
+  constexpr std::uint32_t kCacheMagic = 0x31465354; // "TSF1"
+  constexpr std::uint32_t kCacheVersion = 1;
+  constexpr float kDistanceScale = 4.f;             ///< m_distance en cuartos de píxel (±8191 px).
+  constexpr float kSqrt2 = 1.41421356f;
+
+  using Hash::fnv1a;
+
+  /**
+   * Distancia chamfer (1, raíz de 2) a la celda fuente más cercana; dos pasadas, O(celdas).
+   */
+  void chamfer(std::vector<float>& d, int w, int h) {
+    for (int y = 0; y < h; ++y) {
+      for (int x = 0; x < w; ++x) {
+        float& c = d[y * w + x];
+        if (x > 0)              c = std::min(c, d[y * w + x - 1] + 1.f);
+        if (y > 0)              c = std::min(c, d[(y - 1) * w + x] + 1.f);
+        if (x > 0 && y > 0)     c = std::min(c, d[(y - 1) * w + x - 1] + kSqrt2);
+        if (x + 1 < w && y > 0) c = std::min(c, d[(y - 1) * w + x + 1] + kSqrt2);
+      }
+    }
+    for (int y = h - 1; y >= 0; --y) {
+      for (int x = w - 1; x >= 0; --x) {
+        float& c = d[y * w + x];
+        if (x + 1 < w)              c = std::min(c, d[y * w + x + 1] + 1.f);
+        if (y + 1 < h)              c = std::min(c, d[(y + 1) * w + x] + 1.f);
+        if (x + 1 < w && y + 1 < h) c = std::min(c, d[(y + 1) * w + x + 1] + kSqrt2);
+        if (x > 0 && y + 1 < h)     c = std::min(c, d[(y + 1) * w + x - 1] + kSqrt2);
+      }
+    }
+  }
+}
+
+bool TrackSurface::loadOrBuild(const std::string& imagePath, const std::string& cachePath, float cellSize) {
+  namespace fs = std::filesystem;
+  const fs::path image(imagePath);
+  const fs::path mask = image.parent_path() / (image.stem().string() + "_mask" + image.extension().string());
+  std::error_code ec;
+  const bool isMask = fs::exists(mask, ec);
+  const fs::path source = isMask ? mask : image;
+
+  const auto size = fs::file_size(source, ec);
+  if (ec) {
+    std::cerr << "TrackSurface::loadOrBuild : no se encuentra " << source.string() << "\n";
+    return false;
+  }
+  const auto stamp = fs::last_write_time(source, ec).time_since_epoch().count();
+
+  // La clave cambia si cambia la imagen o cualquier parámetro de construcción.
+  std::uint64_t key = Hash::kFnv64Seed;
+  const std::string name = source.string();
+  key = fnv1a(key, name.data(), name.size());
+  key = fnv1a(key, &size, sizeof(size));
+  key = fnv1a(key, &stamp, sizeof(stamp));
+  key = fnv1a(key, &cellSize, sizeof(cellSize));
+  key = fnv1a(key, &m_wallDistance, sizeof(m_wallDistance));
+  key = fnv1a(key, &kCacheVersion, sizeof(kCacheVersion));
+
+  if (loadCache(cachePath, key)) {
+    return true;
+  }
+
+  sf::Image pixels;
+  if (!pixels.loadFromFile(name)) {
+    std::cerr << "TrackSurface::loadOrBuild : no se pudo leer " << name << "\n";
+    return false;
+  }
+  buildFromImage(pixels, isMask, cellSize);
+  if (!saveCache(cachePath, key)) {
+    std::cerr << "TrackSurface::loadOrBuild : no se pudo escribir la caché " << cachePath << "\n";
+  }
+  MESSAGE("TrackSurface", "loadOrBuild", cachePath);
+  return true;
+}
+
+void TrackSurface::buildFromImage(const sf::Image& image, bool isMask, float cellSize) {
+  m_cellSize = std::max(1.f, cellSize);
+  m_invCellSize = 1.f / m_cellSize;
+  m_origin = { 0.f, 0.f };
+  const sf::Vector2u size = image.getSize();
+  const int cs = static_cast<int>(m_cellSize);
+  m_width = (static_cast<int>(size.x) + cs - 1) / cs;
+  m_height = (static_cast<int>(size.y) + cs - 1) / cs;
+
+  // Cada celda toma la clase mayoritaria de sus píxeles.
+  std::vector<std::uint8_t> road(static_cast<std::size_t>(m_width) * m_height, 0);
+  std::vector<std::uint8_t> wall(road.size(), 0);
+  for (int cy = 0; cy < m_height; ++cy) {
+    for (int cx = 0; cx < m_width; ++cx) {
+      int roadCount = 0, wallCount = 0, total = 0;
+      for (int py = cy * cs; py < std::min((cy + 1) * cs, static_cast<int>(size.y)); ++py) {
+        for (int px = cx * cs; px < std::min((cx + 1) * cs, static_cast<int>(size.x)); ++px) {
+          const sf::Color c = image.getPixel({ static_cast<unsigned>(px), static_cast<unsigned>(py) });
+          const int hi = std::max({ c.r, c.g, c.b });
+          const int lo = std::min({ c.r, c.g, c.b });
+          if (isMask) {
+            roadCount += (lo > 160) ? 1 : 0;
+            wallCount += (hi < 60) ? 1 : 0;
+          }
+          else {
+            // Asfalto: gris (poca saturación) ni muy oscuro ni muy claro.
+            const int luma = (c.r * 3 + c.g * 6 + c.b) / 10;
+            roadCount += (hi - lo < 40 && luma > 40 && luma < 210) ? 1 : 0;
+          }
+          ++total;
+        }
+      }
+      const std::size_t i = static_cast<std::size_t>(cy) * m_width + cx;
+      road[i] = (2 * roadCount > total) ? 1 : 0;
+      wall[i] = (2 * wallCount > total) ? 1 : 0;
+    }
+  }
+
+  computeDistanceField(road);
+  for (std::size_t i = 0; i < wall.size(); ++i) {
+    if (wall[i]) {
+      m_surface[i] = static_cast<std::uint8_t>(Surface::Wall);
+    }
+  }
+}
+
+void TrackSurface::buildFromSpline(const RacingSpline& spline, float roadHalfWidth, const sf::FloatRect& bounds,
+                                   float cellSize) {
+  m_cellSize = std::max(1.f, cellSize);
+  m_invCellSize = 1.f / m_cellSize;
+  m_origin = bounds.position;
+  m_width = std::max(1, static_cast<int>(std::ceil(bounds.size.x * m_invCellSize)));
+  m_height = std::max(1, static_cast<int>(std::ceil(bounds.size.y * m_invCellSize)));
+
+  // Se estampa un disco por muestra de la LUT (paso << anchura, así no quedan huecos).
+  std::vector<std::uint8_t> road(static_cast<std::size_t>(m_width) * m_height, 0);
+  const int reach = static_cast<int>(std::ceil(roadHalfWidth * m_invCellSize));
+  const float r2 = roadHalfWidth * roadHalfWidth;
+  for (const auto& s : spline.getSamples()) {
+    const int cx = static_cast<int>(std::floor((s.position.x - m_origin.x) * m_invCellSize));
+    const int cy = static_cast<int>(std::floor((s.position.y - m_origin.y) * m_invCellSize));
+    for (int y = std::max(0, cy - reach); y <= std::min(m_height - 1, cy + reach); ++y) {
+      for (int x = std::max(0, cx - reach); x <= std::min(m_width - 1, cx + reach); ++x) {
+        const float dx = m_origin.x + (x + 0.5f) * m_cellSize - s.position.x;
+        const float dy = m_origin.y + (y + 0.5f) * m_cellSize - s.position.y;
+        if (dx * dx + dy * dy <= r2) {
+          road[static_cast<std::size_t>(y) * m_width + x] = 1;
+        }
+      }
+    }
+  }
+  computeDistanceField(road);
+}
+
+void TrackSurface::computeDistanceField(const std::vector<std::uint8_t>& road) {
+  const float inf = static_cast<float>(m_width + m_height);
+  std::vector<float> outside(road.size());
+  std::vector<float> inside(road.size());
+  for (std::size_t i = 0; i < road.size(); ++i) {
+    outside[i] = road[i] ? 0.f : inf;
+    inside[i] = road[i] ? inf : 0.f;
+  }
+  chamfer(outside, m_width, m_height);
+  chamfer(inside, m_width, m_height);
+
+  m_surface.assign(road.size(), static_cast<std::uint8_t>(Surface::Road));
+  m_distance.assign(road.size(), 0);
+  const float limit = static_cast<float>(std::numeric_limits<std::int16_t>::max()) / kDistanceScale;
+  for (std::size_t i = 0; i < road.size(); ++i) {
+    // Medio celda de corrección: el borde está entre el centro de la celda y su vecina.
+    const float cells = road[i] ? -(inside[i] - 0.5f) : (outside[i] - 0.5f);
+    const float px = std::clamp(cells * m_cellSize, -limit, limit);
+    m_distance[i] = static_cast<std::int16_t>(std::lround(px * kDistanceScale));
+    if (!road[i]) {
+      m_surface[i] = static_cast<std::uint8_t>(px >= m_wallDistance ? Surface::Wall : Surface::Offroad);
+    }
+  }
+}
+
+bool TrackSurface::saveCache(const std::string& path, std::uint64_t sourceKey) const {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  const std::uint32_t header[] = { kCacheMagic, kCacheVersion,
+    static_cast<std::uint32_t>(m_width), static_cast<std::uint32_t>(m_height) };
+  const float params[] = { m_cellSize, m_origin.x, m_origin.y, m_wallDistance };
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(&sourceKey), sizeof(sourceKey));
+  out.write(reinterpret_cast<const char*>(params), sizeof(params));
+  out.write(reinterpret_cast<const char*>(m_surface.data()), static_cast<std::streamsize>(m_surface.size()));
+  out.write(reinterpret_cast<const char*>(m_distance.data()),
+    static_cast<std::streamsize>(m_distance.size() * sizeof(std::int16_t)));
+  return static_cast<bool>(out);
+}
+
+bool TrackSurface::loadCache(const std::string& path, std::uint64_t sourceKey) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::uint32_t header[4] = {};
+  std::uint64_t key = 0;
+  float params[4] = {};
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  in.read(reinterpret_cast<char*>(&key), sizeof(key));
+  in.read(reinterpret_cast<char*>(params), sizeof(params));
+  if (!in || header[0] != kCacheMagic || header[1] != kCacheVersion || key != sourceKey) {
+    return false;
+  }
+  // Cada celda ocupa 3 bytes (superficie + distancia) y las consultas dividen por cellSize.
+  const std::uint64_t cells64 = static_cast<std::uint64_t>(header[2]) * header[3];
+  if (header[2] > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+      header[3] > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+      cells64 * (1 + sizeof(std::int16_t)) > BinaryIO::remainingBytes(in) ||
+      !std::isfinite(params[0]) || params[0] <= 0.f) {
+    std::cerr << "TrackSurface::loadCache : caché no válida en " << path << "\n";
+    return false;
+  }
+  const std::size_t cells = static_cast<std::size_t>(cells64);
+  std::vector<std::uint8_t> surface(cells);
+  std::vector<std::int16_t> distance(cells);
+  in.read(reinterpret_cast<char*>(surface.data()), static_cast<std::streamsize>(cells));
+  in.read(reinterpret_cast<char*>(distance.data()), static_cast<std::streamsize>(cells * sizeof(std::int16_t)));
+  if (!in) {
+    return false;
+  }
+  m_width = static_cast<int>(header[2]);
+  m_height = static_cast<int>(header[3]);
+  m_cellSize = params[0];
+  m_invCellSize = 1.f / m_cellSize;
+  m_origin = { params[1], params[2] };
+  m_wallDistance = params[3];
+  m_surface = std::move(surface);
+  m_distance = std::move(distance);
+  return true;
+}
+
+TrackSurface::Surface TrackSurface::getSurface(const sf::Vector2f& pos) const {
+  const int x = static_cast<int>(std::floor((pos.x - m_origin.x) * m_invCellSize));
+  const int y = static_cast<int>(std::floor((pos.y - m_origin.y) * m_invCellSize));
+  if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+    return Surface::Wall;
+  }
+  return static_cast<Surface>(m_surface[static_cast<std::size_t>(y) * m_width + x]);
+}
+
+float TrackSurface::cellDistance(int x, int y) const {
+  x = std::clamp(x, 0, m_width - 1);
+  y = std::clamp(y, 0, m_height - 1);
+  return m_distance[static_cast<std::size_t>(y) * m_width + x] / kDistanceScale;
+}
+
+float TrackSurface::getDistance(const sf::Vector2f& pos) const {
+  if (empty()) {
+    return 0.f;
+  }
+  // Bilineal entre centros de celda: 4 lecturas.
+  const float fx = (pos.x - m_origin.x) * m_invCellSize - 0.5f;
+  const float fy = (pos.y - m_origin.y) * m_invCellSize - 0.5f;
+  const int x0 = static_cast<int>(std::floor(fx));
+  const int y0 = static_cast<int>(std::floor(fy));
+  const float tx = fx - x0;
+  const float ty = fy - y0;
+  const float top = cellDistance(x0, y0) + (cellDistance(x0 + 1, y0) - cellDistance(x0, y0)) * tx;
+  const float bottom = cellDistance(x0, y0 + 1) + (cellDistance(x0 + 1, y0 + 1) - cellDistance(x0, y0 + 1)) * tx;
+  float d = top + (bottom - top) * ty;
+
+  // Fuera de la rejilla la distancia sigue creciendo.
+  const sf::Vector2f extent{ m_width * m_cellSize, m_height * m_cellSize };
+  const float ox = std::max({ m_origin.x - pos.x, pos.x - (m_origin.x + extent.x), 0.f });
+  const float oy = std::max({ m_origin.y - pos.y, pos.y - (m_origin.y + extent.y), 0.f });
+  if (ox > 0.f || oy > 0.f) {
+    d += std::sqrt(ox * ox + oy * oy);
+  }
+  return d;
+}
+
+sf::Vector2f TrackSurface::getGradient(const sf::Vector2f& pos) const {
+  const float h = m_cellSize;
+  const sf::Vector2f g{
+    getDistance({ pos.x + h, pos.y }) - getDistance({ pos.x - h, pos.y }),
+    getDistance({ pos.x, pos.y + h }) - getDistance({ pos.x, pos.y - h }) };
+  const float len = std::sqrt(g.x * g.x + g.y * g.y);
+  return (len > 1e-6f) ? g / len : sf::Vector2f{ 0.f, 0.f };
+}
+
+float TrackSurface::roadCoverage(const RacingSpline& spline) const {
+  const auto& samples = spline.getSamples();
+  if (samples.empty() || empty()) {
+    return 0.f;
+  }
+  std::size_t onRoad = 0;
+  for (const auto& s : samples) {
+    onRoad += (getSurface(s.position) == Surface::Road) ? 1 : 0;
+  }
+  return static_cast<float>(onRoad) / static_cast<float>(samples.size());
+}
@@ -1,102 +1,86 @@
-#include <SFML/Graphics.hpp>
-#include <memory>
-#include <vector>
-#include <string>
-#include <iostream>
+#include "Window.h"
 
-// ------------------------------------------------
-// Clase Actor: representa corredor o pista
-// ------------------------------------------------
-class Actor {
-    sf::Sprite sprite;
-    sf::Texture texture;
-
-public:
-    std::string name;
-
-    Actor(const std::string& filename, const std::string& actorName) : name(actorName) {
-        if (!texture.loadFromFile(filename)) {
-            std::cerr << "Error cargando textura: " << filename << "\n";
-        }
-        sprite.setTexture(texture);
-        // Centrar origen para rotaciones escalado
-        sf::FloatRect bounds = sprite.getLocalBounds();
-        sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
-    }
-
-    void setPosition(float x, float y) { sprite.setPosition(x, y); }
-    void setScale(float sx, float sy) { sprite.setScale(sx, sy); }
-    void setRotation(float angle) { sprite.setRotation(angle); }
-
-    void render(sf::RenderWindow& window) { window.draw(sprite); }
-};
+Window::Window(int width, int height, const std::string& title) {
+  m_windowPtr = EngineUtilities::MakeUnique<sf::RenderWindow>(
+    sf::VideoMode({ static_cast<unsigned>(width), static_cast<unsigned>(height) }), title);
+  m_view = m_windowPtr->getDefaultView();
+  clock.restart();
+}
 
-// ------------------------------------------------
-// Clase Window: encapsula sf::RenderWindow
-// ------------------------------------------------
-class ChrisEngineWindow {
-    std::unique_ptr<sf::RenderWindow> window;
+Window::~Window() {
+  destroy();
+}
 
-public:
-    ChrisEngineWindow(int width, int height, const std::string& title) {
-        window = std::make_unique<sf::RenderWindow>(sf::VideoMode(width, height), title);
-        window->setFramerateLimit(60);
+void Window::handleEvents(const std::function<void(const sf::Event&)>& callback) {
+  if (!m_windowPtr) {
+    return;
+  }
+  while (const std::optional event = m_windowPtr->pollEvent()) {
+    if (event->is<sf::Event::Closed>()) {
+      m_windowPtr->close();
     }
-
-    bool isOpen() const { return window->isOpen(); }
-    void clear() { window->clear(sf::Color::Black); }
-    void display() { window->display(); }
-    void draw(sf::Drawable& drawable) { window->draw(drawable); }
-
-    void handleEvents() {
-        sf::Event event;
-        while (window->pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window->close();
-        }
+    if (callback) {
+      callback(*event);
     }
+  }
+}
 
-    sf::RenderWindow& getInternal() { return *window; }
-};
-
-// ------------------------------------------------
-// Funcin principal
-// ------------------------------------------------
-int main() {
-    ChrisEngineWindow window(1024, 768, "ChrisEngine Carrera");
+bool Window::isOpen() const {
+  return m_windowPtr && m_windowPtr->isOpen();
+}
 
-    // Crear actores
-    Actor pista("pista de carreras.png", "Pista");
-    pista.setPosition(512, 384); // centro
+void Window::clear(const sf::Color& color) {
+  if (m_windowPtr) {
+    m_windowPtr->clear(color);
+  }
+}
 
-    Actor princesa("princesa.png", "Princesa");
-    princesa.setPosition(200, 600);
+void Window::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
+  if (m_windowPtr) {
+    m_windowPtr->draw(drawable, states);
+  }
+}
 
-    Actor sonic("sonic.png", "Sonic");
-    sonic.setPosition(400, 600);
+void Window::setView(const sf::View& view) {
+  m_view = view;
+  if (m_windowPtr) {
+    m_windowPtr->setView(m_view);
+  }
+}
 
-    Actor virdo("virdo.png", "Virdo");
-    virdo.setPosition(600, 600);
+void Window::resetView() {
+  if (m_windowPtr) {
+    setView(m_windowPtr->getDefaultView());
+  }
+}
 
-    Actor wario("wario.png", "Wario");
-    wario.setPosition(800, 600);
+sf::Vector2u Window::getSize() const {
+  return m_windowPtr ? m_windowPtr->getSize() : sf::Vector2u{ 0u, 0u };
+}
 
-    std::vector<Actor*> racers = { &princesa, &sonic, &virdo, &wario };
+void Window::display() {
+  if (m_windowPtr) {
+    m_windowPtr->display();
+  }
+}
 
-    // Loop principal
-    while (window.isOpen()) {
-        window.handleEvents();
-        window.clear();
+void Window::update() {
+  deltaTime = clock.restart();
+}
 
-        // Dibujar pista primero
-        pista.render(window.getInternal());
+void Window::render() {
+}
 
-        // Dibujar corredores
-        for (auto* r : racers)
-            r->render(window.getInternal());
+void Window::close() {
+  if (m_windowPtr) {
+    m_windowPtr->close();
+  }
+}
 
-        window.display();
-    }
+void Window::destroy() {
+  m_windowPtr.reset();
+}
 
-    return 0;
+sf::RenderWindow& Window::getInternal() {
+  return *m_windowPtr;
 }
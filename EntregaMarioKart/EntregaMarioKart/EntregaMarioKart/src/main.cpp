@@ -1,11 +1,63 @@
-﻿#include <SFML/Graphics.hpp>
-int main() {
-    sf::RenderWindow window(sf::VideoMode(800, 600), "Test SFML");
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event))
-            if (event.type == sf::Event::Closed) window.close();
-        window.clear();
-        window.display();
+#include "BaseApp.h"
+#include "HeadlessApp.h"
+#include "Mode7Benchmark.h"
+#include "NetRaceRunner.h"
+#include "RaceBatchRunner.h"
+#include "RacingLineOptimizer.h"
+#include "SpriteSheetBaker.h"
+#include "TrackChunker.h"
+
+#include <cstring>
+
+int main(int argc, char* argv[]) {
+  RaceBatchRunner::Config batchConfig;
+  if (RaceBatchRunner::parseArgs(argc, argv, batchConfig)) {
+    RaceBatchRunner batch;
+    return batch.run(batchConfig);
+  }
+
+  RacingLineOptimizer::Config lineConfig;
+  if (RacingLineOptimizer::parseArgs(argc, argv, lineConfig)) {
+    RacingLineOptimizer optimizer;
+    return optimizer.run(lineConfig);
+  }
+
+  SpriteSheetBaker::Config bakeConfig;
+  if (SpriteSheetBaker::parseArgs(argc, argv, bakeConfig)) {
+    SpriteSheetBaker baker;
+    return baker.run(bakeConfig);
+  }
+
+  TrackChunker::Config chunkConfig;
+  if (TrackChunker::parseArgs(argc, argv, chunkConfig)) {
+    TrackChunker chunker;
+    return chunker.run(chunkConfig);
+  }
+
+  Mode7Benchmark::Config mode7Config;
+  if (Mode7Benchmark::parseArgs(argc, argv, mode7Config)) {
+    Mode7Benchmark bench;
+    return bench.run(mode7Config);
+  }
+
+  NetRaceRunner::Config netConfig;
+  if (NetRaceRunner::parseArgs(argc, argv, netConfig)) {
+    NetRaceRunner net;
+    return net.run(netConfig);
+  }
+
+  HeadlessApp::Options headlessOptions;
+  if (HeadlessApp::parseArgs(argc, argv, headlessOptions)) {
+    HeadlessApp headless;
+    return headless.run(headlessOptions);
+  }
+
+  BaseApp app;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::strcmp(argv[i], "--watch") == 0 && !app.watchReplay(argv[i + 1])) {
+      std::cerr << "main : no se pudo leer la grabación " << argv[i + 1] << "\n";
+      return 1;
     }
+  }
+  return app.run();
 }